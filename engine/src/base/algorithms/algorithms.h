@@ -0,0 +1,10 @@
+#pragma once
+
+#include "base/algorithms/radix_sort.h"
+#include "base/algorithms/incremental_sort.h"
+#include "base/algorithms/instance_packing.h"
+#include "base/algorithms/frustum_culling.h"
+#include "base/algorithms/bvh.h"
+#include "base/algorithms/occlusion_buffer.h"
+#include "base/algorithms/meshlet_culling.h"
+#include "base/algorithms/transform_hierarchy.h"
@@ -0,0 +1,499 @@
+#include "base/base.h"
+
+namespace Be
+{
+
+    namespace
+    {
+        // Subtrees smaller than this are not worth a task of their own.
+        constexpr usize_t BVH_MIN_TASK_SIZE = 4096;
+        constexpr usize_t BVH_BIN_COUNT = 16;
+
+        constexpr float BVH_INFINITY = std::numeric_limits<float>::infinity();
+
+        template <typename Box>
+        [[nodiscard]] constexpr Box EmptyBox() noexcept
+        {
+            return {{BVH_INFINITY, BVH_INFINITY, BVH_INFINITY}, {-BVH_INFINITY, -BVH_INFINITY, -BVH_INFINITY}};
+        }
+
+        template <typename Box>
+        forceinline void Grow(Box &box, const Box &other) noexcept
+        {
+            for (usize_t axis = 0; axis < 3; axis++)
+            {
+                box.min[axis] = std::min(box.min[axis], other.min[axis]);
+                box.max[axis] = std::max(box.max[axis], other.max[axis]);
+            }
+        }
+
+        // Half of the surface area, only the ratios matter.
+        template <typename Box>
+        [[nodiscard]] forceinline float HalfArea(const Box &box) noexcept
+        {
+            const auto x = box.max[0] - box.min[0];
+            const auto y = box.max[1] - box.min[1];
+            const auto z = box.max[2] - box.min[2];
+            return x * y + y * z + z * x;
+        }
+
+        template <typename Box>
+        forceinline void SetSlot(Bvh::Node &node, usize_t slot, const Box &box) noexcept
+        {
+            node.min_x[slot] = box.min[0];
+            node.min_y[slot] = box.min[1];
+            node.min_z[slot] = box.min[2];
+            node.max_x[slot] = box.max[0];
+            node.max_y[slot] = box.max[1];
+            node.max_z[slot] = box.max[2];
+        }
+
+        template <typename Box>
+        [[nodiscard]] forceinline Box GetSlot(const Bvh::Node &node, usize_t slot) noexcept
+        {
+            return {{node.min_x[slot], node.min_y[slot], node.min_z[slot]}, {node.max_x[slot], node.max_y[slot], node.max_z[slot]}};
+        }
+
+        // Slots entirely outside of some plane and slots entirely inside of all planes.
+        forceinline void FrustumMasks(const Bvh::Node &node, const Frustum &frustum, uint32_t &outside, uint32_t &inside) noexcept
+        {
+#if defined(BE_SIMD_SSE2)
+            auto out = _mm_setzero_ps();
+            auto in = _mm_castsi128_ps(_mm_set1_epi32(-1));
+            for (usize_t p = 0; p < Frustum::PlaneCount; p++)
+            {
+                // The corners farthest along the normal and farthest against it.
+                const auto x = frustum.x[p] >= 0.0f;
+                const auto y = frustum.y[p] >= 0.0f;
+                const auto z = frustum.z[p] >= 0.0f;
+                const auto px = _mm_set1_ps(frustum.x[p]);
+                const auto py = _mm_set1_ps(frustum.y[p]);
+                const auto pz = _mm_set1_ps(frustum.z[p]);
+                const auto pw = _mm_set1_ps(frustum.w[p]);
+
+                const auto far = _mm_add_ps(_mm_add_ps(_mm_mul_ps(px, _mm_load_ps(x ? node.max_x.data() : node.min_x.data())),
+                                                       _mm_mul_ps(py, _mm_load_ps(y ? node.max_y.data() : node.min_y.data()))),
+                                            _mm_add_ps(_mm_mul_ps(pz, _mm_load_ps(z ? node.max_z.data() : node.min_z.data())), pw));
+                const auto near = _mm_add_ps(_mm_add_ps(_mm_mul_ps(px, _mm_load_ps(x ? node.min_x.data() : node.max_x.data())),
+                                                        _mm_mul_ps(py, _mm_load_ps(y ? node.min_y.data() : node.max_y.data()))),
+                                             _mm_add_ps(_mm_mul_ps(pz, _mm_load_ps(z ? node.min_z.data() : node.max_z.data())), pw));
+
+                out = _mm_or_ps(out, _mm_cmplt_ps(far, _mm_setzero_ps()));
+                in = _mm_and_ps(in, _mm_cmpge_ps(near, _mm_setzero_ps()));
+            }
+            outside = uint32_t(_mm_movemask_ps(out));
+            inside = uint32_t(_mm_movemask_ps(in));
+#else
+            outside = 0;
+            inside = (1u << Bvh::Width) - 1;
+            for (usize_t slot = 0; slot < Bvh::Width; slot++)
+            {
+                for (usize_t p = 0; p < Frustum::PlaneCount; p++)
+                {
+                    const auto x = frustum.x[p] >= 0.0f;
+                    const auto y = frustum.y[p] >= 0.0f;
+                    const auto z = frustum.z[p] >= 0.0f;
+                    const auto far = (frustum.x[p] * (x ? node.max_x[slot] : node.min_x[slot]) + frustum.y[p] * (y ? node.max_y[slot] : node.min_y[slot])) +
+                                     (frustum.z[p] * (z ? node.max_z[slot] : node.min_z[slot]) + frustum.w[p]);
+                    const auto near = (frustum.x[p] * (x ? node.min_x[slot] : node.max_x[slot]) + frustum.y[p] * (y ? node.min_y[slot] : node.max_y[slot])) +
+                                      (frustum.z[p] * (z ? node.min_z[slot] : node.max_z[slot]) + frustum.w[p]);
+                    outside |= uint32_t(far < 0.0f) << slot;
+                    inside &= ~(uint32_t(near < 0.0f) << slot);
+                }
+            }
+#endif
+        }
+
+        template <typename Box>
+        [[nodiscard]] forceinline bool IsVisible(const Frustum &frustum, const Box &box) noexcept
+        {
+            bool visible{true};
+            for (usize_t p = 0; p < Frustum::PlaneCount; p++)
+            {
+                const auto x = frustum.x[p] >= 0.0f ? box.max[0] : box.min[0];
+                const auto y = frustum.y[p] >= 0.0f ? box.max[1] : box.min[1];
+                const auto z = frustum.z[p] >= 0.0f ? box.max[2] : box.min[2];
+                visible &= (frustum.x[p] * x + frustum.y[p] * y) + (frustum.z[p] * z + frustum.w[p]) >= 0.0f;
+            }
+            return visible;
+        }
+    }
+
+    void Bvh::Build(Span<const BBox> bounds)
+    {
+        PROFILER_SCOPE;
+
+        BeginBuild(bounds, 1);
+        EndBuild();
+    }
+
+    void Bvh::Refit(Span<const BBox> bounds)
+    {
+        PROFILER_SCOPE;
+
+        VERIFY(bounds.size() == size(), "BVH refit with {} boxes, built with {}", bounds.size(), size());
+
+        for (usize_t i = 0; i < m_indices.size(); i++)
+        {
+            m_leaf_boxes[i] = ToBox(bounds[m_indices[i]]);
+        }
+
+        // Children always follow their parents, so a reverse pass sees every child first.
+        for (auto node = m_nodes.rbegin(); node != m_nodes.rend(); ++node)
+        {
+            for (usize_t slot = 0; slot < Width; slot++)
+            {
+                if (!node->count[slot])
+                {
+                    continue;
+                }
+
+                auto box = EmptyBox<Box>();
+                if (node->child[slot] & LeafBit)
+                {
+                    const auto first = node->child[slot] & ~LeafBit;
+                    for (auto i = first; i < first + node->count[slot]; i++)
+                    {
+                        Grow(box, m_leaf_boxes[i]);
+                    }
+                }
+                else
+                {
+                    const auto &child = m_nodes[node->child[slot]];
+                    for (usize_t child_slot = 0; child_slot < Width; child_slot++)
+                    {
+                        if (child.count[child_slot])
+                        {
+                            Grow(box, GetSlot<Box>(child, child_slot));
+                        }
+                    }
+                }
+                SetSlot(*node, slot, box);
+            }
+        }
+    }
+
+    usize_t Bvh::Cull(const Frustum &frustum, uint32_t *visible) const noexcept
+    {
+        PROFILER_SCOPE;
+
+        if (m_nodes.empty())
+        {
+            return 0;
+        }
+
+        auto *out = visible;
+
+        FixedArray<uint32_t, StackSize> stack;
+        usize_t top{0};
+        stack[top++] = 0;
+        while (top)
+        {
+            const auto &node = m_nodes[stack[--top]];
+
+            uint32_t outside, inside;
+            FrustumMasks(node, frustum, outside, inside);
+
+            for (usize_t slot = 0; slot < Width; slot++)
+            {
+                const auto count = node.count[slot];
+                if (!count || (outside & (1u << slot)))
+                {
+                    continue;
+                }
+
+                const auto is_leaf = (node.child[slot] & LeafBit) != 0;
+                if (inside & (1u << slot))
+                {
+                    // The whole subtree is visible, its boxes are listed as they are.
+                    const auto first = is_leaf ? node.child[slot] & ~LeafBit : m_node_first[node.child[slot]];
+                    out = std::copy_n(m_indices.begin() + first, count, out);
+                }
+                else if (is_leaf)
+                {
+                    const auto first = node.child[slot] & ~LeafBit;
+                    for (auto i = first; i < first + count; i++)
+                    {
+                        *out = m_indices[i];
+                        out += IsVisible(frustum, m_leaf_boxes[i]);
+                    }
+                }
+                else
+                {
+                    stack[top++] = node.child[slot];
+                }
+            }
+        }
+
+        return usize_t(out - visible);
+    }
+
+    void Bvh::BeginBuild(Span<const BBox> bounds, usize_t task_count)
+    {
+        PROFILER_SCOPE;
+
+        const auto count = bounds.size();
+        VERIFY(count < LeafBit, "Too many boxes for a BVH: {}", count);
+
+        m_nodes.clear();
+        m_node_first.clear();
+        m_build_tasks.clear();
+
+        m_build_primitives.resize(count);
+        for (usize_t i = 0; i < count; i++)
+        {
+            m_build_primitives[i] = {ToBox(bounds[i]), uint32_t(i)};
+        }
+
+        if (count == 0)
+        {
+            return;
+        }
+
+        // A few subtrees per task balance the uneven splits.
+        BuildOutput out{m_nodes, m_node_first, task_count > 1 ? std::max(count / (task_count * 4), BVH_MIN_TASK_SIZE) : 0};
+        BuildNode(out, 0, uint32_t(count), 0);
+    }
+
+    void Bvh::BuildTask(usize_t task)
+    {
+        PROFILER_SCOPE;
+
+        auto &build = m_build_tasks[task];
+        BuildOutput out{build.nodes, build.node_first, 0};
+        BuildNode(out, build.begin, build.end, build.depth);
+    }
+
+    void Bvh::EndBuild()
+    {
+        PROFILER_SCOPE;
+
+        for (auto &task : m_build_tasks)
+        {
+            const auto base = uint32_t(m_nodes.size());
+            for (auto &node : task.nodes)
+            {
+                for (usize_t slot = 0; slot < Width; slot++)
+                {
+                    if (node.count[slot] && !(node.child[slot] & LeafBit))
+                    {
+                        node.child[slot] += base;
+                    }
+                }
+            }
+            m_nodes.insert(m_nodes.end(), task.nodes.begin(), task.nodes.end());
+            m_node_first.insert(m_node_first.end(), task.node_first.begin(), task.node_first.end());
+            m_nodes[task.parent].child[task.slot] = base;
+        }
+        m_build_tasks.clear();
+
+        m_indices.resize(m_build_primitives.size());
+        m_leaf_boxes.resize(m_build_primitives.size());
+        for (usize_t i = 0; i < m_build_primitives.size(); i++)
+        {
+            m_indices[i] = m_build_primitives[i].index;
+            m_leaf_boxes[i] = m_build_primitives[i].box;
+        }
+        m_build_primitives = {};
+    }
+
+    uint32_t Bvh::BuildNode(BuildOutput &out, uint32_t begin, uint32_t end, uint32_t depth)
+    {
+        // The largest part is split until there are four or all of them fit in a leaf.
+        FixedArray<Pair<uint32_t, uint32_t>, Width> parts;
+        usize_t part_count{1};
+        parts[0] = {begin, end};
+        while (part_count < Width)
+        {
+            usize_t largest{0};
+            for (usize_t part = 1; part < part_count; part++)
+            {
+                if (parts[part].second - parts[part].first > parts[largest].second - parts[largest].first)
+                {
+                    largest = part;
+                }
+            }
+
+            const auto [part_begin, part_end] = parts[largest];
+            if (part_end - part_begin <= MaxLeafSize)
+            {
+                break;
+            }
+            const auto mid = Split(part_begin, part_end, depth);
+            parts[largest] = {part_begin, mid};
+            parts[part_count++] = {mid, part_end};
+        }
+
+        const auto index = uint32_t(out.nodes.size());
+        out.nodes.emplace_back();
+        out.node_first.push_back(begin);
+
+        for (usize_t slot = 0; slot < part_count; slot++)
+        {
+            const auto [part_begin, part_end] = parts[slot];
+            const auto count = part_end - part_begin;
+
+            uint32_t child;
+            if (count <= MaxLeafSize)
+            {
+                child = part_begin | LeafBit;
+            }
+            else if (count <= out.defer_size)
+            {
+                m_build_tasks.push_back({part_begin, part_end, index, uint32_t(slot), depth + 1});
+                child = 0;
+            }
+            else
+            {
+                child = BuildNode(out, part_begin, part_end, depth + 1);
+            }
+
+            auto &node = out.nodes[index];
+            SetSlot(node, slot, GetBounds(part_begin, part_end));
+            node.child[slot] = child;
+            node.count[slot] = count;
+        }
+
+        return index;
+    }
+
+    uint32_t Bvh::Split(uint32_t begin, uint32_t end, uint32_t depth)
+    {
+        // Centroids are kept doubled, min + max, the scale does not matter.
+        Box centroids = EmptyBox<Box>();
+        for (auto i = begin; i < end; i++)
+        {
+            const auto &box = m_build_primitives[i].box;
+            for (usize_t axis = 0; axis < 3; axis++)
+            {
+                const auto centroid = box.min[axis] + box.max[axis];
+                centroids.min[axis] = std::min(centroids.min[axis], centroid);
+                centroids.max[axis] = std::max(centroids.max[axis], centroid);
+            }
+        }
+
+        usize_t axis{0};
+        for (usize_t i = 1; i < 3; i++)
+        {
+            if (centroids.max[i] - centroids.min[i] > centroids.max[axis] - centroids.min[axis])
+            {
+                axis = i;
+            }
+        }
+
+        const auto extent = centroids.max[axis] - centroids.min[axis];
+        const auto mid = begin + (end - begin) / 2;
+        const auto first = m_build_primitives.begin() + begin;
+        const auto last = m_build_primitives.begin() + end;
+        const auto centroid = [&](const BuildPrimitive &primitive)
+        { return primitive.box.min[axis] + primitive.box.max[axis]; };
+
+        // All centroids at one point, any split is as good as the other.
+        if (!(extent > 0.0f))
+        {
+            return mid;
+        }
+
+        if (depth >= MaxSahDepth)
+        {
+            std::nth_element(first, m_build_primitives.begin() + mid, last, [&](const auto &a, const auto &b)
+                             { return centroid(a) < centroid(b); });
+            return mid;
+        }
+
+        struct Bin
+        {
+            Box box{EmptyBox<Box>()};
+            uint32_t count{0};
+        };
+
+        FixedArray<Bin, BVH_BIN_COUNT> bins{};
+        const auto scale = float(BVH_BIN_COUNT) / extent;
+        const auto bin_of = [&](const BuildPrimitive &primitive)
+        { return std::min(usize_t((centroid(primitive) - centroids.min[axis]) * scale), BVH_BIN_COUNT - 1); };
+
+        for (auto i = begin; i < end; i++)
+        {
+            const auto &primitive = m_build_primitives[i];
+            auto &bin = bins[bin_of(primitive)];
+            Grow(bin.box, primitive.box);
+            bin.count++;
+        }
+
+        // Cost of the right side for a split after every bin.
+        FixedArray<float, BVH_BIN_COUNT> right_costs{};
+        auto right = EmptyBox<Box>();
+        uint32_t right_count{0};
+        for (usize_t i = BVH_BIN_COUNT - 1; i > 0; i--)
+        {
+            Grow(right, bins[i].box);
+            right_count += bins[i].count;
+            right_costs[i - 1] = right_count ? HalfArea(right) * float(right_count) : BVH_INFINITY;
+        }
+
+        auto left = EmptyBox<Box>();
+        uint32_t left_count{0};
+        float best_cost{BVH_INFINITY};
+        usize_t best_bin{0};
+        for (usize_t i = 0; i < BVH_BIN_COUNT - 1; i++)
+        {
+            Grow(left, bins[i].box);
+            left_count += bins[i].count;
+            if (!left_count)
+            {
+                continue;
+            }
+            const auto cost = HalfArea(left) * float(left_count) + right_costs[i];
+            if (cost < best_cost)
+            {
+                best_cost = cost;
+                best_bin = i;
+            }
+        }
+
+        // The first and the last bins are never empty, both sides get something.
+        const auto split = std::partition(first, last, [&](const auto &primitive)
+                                          { return bin_of(primitive) <= best_bin; });
+        ASSERT(split != first && split != last);
+        return uint32_t(split - m_build_primitives.begin());
+    }
+
+    Bvh::Box Bvh::GetBounds(uint32_t begin, uint32_t end) const noexcept
+    {
+        auto box = EmptyBox<Box>();
+        for (auto i = begin; i < end; i++)
+        {
+            Grow(box, m_build_primitives[i].box);
+        }
+        return box;
+    }
+
+    Bvh::Box Bvh::ToBox(const BBox &box) noexcept
+    {
+        // One step towards the bound when rounding went the other way, from an infinity
+        // too. Zero steps to the smallest denormal.
+        const auto down = [](double value)
+        {
+            const auto f = float(value);
+            if (double(f) <= value)
+            {
+                return f;
+            }
+            const auto bits = std::bit_cast<uint32_t>(f);
+            return f == 0.0f ? -std::numeric_limits<float>::denorm_min() : std::bit_cast<float>(f > 0.0f ? bits - 1 : bits + 1);
+        };
+        const auto up = [](double value)
+        {
+            const auto f = float(value);
+            if (double(f) >= value)
+            {
+                return f;
+            }
+            const auto bits = std::bit_cast<uint32_t>(f);
+            return f == 0.0f ? std::numeric_limits<float>::denorm_min() : std::bit_cast<float>(f > 0.0f ? bits + 1 : bits - 1);
+        };
+
+        return {{down(box.min.x), down(box.min.y), down(box.min.z)}, {up(box.max.x), up(box.max.y), up(box.max.z)}};
+    }
+
+}
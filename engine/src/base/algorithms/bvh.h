@@ -0,0 +1,343 @@
+#pragma once
+
+namespace Be
+{
+
+    // Bounding volume hierarchy over boxes for culling and scene queries. Every node has
+    // four children whose bounds are tested at once. The tree is built with the surface
+    // area heuristic. Refit moves the bounds without changing the structure, which keeps
+    // dynamic objects correct but slower to query the further they move from where they
+    // were built. Queries return indices into the bounds given to Build.
+    class Bvh final
+    {
+    public:
+        static constexpr usize_t Width = 4;
+        static constexpr usize_t MaxLeafSize = 4;
+
+        // Bounds of the four children, one row per coordinate. A leaf child covers count
+        // primitives starting at child & LeafBit, an inner child is the node at index child.
+        // Unused slots have a zero count.
+        struct alignas(64) Node
+        {
+            FixedArray<float, Width> min_x;
+            FixedArray<float, Width> min_y;
+            FixedArray<float, Width> min_z;
+            FixedArray<float, Width> max_x;
+            FixedArray<float, Width> max_y;
+            FixedArray<float, Width> max_z;
+            FixedArray<uint32_t, Width> child;
+            FixedArray<uint32_t, Width> count;
+        };
+        STATIC_ASSERT(sizeof(Node) == 128);
+
+        static constexpr uint32_t LeafBit = 0x8000'0000;
+
+    public:
+        void Build(Span<const BBox> bounds);
+
+        // The top of the tree is built on the calling thread, the subtrees below it by one
+        // task each. run(task_count, func) has to call func(task_index) for every task and
+        // return once all of them are done.
+        template <typename RunTasks>
+        void BuildParallel(Span<const BBox> bounds, usize_t task_count, RunTasks &&run)
+        {
+            PROFILER_SCOPE;
+
+            BeginBuild(bounds, task_count);
+            if (!m_build_tasks.empty())
+            {
+                run(m_build_tasks.size(), [this](usize_t task)
+                    { BuildTask(task); });
+            }
+            EndBuild();
+        }
+
+        // Same boxes in the same order as in the build, at their new places.
+        void Refit(Span<const BBox> bounds);
+
+    public:
+        // Writes the indices of the boxes that intersect the frustum, in no particular
+        // order, and returns their count. visible must have room for size() indices.
+        [[nodiscard]] usize_t Cull(const Frustum &frustum, uint32_t *visible) const noexcept;
+
+        // Calls func(index) for every box that overlaps the query box.
+        template <typename F>
+        void Overlap(const BBox &box, F &&func) const
+        {
+            PROFILER_SCOPE;
+
+            if (m_nodes.empty())
+            {
+                return;
+            }
+
+            const auto query = ToBox(box);
+
+            FixedArray<uint32_t, StackSize> stack;
+            usize_t top{0};
+            stack[top++] = 0;
+            while (top)
+            {
+                const auto &node = m_nodes[stack[--top]];
+                const auto mask = OverlapMask(node, query);
+                for (usize_t slot = 0; slot < Width; slot++)
+                {
+                    if (!(mask & (1u << slot)))
+                    {
+                        continue;
+                    }
+                    if (node.child[slot] & LeafBit)
+                    {
+                        const auto first = node.child[slot] & ~LeafBit;
+                        for (auto i = first; i < first + node.count[slot]; i++)
+                        {
+                            if (Overlaps(m_leaf_boxes[i], query))
+                            {
+                                func(m_indices[i]);
+                            }
+                        }
+                    }
+                    else
+                    {
+                        stack[top++] = node.child[slot];
+                    }
+                }
+            }
+        }
+
+        // Calls hit(index, max_distance) for every box the ray enters before max_distance,
+        // nearer nodes first. Distances are in units of direction. hit tests the object
+        // itself and may shorten max_distance, everything behind it is skipped.
+        template <typename F>
+        void Raycast(const Vector3 &origin, const Vector3 &direction, float max_distance, F &&hit) const
+        {
+            PROFILER_SCOPE;
+
+            if (m_nodes.empty())
+            {
+                return;
+            }
+
+            const Ray ray{
+                {float(origin.x), float(origin.y), float(origin.z)},
+                {1.0f / float(direction.x), 1.0f / float(direction.y), 1.0f / float(direction.z)},
+            };
+
+            FixedArray<Pair<uint32_t, float>, StackSize> stack;
+            usize_t top{0};
+            stack[top++] = {0, 0.0f};
+            while (top)
+            {
+                const auto [index, entry] = stack[--top];
+                if (entry > max_distance)
+                {
+                    continue;
+                }
+
+                const auto &node = m_nodes[index];
+                FixedArray<float, Width> distances;
+                const auto mask = RayMask(node, ray, max_distance, distances);
+
+                // Inner children are pushed farthest first, so the nearest is taken next.
+                FixedArray<uint32_t, Width> inner;
+                usize_t inner_count{0};
+                for (usize_t slot = 0; slot < Width; slot++)
+                {
+                    if (!(mask & (1u << slot)))
+                    {
+                        continue;
+                    }
+                    if (node.child[slot] & LeafBit)
+                    {
+                        const auto first = node.child[slot] & ~LeafBit;
+                        for (auto i = first; i < first + node.count[slot]; i++)
+                        {
+                            if (RayDistance(m_leaf_boxes[i], ray) <= max_distance)
+                            {
+                                hit(m_indices[i], max_distance);
+                            }
+                        }
+                    }
+                    else
+                    {
+                        auto j = inner_count++;
+                        for (; j > 0 && distances[inner[j - 1]] < distances[slot]; j--)
+                        {
+                            inner[j] = inner[j - 1];
+                        }
+                        inner[j] = uint32_t(slot);
+                    }
+                }
+                for (usize_t j = 0; j < inner_count; j++)
+                {
+                    stack[top++] = {node.child[inner[j]], distances[inner[j]]};
+                }
+            }
+        }
+
+    public:
+        [[nodiscard]] forceinline usize_t size() const noexcept
+        {
+            return m_indices.size();
+        }
+
+        [[nodiscard]] forceinline bool empty() const noexcept
+        {
+            return m_indices.empty();
+        }
+
+        [[nodiscard]] forceinline Span<const Node> GetNodes() const noexcept
+        {
+            return m_nodes;
+        }
+
+    private:
+        // Builds deeper than this split at the median, so the depth and the traversal
+        // stack stay bounded whatever the input.
+        static constexpr uint32_t MaxSahDepth = 32;
+        static constexpr usize_t StackSize = 256;
+
+        // Float bounds rounded outwards.
+        struct Box
+        {
+            FixedArray<float, 3> min;
+            FixedArray<float, 3> max;
+        };
+
+        struct Ray
+        {
+            FixedArray<float, 3> origin;
+            FixedArray<float, 3> inv_direction;
+        };
+
+        struct BuildPrimitive
+        {
+            Box box;
+            uint32_t index;
+        };
+
+        // Subtree left to a build task, linked to its parent slot once built.
+        struct DeferredSubtree
+        {
+            uint32_t begin;
+            uint32_t end;
+            uint32_t parent;
+            uint32_t slot;
+            uint32_t depth;
+            Array<Node> nodes;
+            Array<uint32_t> node_first;
+        };
+
+        struct BuildOutput
+        {
+            Array<Node> &nodes;
+            Array<uint32_t> &node_first;
+            usize_t defer_size;
+        };
+
+    private:
+        void BeginBuild(Span<const BBox> bounds, usize_t task_count);
+        void BuildTask(usize_t task);
+        void EndBuild();
+
+        uint32_t BuildNode(BuildOutput &out, uint32_t begin, uint32_t end, uint32_t depth);
+        [[nodiscard]] uint32_t Split(uint32_t begin, uint32_t end, uint32_t depth);
+        [[nodiscard]] Box GetBounds(uint32_t begin, uint32_t end) const noexcept;
+
+        [[nodiscard]] static Box ToBox(const BBox &box) noexcept;
+
+        [[nodiscard]] static forceinline bool Overlaps(const Box &a, const Box &b) noexcept
+        {
+            return a.min[0] <= b.max[0] && a.max[0] >= b.min[0] &&
+                   a.min[1] <= b.max[1] && a.max[1] >= b.min[1] &&
+                   a.min[2] <= b.max[2] && a.max[2] >= b.min[2];
+        }
+
+        // Entry distance of the ray, infinity when it misses.
+        [[nodiscard]] static forceinline float RayDistance(const Box &box, const Ray &ray) noexcept
+        {
+            float entry{0.0f};
+            float exit{std::numeric_limits<float>::infinity()};
+            for (usize_t axis = 0; axis < 3; axis++)
+            {
+                const auto t0 = (box.min[axis] - ray.origin[axis]) * ray.inv_direction[axis];
+                const auto t1 = (box.max[axis] - ray.origin[axis]) * ray.inv_direction[axis];
+                entry = std::max(entry, std::min(t0, t1));
+                exit = std::min(exit, std::max(t0, t1));
+            }
+            return entry <= exit ? entry : std::numeric_limits<float>::infinity();
+        }
+
+        // Used slots whose bounds overlap the box.
+        [[nodiscard]] static forceinline uint32_t OverlapMask(const Node &node, const Box &box) noexcept
+        {
+#if defined(BE_SIMD_SSE2)
+            auto mask = _mm_castsi128_ps(_mm_cmpgt_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(node.count.data())), _mm_setzero_si128()));
+            mask = _mm_and_ps(mask, _mm_cmple_ps(_mm_load_ps(node.min_x.data()), _mm_set1_ps(box.max[0])));
+            mask = _mm_and_ps(mask, _mm_cmple_ps(_mm_load_ps(node.min_y.data()), _mm_set1_ps(box.max[1])));
+            mask = _mm_and_ps(mask, _mm_cmple_ps(_mm_load_ps(node.min_z.data()), _mm_set1_ps(box.max[2])));
+            mask = _mm_and_ps(mask, _mm_cmpge_ps(_mm_load_ps(node.max_x.data()), _mm_set1_ps(box.min[0])));
+            mask = _mm_and_ps(mask, _mm_cmpge_ps(_mm_load_ps(node.max_y.data()), _mm_set1_ps(box.min[1])));
+            mask = _mm_and_ps(mask, _mm_cmpge_ps(_mm_load_ps(node.max_z.data()), _mm_set1_ps(box.min[2])));
+            return uint32_t(_mm_movemask_ps(mask));
+#else
+            uint32_t mask{0};
+            for (usize_t slot = 0; slot < Width; slot++)
+            {
+                const bool overlaps = node.count[slot] &&
+                                      node.min_x[slot] <= box.max[0] && node.max_x[slot] >= box.min[0] &&
+                                      node.min_y[slot] <= box.max[1] && node.max_y[slot] >= box.min[1] &&
+                                      node.min_z[slot] <= box.max[2] && node.max_z[slot] >= box.min[2];
+                mask |= uint32_t(overlaps) << slot;
+            }
+            return mask;
+#endif
+        }
+
+        // Used slots the ray enters before max_distance, with their entry distances.
+        [[nodiscard]] static forceinline uint32_t RayMask(const Node &node, const Ray &ray, float max_distance, FixedArray<float, Width> &distances) noexcept
+        {
+#if defined(BE_SIMD_SSE2)
+            const auto slab = [](const float *min, const float *max, float origin, float inv_direction, __m128 &entry, __m128 &exit)
+            {
+                const auto o = _mm_set1_ps(origin);
+                const auto d = _mm_set1_ps(inv_direction);
+                const auto t0 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(min), o), d);
+                const auto t1 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(max), o), d);
+                entry = _mm_max_ps(entry, _mm_min_ps(t0, t1));
+                exit = _mm_min_ps(exit, _mm_max_ps(t0, t1));
+            };
+
+            auto entry = _mm_setzero_ps();
+            auto exit = _mm_set1_ps(max_distance);
+            slab(node.min_x.data(), node.max_x.data(), ray.origin[0], ray.inv_direction[0], entry, exit);
+            slab(node.min_y.data(), node.max_y.data(), ray.origin[1], ray.inv_direction[1], entry, exit);
+            slab(node.min_z.data(), node.max_z.data(), ray.origin[2], ray.inv_direction[2], entry, exit);
+            _mm_storeu_ps(distances.data(), entry);
+
+            const auto used = _mm_castsi128_ps(_mm_cmpgt_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(node.count.data())), _mm_setzero_si128()));
+            return uint32_t(_mm_movemask_ps(_mm_and_ps(used, _mm_cmple_ps(entry, exit))));
+#else
+            uint32_t mask{0};
+            for (usize_t slot = 0; slot < Width; slot++)
+            {
+                const Box box{{node.min_x[slot], node.min_y[slot], node.min_z[slot]}, {node.max_x[slot], node.max_y[slot], node.max_z[slot]}};
+                distances[slot] = RayDistance(box, ray);
+                mask |= uint32_t(node.count[slot] && distances[slot] <= max_distance) << slot;
+            }
+            return mask;
+#endif
+        }
+
+    private:
+        Array<Node> m_nodes;
+        Array<uint32_t> m_node_first; // First primitive of the subtree of every node.
+        Array<uint32_t> m_indices;    // Box indices in leaf order.
+        Array<Box> m_leaf_boxes;      // Bounds in leaf order.
+
+        // Build only, reordered along with the splits.
+        Array<BuildPrimitive> m_build_primitives;
+        Array<DeferredSubtree> m_build_tasks;
+    };
+
+}
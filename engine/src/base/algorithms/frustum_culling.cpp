@@ -0,0 +1,211 @@
+#include "base/base.h"
+
+namespace Be
+{
+
+    Frustum Frustum::FromMatrix(const Matrix4x4 &view_projection, bool inf_reversed_z) noexcept
+    {
+        Vector4 planes[PlaneCount];
+        Math::ExtractFrustum(planes, view_projection, inf_reversed_z);
+
+        Frustum frustum;
+        for (usize_t i = 0; i < PlaneCount; i++)
+        {
+            frustum.x[i] = float(planes[i].x);
+            frustum.y[i] = float(planes[i].y);
+            frustum.z[i] = float(planes[i].z);
+            frustum.w[i] = float(planes[i].w);
+        }
+        return frustum;
+    }
+
+    Frustum Frustum::GetTransformed(const Matrix4x4 &transform) const noexcept
+    {
+        const auto transpose = Math::Transpose(transform);
+
+        Frustum frustum;
+        for (usize_t i = 0; i < PlaneCount; i++)
+        {
+            const auto plane = transpose * Vector4{x[i], y[i], z[i], w[i]};
+            frustum.x[i] = float(plane.x);
+            frustum.y[i] = float(plane.y);
+            frustum.z[i] = float(plane.z);
+            frustum.w[i] = float(plane.w);
+        }
+        return frustum;
+    }
+
+    bool Frustum::Intersects(const BBox &box) const noexcept
+    {
+        const auto center = box.GetCenter();
+        const auto extent = 0.5 * box.GetSize();
+        for (usize_t i = 0; i < PlaneCount; i++)
+        {
+            const auto distance = x[i] * center.x + y[i] * center.y + z[i] * center.z + w[i];
+            const auto radius = std::abs(x[i]) * extent.x + std::abs(y[i]) * extent.y + std::abs(z[i]) * extent.z;
+            if (distance + radius < 0)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void PushCullingBounds(CullingBounds &bounds, const BBox &box)
+    {
+        const auto center = box.GetCenter();
+        const auto extent = 0.5 * box.GetSize();
+
+        // The float center is off by half an ulp at most, the extent covers it.
+        const auto grow = [](double c, double e)
+        { return std::nextafter(float(e + std::abs(c) * double(std::numeric_limits<float>::epsilon())), std::numeric_limits<float>::max()); };
+
+        bounds.push_back(float(center.x), float(center.y), float(center.z),
+                         grow(center.x, extent.x), grow(center.y, extent.y), grow(center.z, extent.z));
+    }
+
+    namespace
+    {
+        struct CullingColumns
+        {
+            const float *cx, *cy, *cz;
+            const float *ex, *ey, *ez;
+        };
+
+        // Same operation order as the SIMD paths, so every path gives the same result.
+        [[nodiscard]] forceinline bool IsVisible(const Frustum &frustum, const CullingColumns &c, usize_t i) noexcept
+        {
+            bool visible{true};
+            for (usize_t p = 0; p < Frustum::PlaneCount; p++)
+            {
+                const auto distance = (frustum.x[p] * c.cx[i] + frustum.y[p] * c.cy[i]) + (frustum.z[p] * c.cz[i] + frustum.w[p]);
+                const auto radius = std::abs(frustum.x[p]) * c.ex[i] + std::abs(frustum.y[p]) * c.ey[i] + std::abs(frustum.z[p]) * c.ez[i];
+                visible &= distance + radius >= 0.0f;
+            }
+            return visible;
+        }
+
+        // Every candidate is written, only the visible ones advance the output.
+        template <usize_t WIDTH>
+        forceinline uint32_t *WriteVisible(uint32_t *visible, uint32_t mask, usize_t first) noexcept
+        {
+            for (usize_t lane = 0; lane < WIDTH; lane++)
+            {
+                *visible = uint32_t(first + lane);
+                visible += (mask >> lane) & 1;
+            }
+            return visible;
+        }
+
+#if defined(BE_SIMD_AVX)
+        [[nodiscard]] uint32_t *FrustumCullAvx(const Frustum &frustum, const CullingColumns &c, usize_t &i, usize_t end, uint32_t *visible) noexcept
+        {
+            const auto sign_mask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFF'FFFF));
+
+            __m256 px[Frustum::PlaneCount], py[Frustum::PlaneCount], pz[Frustum::PlaneCount], pw[Frustum::PlaneCount];
+            __m256 ax[Frustum::PlaneCount], ay[Frustum::PlaneCount], az[Frustum::PlaneCount];
+            for (usize_t p = 0; p < Frustum::PlaneCount; p++)
+            {
+                px[p] = _mm256_set1_ps(frustum.x[p]);
+                py[p] = _mm256_set1_ps(frustum.y[p]);
+                pz[p] = _mm256_set1_ps(frustum.z[p]);
+                pw[p] = _mm256_set1_ps(frustum.w[p]);
+                ax[p] = _mm256_and_ps(px[p], sign_mask);
+                ay[p] = _mm256_and_ps(py[p], sign_mask);
+                az[p] = _mm256_and_ps(pz[p], sign_mask);
+            }
+
+            for (; i + 8 <= end; i += 8)
+            {
+                const auto cx = _mm256_loadu_ps(c.cx + i);
+                const auto cy = _mm256_loadu_ps(c.cy + i);
+                const auto cz = _mm256_loadu_ps(c.cz + i);
+                const auto ex = _mm256_loadu_ps(c.ex + i);
+                const auto ey = _mm256_loadu_ps(c.ey + i);
+                const auto ez = _mm256_loadu_ps(c.ez + i);
+
+                auto inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+                for (usize_t p = 0; p < Frustum::PlaneCount; p++)
+                {
+                    const auto distance = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(px[p], cx), _mm256_mul_ps(py[p], cy)),
+                                                        _mm256_add_ps(_mm256_mul_ps(pz[p], cz), pw[p]));
+                    const auto radius = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(ax[p], ex), _mm256_mul_ps(ay[p], ey)), _mm256_mul_ps(az[p], ez));
+                    inside = _mm256_and_ps(inside, _mm256_cmp_ps(_mm256_add_ps(distance, radius), _mm256_setzero_ps(), _CMP_GE_OQ));
+                }
+
+                visible = WriteVisible<8>(visible, uint32_t(_mm256_movemask_ps(inside)), i);
+            }
+            return visible;
+        }
+#endif
+
+#if defined(BE_SIMD_SSE2)
+        [[nodiscard]] uint32_t *FrustumCullSse(const Frustum &frustum, const CullingColumns &c, usize_t &i, usize_t end, uint32_t *visible) noexcept
+        {
+            const auto sign_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFF'FFFF));
+
+            for (; i + 4 <= end; i += 4)
+            {
+                const auto cx = _mm_loadu_ps(c.cx + i);
+                const auto cy = _mm_loadu_ps(c.cy + i);
+                const auto cz = _mm_loadu_ps(c.cz + i);
+                const auto ex = _mm_loadu_ps(c.ex + i);
+                const auto ey = _mm_loadu_ps(c.ey + i);
+                const auto ez = _mm_loadu_ps(c.ez + i);
+
+                auto inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+                for (usize_t p = 0; p < Frustum::PlaneCount; p++)
+                {
+                    const auto px = _mm_set1_ps(frustum.x[p]);
+                    const auto py = _mm_set1_ps(frustum.y[p]);
+                    const auto pz = _mm_set1_ps(frustum.z[p]);
+
+                    const auto distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(px, cx), _mm_mul_ps(py, cy)),
+                                                     _mm_add_ps(_mm_mul_ps(pz, cz), _mm_set1_ps(frustum.w[p])));
+                    const auto radius = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_and_ps(px, sign_mask), ex), _mm_mul_ps(_mm_and_ps(py, sign_mask), ey)),
+                                                   _mm_mul_ps(_mm_and_ps(pz, sign_mask), ez));
+                    inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(distance, radius), _mm_setzero_ps()));
+                }
+
+                visible = WriteVisible<4>(visible, uint32_t(_mm_movemask_ps(inside)), i);
+            }
+            return visible;
+        }
+#endif
+    }
+
+    usize_t FrustumCull(const Frustum &frustum, const CullingBounds &bounds, usize_t begin, usize_t end, uint32_t *visible) noexcept
+    {
+        PROFILER_SCOPE;
+
+        using namespace CullingBoundsColumn;
+
+        ASSERT(begin <= end && end <= bounds.size());
+
+        const CullingColumns columns{
+            bounds.GetColumn<eCenterX>().data(),
+            bounds.GetColumn<eCenterY>().data(),
+            bounds.GetColumn<eCenterZ>().data(),
+            bounds.GetColumn<eExtentX>().data(),
+            bounds.GetColumn<eExtentY>().data(),
+            bounds.GetColumn<eExtentZ>().data(),
+        };
+
+        auto *out = visible;
+        auto i = begin;
+#if defined(BE_SIMD_AVX)
+        out = FrustumCullAvx(frustum, columns, i, end, out);
+#endif
+#if defined(BE_SIMD_SSE2)
+        out = FrustumCullSse(frustum, columns, i, end, out);
+#endif
+        for (; i < end; i++)
+        {
+            *out = uint32_t(i);
+            out += IsVisible(frustum, columns, i);
+        }
+
+        return usize_t(out - visible);
+    }
+
+}
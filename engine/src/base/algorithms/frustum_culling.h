@@ -0,0 +1,96 @@
+#pragma once
+
+namespace Be
+{
+
+    // Frustum planes with the normals pointing inwards, one row per coefficient so that
+    // every plane is broadcast against several boxes at once. A point p is inside when
+    // x * p.x + y * p.y + z * p.z + w >= 0 holds for all planes. The planes are not
+    // normalized, only the signs of the distances are used.
+    struct Frustum
+    {
+        static constexpr usize_t PlaneCount = 6;
+
+        FixedArray<float, PlaneCount> x;
+        FixedArray<float, PlaneCount> y;
+        FixedArray<float, PlaneCount> z;
+        FixedArray<float, PlaneCount> w;
+
+        [[nodiscard]] static Frustum FromMatrix(const Matrix4x4 &view_projection, bool inf_reversed_z) noexcept;
+
+        // The planes in the space that transform takes into the space of the frustum, with
+        // column vectors as in BBox::GetTransformed.
+        [[nodiscard]] Frustum GetTransformed(const Matrix4x4 &transform) const noexcept;
+
+        [[nodiscard]] bool Intersects(const BBox &box) const noexcept;
+    };
+
+    // Culling input: box centers and half extents in single precision, one column per
+    // component.
+    using CullingBounds = SoAArray<float, float, float, float, float, float>;
+
+    namespace CullingBoundsColumn
+    {
+        enum : usize_t
+        {
+            eCenterX,
+            eCenterY,
+            eCenterZ,
+            eExtentX,
+            eExtentY,
+            eExtentZ,
+        };
+    }
+
+    // Rounding to floats only grows the boxes, so culling stays conservative.
+    void PushCullingBounds(CullingBounds &bounds, const BBox &box);
+
+    // Writes the indices of the boxes [begin, end) that intersect the frustum and returns
+    // their count. visible must have room for end - begin indices. Boxes are tested eight
+    // at a time with AVX, four with SSE2, one by one otherwise.
+    [[nodiscard]] usize_t FrustumCull(const Frustum &frustum, const CullingBounds &bounds, usize_t begin, usize_t end, uint32_t *visible) noexcept;
+
+    // Same culling split into blocks, one task per block writes to its own range of the
+    // output, the ranges are packed afterwards. run(task_count, func) has to call
+    // func(task_index) for every task and return once all of them are done.
+    template <typename RunTasks>
+    [[nodiscard]] usize_t FrustumCullParallel(const Frustum &frustum, const CullingBounds &bounds, Span<uint32_t> visible,
+                                              usize_t task_count, RunTasks &&run)
+    {
+        PROFILER_SCOPE;
+
+        // Blocks of whole SIMD groups, large enough to amortize a task.
+        constexpr usize_t MIN_BLOCK_SIZE = 4096;
+
+        const auto count = bounds.size();
+        ASSERT(visible.size() >= count);
+
+        const auto block_size = AlignUp(std::max((count + task_count - 1) / std::max(task_count, usize_t(1)), MIN_BLOCK_SIZE), usize_t(8));
+        task_count = (count + block_size - 1) / block_size;
+        if (task_count < 2)
+        {
+            return FrustumCull(frustum, bounds, 0, count, visible.data());
+        }
+
+        Array<usize_t> counts(task_count);
+        run(task_count, [&](usize_t task)
+            {
+                const auto begin = task * block_size;
+                counts[task] = FrustumCull(frustum, bounds, begin, std::min(begin + block_size, count), visible.data() + begin); });
+
+        usize_t total{counts[0]};
+        for (usize_t task = 1; task < task_count; task++)
+        {
+            // Blocks in place while all the earlier ones are fully visible, std::copy can't
+            // take a destination at the start of its source.
+            const auto begin = visible.begin() + task * block_size;
+            if (total != task * block_size)
+            {
+                std::copy(begin, begin + counts[task], visible.begin() + total);
+            }
+            total += counts[task];
+        }
+        return total;
+    }
+
+}
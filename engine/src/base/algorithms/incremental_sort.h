@@ -0,0 +1,105 @@
+#pragma once
+
+namespace Be
+{
+
+    // Order of items kept between updates. Changed items are queued, Update sorts only
+    // them and merges them into the kept order in one pass, so an update with nothing
+    // queued costs nothing. An entry carries the version its item had when it was
+    // sorted, entries of removed items and of items with a newer version are skipped
+    // by the readers and dropped by the next merge.
+    template <typename Handle>
+    class IncrementalSort
+    {
+    public:
+        struct Entry
+        {
+            uint64_t sorting_key;
+            Handle handle;
+            uint32_t version;
+        };
+
+    public:
+        // Queued again after every change of the sorting key and once removed. A handle
+        // may be queued more than once, collect decides which copy is used.
+        forceinline void Queue(Handle handle)
+        {
+            m_queued.push_back(handle);
+        }
+
+        // collect(handle, entry) fills the sorting key and the version of a queued item
+        // and returns false for the items to skip. is_current(entry) tells whether a kept
+        // entry is still valid. Entries of the queued items go after the kept ones with
+        // equal keys. Returns false when nothing was queued.
+        template <typename Collect, typename IsCurrent>
+        bool Update(Collect &&collect, IsCurrent &&is_current, MemoryResource *resource = std::pmr::get_default_resource())
+        {
+            PROFILER_SCOPE;
+
+            if (m_queued.empty())
+            {
+                return false;
+            }
+
+            PmrArray<Entry> entries{resource};
+            PmrArray<uint64_t> keys{resource};
+            PmrArray<uint32_t> indices{resource};
+            entries.reserve(m_queued.size());
+            keys.reserve(m_queued.size());
+            indices.reserve(m_queued.size());
+            for (const auto handle : m_queued)
+            {
+                Entry entry{0, handle, 0};
+                if (!collect(handle, entry))
+                {
+                    continue;
+                }
+
+                indices.push_back(uint32_t(entries.size()));
+                keys.push_back(entry.sorting_key);
+                entries.push_back(entry);
+            }
+            m_queued.clear();
+
+            PmrArray<uint64_t> temp_keys{keys.size(), resource};
+            PmrArray<uint32_t> temp_indices{indices.size(), resource};
+            RadixSort(keys, indices, temp_keys, temp_indices);
+
+            m_merged.clear();
+            m_merged.reserve(m_sorted.size() + entries.size());
+            usize_t n{0};
+            for (const auto &entry : m_sorted)
+            {
+                if (!is_current(entry))
+                {
+                    continue;
+                }
+                for (; n < indices.size() && keys[n] < entry.sorting_key; n++)
+                {
+                    m_merged.push_back(entries[indices[n]]);
+                }
+                m_merged.push_back(entry);
+            }
+            for (; n < indices.size(); n++)
+            {
+                m_merged.push_back(entries[indices[n]]);
+            }
+
+            std::swap(m_sorted, m_merged);
+            return true;
+        }
+
+    public:
+        // Sorted by key, may hold entries that are no longer current.
+        [[nodiscard]] forceinline Span<const Entry> GetSorted() const noexcept
+        {
+            return m_sorted;
+        }
+
+    private:
+        Array<Entry> m_sorted;
+        Array<Entry> m_merged;
+        Array<Handle> m_queued;
+    };
+
+}
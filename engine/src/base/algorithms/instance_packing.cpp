@@ -0,0 +1,59 @@
+#include "base/base.h"
+
+namespace Be
+{
+
+    void InstancePacker::Reset(byte_t *data, usize_t size) noexcept
+    {
+        m_data = data;
+        m_size = size;
+        m_offset.store(0, std::memory_order_relaxed);
+        m_dropped_bytes.store(0, std::memory_order_relaxed);
+
+        m_item_count.store(0, std::memory_order_relaxed);
+        m_batch_count.store(0, std::memory_order_relaxed);
+        m_instance_bytes.store(0, std::memory_order_relaxed);
+        m_dropped_count.store(0, std::memory_order_relaxed);
+    }
+
+    uint32_t InstancePacker::Reserve(usize_t stride, usize_t count) noexcept
+    {
+        if (stride != 0)
+        {
+            const auto size = stride * count;
+            auto end = m_offset.load(std::memory_order_relaxed);
+            usize_t offset;
+            do
+            {
+                offset = (end + stride - 1) / stride * stride;
+                if (offset + size > m_size)
+                {
+                    // Smaller batches may still fit, the offset stays where it is.
+                    m_dropped_bytes.fetch_add(size + stride - 1, std::memory_order_relaxed);
+                    m_dropped_count.fetch_add(uint32_t(count), std::memory_order_relaxed);
+                    return INVALID_INDEX;
+                }
+            } while (!m_offset.compare_exchange_weak(end, offset + size, std::memory_order_relaxed));
+
+            m_item_count.fetch_add(uint32_t(count), std::memory_order_relaxed);
+            m_batch_count.fetch_add(1, std::memory_order_relaxed);
+            m_instance_bytes.fetch_add(uint64_t(size), std::memory_order_relaxed);
+            return uint32_t(offset / stride);
+        }
+
+        m_item_count.fetch_add(uint32_t(count), std::memory_order_relaxed);
+        m_batch_count.fetch_add(1, std::memory_order_relaxed);
+        return 0;
+    }
+
+    InstancePackingStats InstancePacker::GetStats() const noexcept
+    {
+        return {
+            .item_count = m_item_count.load(std::memory_order_relaxed),
+            .batch_count = m_batch_count.load(std::memory_order_relaxed),
+            .instance_bytes = m_instance_bytes.load(std::memory_order_relaxed),
+            .dropped_count = m_dropped_count.load(std::memory_order_relaxed),
+        };
+    }
+
+}
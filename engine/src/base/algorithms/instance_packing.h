@@ -0,0 +1,61 @@
+#pragma once
+
+namespace Be
+{
+
+    struct InstancePackingStats
+    {
+        uint32_t item_count{0};
+        uint32_t batch_count{0};
+        uint64_t instance_bytes{0};
+        uint32_t dropped_count{0}; // Items of the batches that didn't fit, not in item_count.
+
+        [[nodiscard]] forceinline float GetInstancingRatio() const noexcept
+        {
+            return batch_count ? float(item_count) / float(batch_count) : 0.0f;
+        }
+    };
+
+    // Packs the payloads of instanced batches into one buffer from several threads. A
+    // batch starts at a multiple of its stride, so the payload of instance i is element
+    // first + i of the buffer viewed as an array of stride sized elements.
+    class InstancePacker final : public Noncopyable
+    {
+    public:
+        static constexpr uint32_t INVALID_INDEX = ~0u;
+
+    public:
+        // Starts over in the given memory.
+        void Reset(byte_t *data, usize_t size) noexcept;
+
+        // Room for count payloads of stride bytes. Returns the index of the first one in
+        // strides, or INVALID_INDEX when the batch doesn't fit. Batches without payloads
+        // take no room.
+        [[nodiscard]] uint32_t Reserve(usize_t stride, usize_t count) noexcept;
+
+        [[nodiscard]] forceinline byte_t *GetPayload(usize_t stride, uint32_t index) const noexcept
+        {
+            return m_data + stride * index;
+        }
+
+        // Bytes asked for since Reset, more than the size when batches were dropped.
+        [[nodiscard]] forceinline usize_t GetRequestedSize() const noexcept
+        {
+            return m_offset.load(std::memory_order_relaxed) + m_dropped_bytes.load(std::memory_order_relaxed);
+        }
+
+        [[nodiscard]] InstancePackingStats GetStats() const noexcept;
+
+    private:
+        byte_t *m_data{nullptr};
+        usize_t m_size{0};
+        Atomic<usize_t> m_offset{0};
+        Atomic<usize_t> m_dropped_bytes{0};
+
+        Atomic<uint32_t> m_item_count{0};
+        Atomic<uint32_t> m_batch_count{0};
+        Atomic<uint64_t> m_instance_bytes{0};
+        Atomic<uint32_t> m_dropped_count{0};
+    };
+
+}
@@ -0,0 +1,179 @@
+#include "base/base.h"
+
+namespace Be
+{
+
+    void PushMeshletCullingBounds(MeshletCullingBounds &bounds, const Float3 &center, float radius, const Float3 &cone_axis, float cone_cutoff)
+    {
+        bounds.push_back(center.x, center.y, center.z, radius, cone_axis.x, cone_axis.y, cone_axis.z, cone_cutoff);
+    }
+
+    namespace
+    {
+        struct MeshletColumns
+        {
+            const float *cx, *cy, *cz, *radius;
+            const float *ax, *ay, *az, *cutoff;
+        };
+
+        // The planes are not normalized, the radius is scaled by the length of their normals.
+        struct MeshletFrustum
+        {
+            Frustum planes;
+            FixedArray<float, Frustum::PlaneCount> length;
+            Float3 camera;
+        };
+
+        // Same operation order as the SIMD paths, so every path gives the same result.
+        [[nodiscard]] forceinline bool IsVisible(const MeshletFrustum &f, const MeshletColumns &c, usize_t i) noexcept
+        {
+            bool visible{true};
+            for (usize_t p = 0; p < Frustum::PlaneCount; p++)
+            {
+                const auto distance = (f.planes.x[p] * c.cx[i] + f.planes.y[p] * c.cy[i]) + (f.planes.z[p] * c.cz[i] + f.planes.w[p]);
+                visible &= distance + f.length[p] * c.radius[i] >= 0.0f;
+            }
+
+            const auto dx = c.cx[i] - f.camera.x;
+            const auto dy = c.cy[i] - f.camera.y;
+            const auto dz = c.cz[i] - f.camera.z;
+            const auto distance = std::sqrt((dx * dx + dy * dy) + dz * dz);
+            const auto facing = (dx * c.ax[i] + dy * c.ay[i]) + dz * c.az[i];
+            visible &= facing < c.cutoff[i] * distance + c.radius[i];
+
+            return visible;
+        }
+
+        // Every candidate is written, only the visible ones advance the output.
+        template <usize_t WIDTH>
+        forceinline uint32_t *WriteVisible(uint32_t *visible, uint32_t mask, usize_t first) noexcept
+        {
+            for (usize_t lane = 0; lane < WIDTH; lane++)
+            {
+                *visible = uint32_t(first + lane);
+                visible += (mask >> lane) & 1;
+            }
+            return visible;
+        }
+
+#if defined(BE_SIMD_AVX)
+        [[nodiscard]] uint32_t *MeshletCullAvx(const MeshletFrustum &f, const MeshletColumns &c, usize_t &i, usize_t end, uint32_t *visible) noexcept
+        {
+            const auto camera_x = _mm256_set1_ps(f.camera.x);
+            const auto camera_y = _mm256_set1_ps(f.camera.y);
+            const auto camera_z = _mm256_set1_ps(f.camera.z);
+
+            for (; i + 8 <= end; i += 8)
+            {
+                const auto cx = _mm256_loadu_ps(c.cx + i);
+                const auto cy = _mm256_loadu_ps(c.cy + i);
+                const auto cz = _mm256_loadu_ps(c.cz + i);
+                const auto radius = _mm256_loadu_ps(c.radius + i);
+
+                auto inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+                for (usize_t p = 0; p < Frustum::PlaneCount; p++)
+                {
+                    const auto distance = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(f.planes.x[p]), cx), _mm256_mul_ps(_mm256_set1_ps(f.planes.y[p]), cy)),
+                                                        _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(f.planes.z[p]), cz), _mm256_set1_ps(f.planes.w[p])));
+                    const auto sphere = _mm256_add_ps(distance, _mm256_mul_ps(_mm256_set1_ps(f.length[p]), radius));
+                    inside = _mm256_and_ps(inside, _mm256_cmp_ps(sphere, _mm256_setzero_ps(), _CMP_GE_OQ));
+                }
+
+                const auto dx = _mm256_sub_ps(cx, camera_x);
+                const auto dy = _mm256_sub_ps(cy, camera_y);
+                const auto dz = _mm256_sub_ps(cz, camera_z);
+                const auto distance = _mm256_sqrt_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)), _mm256_mul_ps(dz, dz)));
+                const auto facing = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, _mm256_loadu_ps(c.ax + i)), _mm256_mul_ps(dy, _mm256_loadu_ps(c.ay + i))),
+                                                  _mm256_mul_ps(dz, _mm256_loadu_ps(c.az + i)));
+                const auto limit = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(c.cutoff + i), distance), radius);
+                inside = _mm256_and_ps(inside, _mm256_cmp_ps(facing, limit, _CMP_LT_OQ));
+
+                visible = WriteVisible<8>(visible, uint32_t(_mm256_movemask_ps(inside)), i);
+            }
+            return visible;
+        }
+#endif
+
+#if defined(BE_SIMD_SSE2)
+        [[nodiscard]] uint32_t *MeshletCullSse(const MeshletFrustum &f, const MeshletColumns &c, usize_t &i, usize_t end, uint32_t *visible) noexcept
+        {
+            const auto camera_x = _mm_set1_ps(f.camera.x);
+            const auto camera_y = _mm_set1_ps(f.camera.y);
+            const auto camera_z = _mm_set1_ps(f.camera.z);
+
+            for (; i + 4 <= end; i += 4)
+            {
+                const auto cx = _mm_loadu_ps(c.cx + i);
+                const auto cy = _mm_loadu_ps(c.cy + i);
+                const auto cz = _mm_loadu_ps(c.cz + i);
+                const auto radius = _mm_loadu_ps(c.radius + i);
+
+                auto inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+                for (usize_t p = 0; p < Frustum::PlaneCount; p++)
+                {
+                    const auto distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(f.planes.x[p]), cx), _mm_mul_ps(_mm_set1_ps(f.planes.y[p]), cy)),
+                                                     _mm_add_ps(_mm_mul_ps(_mm_set1_ps(f.planes.z[p]), cz), _mm_set1_ps(f.planes.w[p])));
+                    const auto sphere = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(f.length[p]), radius));
+                    inside = _mm_and_ps(inside, _mm_cmpge_ps(sphere, _mm_setzero_ps()));
+                }
+
+                const auto dx = _mm_sub_ps(cx, camera_x);
+                const auto dy = _mm_sub_ps(cy, camera_y);
+                const auto dz = _mm_sub_ps(cz, camera_z);
+                const auto distance = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz)));
+                const auto facing = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, _mm_loadu_ps(c.ax + i)), _mm_mul_ps(dy, _mm_loadu_ps(c.ay + i))),
+                                               _mm_mul_ps(dz, _mm_loadu_ps(c.az + i)));
+                const auto limit = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(c.cutoff + i), distance), radius);
+                inside = _mm_and_ps(inside, _mm_cmplt_ps(facing, limit));
+
+                visible = WriteVisible<4>(visible, uint32_t(_mm_movemask_ps(inside)), i);
+            }
+            return visible;
+        }
+#endif
+    }
+
+    usize_t MeshletCull(const Frustum &frustum, const Float3 &camera_position, const MeshletCullingBounds &bounds,
+                        usize_t begin, usize_t end, uint32_t *visible) noexcept
+    {
+        PROFILER_SCOPE;
+
+        using namespace MeshletCullingBoundsColumn;
+
+        ASSERT(begin <= end && end <= bounds.size());
+
+        const MeshletColumns columns{
+            bounds.GetColumn<eCenterX>().data(),
+            bounds.GetColumn<eCenterY>().data(),
+            bounds.GetColumn<eCenterZ>().data(),
+            bounds.GetColumn<eRadius>().data(),
+            bounds.GetColumn<eConeAxisX>().data(),
+            bounds.GetColumn<eConeAxisY>().data(),
+            bounds.GetColumn<eConeAxisZ>().data(),
+            bounds.GetColumn<eConeCutoff>().data(),
+        };
+
+        MeshletFrustum f{frustum, {}, camera_position};
+        for (usize_t p = 0; p < Frustum::PlaneCount; p++)
+        {
+            f.length[p] = std::sqrt(frustum.x[p] * frustum.x[p] + frustum.y[p] * frustum.y[p] + frustum.z[p] * frustum.z[p]);
+        }
+
+        auto *out = visible;
+        auto i = begin;
+#if defined(BE_SIMD_AVX)
+        out = MeshletCullAvx(f, columns, i, end, out);
+#endif
+#if defined(BE_SIMD_SSE2)
+        out = MeshletCullSse(f, columns, i, end, out);
+#endif
+        for (; i < end; i++)
+        {
+            *out = uint32_t(i);
+            out += IsVisible(f, columns, i);
+        }
+
+        return usize_t(out - visible);
+    }
+
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+namespace Be
+{
+
+    // Meshlet culling input: bounding sphere and normal cone of every meshlet, as computed
+    // by meshopt_computeMeshletBounds, one column per component. A cone cutoff of one or
+    // more disables the backface test of its meshlet.
+    using MeshletCullingBounds = SoAArray<float, float, float, float, float, float, float, float>;
+
+    namespace MeshletCullingBoundsColumn
+    {
+        enum : usize_t
+        {
+            eCenterX,
+            eCenterY,
+            eCenterZ,
+            eRadius,
+            eConeAxisX,
+            eConeAxisY,
+            eConeAxisZ,
+            eConeCutoff,
+        };
+    }
+
+    void PushMeshletCullingBounds(MeshletCullingBounds &bounds, const Float3 &center, float radius, const Float3 &cone_axis, float cone_cutoff);
+
+    // Writes the indices of the meshlets [begin, end) that intersect the frustum and may
+    // face the camera and returns their count. A meshlet is back facing when the camera
+    // sees its whole sphere from behind its normal cone:
+    //     dot(center - camera, axis) >= cutoff * length(center - camera) + radius
+    // The frustum and the camera position are given in the space of the bounds, so the
+    // cone test only holds for transforms without shear or non uniform scale. visible
+    // must have room for end - begin indices. Meshlets are tested eight at a time with
+    // AVX, four with SSE2, one by one otherwise.
+    [[nodiscard]] usize_t MeshletCull(const Frustum &frustum, const Float3 &camera_position, const MeshletCullingBounds &bounds,
+                                      usize_t begin, usize_t end, uint32_t *visible) noexcept;
+
+}
@@ -0,0 +1,340 @@
+#include "base/base.h"
+
+namespace Be
+{
+
+    namespace
+    {
+        [[nodiscard]] forceinline Float4 ToClip(const Float4x4 &m, float x, float y, float z) noexcept
+        {
+            return {
+                x * m.data[0][0] + y * m.data[1][0] + z * m.data[2][0] + m.data[3][0],
+                x * m.data[0][1] + y * m.data[1][1] + z * m.data[2][1] + m.data[3][1],
+                x * m.data[0][2] + y * m.data[1][2] + z * m.data[2][2] + m.data[3][2],
+                x * m.data[0][3] + y * m.data[1][3] + z * m.data[2][3] + m.data[3][3],
+            };
+        }
+
+        [[nodiscard]] forceinline Float4 Lerp(const Float4 &a, const Float4 &b, float t) noexcept
+        {
+            return {a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t, a.z + (b.z - a.z) * t, a.w + (b.w - a.w) * t};
+        }
+    }
+
+    OcclusionBuffer::OcclusionBuffer(uint32_t width, uint32_t height)
+        : m_width{AlignUp(std::max(width, 1u), BinWidth)},
+          m_height{AlignUp(std::max(height, 1u), BinHeight)},
+          m_bins_x{m_width / BinWidth}
+    {
+        STATIC_ASSERT(BinWidth % TileWidth == 0 && BinHeight % TileHeight == 0 && TileWidth % 4 == 0, "Bins are made of whole tiles and SIMD groups.");
+
+        m_depth.resize(usize_t(m_width) * m_height);
+        m_tiles.resize(usize_t(m_width / TileWidth) * (m_height / TileHeight));
+        m_bins.resize(usize_t(m_bins_x) * (m_height / BinHeight));
+    }
+
+    void OcclusionBuffer::Begin(const Matrix4x4 &view_projection)
+    {
+        PROFILER_SCOPE;
+
+        m_view_projection = view_projection;
+
+        std::fill(m_depth.begin(), m_depth.end(), 0.0f);
+        std::fill(m_tiles.begin(), m_tiles.end(), 0.0f);
+        m_triangles.clear();
+        for (auto &bin : m_bins)
+        {
+            bin.clear();
+        }
+    }
+
+    void OcclusionBuffer::AddOccluder(Span<const Float3> positions, Span<const uint32_t> indices, const Matrix4x4 &model_view_projection)
+    {
+        PROFILER_SCOPE;
+
+        const Float4x4 mvp{model_view_projection};
+
+        for (usize_t i = 0; i + 2 < indices.size(); i += 3)
+        {
+            Float4 clip[3];
+            uint32_t behind{0};
+            for (usize_t v = 0; v < 3; v++)
+            {
+                const auto &p = positions[indices[i + v]];
+                clip[v] = ToClip(mvp, p.x, p.y, p.z);
+                behind += clip[v].w < NearW;
+            }
+
+            if (behind == 3)
+            {
+                continue;
+            }
+            if (behind == 0)
+            {
+                AddTriangle(clip);
+                continue;
+            }
+
+            // Clipping by the near plane leaves a triangle or a quad.
+            Float4 polygon[4];
+            usize_t count{0};
+            for (usize_t v = 0; v < 3; v++)
+            {
+                const auto &a = clip[v];
+                const auto &b = clip[(v + 1) % 3];
+                if (a.w >= NearW)
+                {
+                    polygon[count++] = a;
+                }
+                if ((a.w >= NearW) != (b.w >= NearW))
+                {
+                    polygon[count++] = Lerp(a, b, (NearW - a.w) / (b.w - a.w));
+                }
+            }
+
+            for (usize_t v = 1; v + 1 < count; v++)
+            {
+                const Float4 triangle[3] = {polygon[0], polygon[v], polygon[v + 1]};
+                AddTriangle(triangle);
+            }
+        }
+    }
+
+    void OcclusionBuffer::AddTriangle(const Float4 (&clip)[3])
+    {
+        float x[3], y[3], z[3];
+        for (usize_t v = 0; v < 3; v++)
+        {
+            const auto inv_w = 1.0f / clip[v].w;
+            x[v] = (clip[v].x * inv_w * 0.5f + 0.5f) * float(m_width);
+            y[v] = (clip[v].y * inv_w * 0.5f + 0.5f) * float(m_height);
+            z[v] = inv_w;
+        }
+
+        auto area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+        if (std::abs(area) < std::numeric_limits<float>::min())
+        {
+            return;
+        }
+        if (area < 0.0f)
+        {
+            std::swap(x[1], x[2]);
+            std::swap(y[1], y[2]);
+            std::swap(z[1], z[2]);
+            area = -area;
+        }
+
+        // Pixels whose centers can be inside, the rest of the screen is skipped.
+        const auto min_x = std::max(std::ceil(std::min({x[0], x[1], x[2]}) - 0.5f), 0.0f);
+        const auto min_y = std::max(std::ceil(std::min({y[0], y[1], y[2]}) - 0.5f), 0.0f);
+        const auto max_x = std::min(std::floor(std::max({x[0], x[1], x[2]}) - 0.5f) + 1.0f, float(m_width));
+        const auto max_y = std::min(std::floor(std::max({y[0], y[1], y[2]}) - 0.5f) + 1.0f, float(m_height));
+        if (min_x >= max_x || min_y >= max_y)
+        {
+            return;
+        }
+
+        Triangle triangle;
+        for (usize_t e = 0; e < 3; e++)
+        {
+            const auto from = e;
+            const auto to = (e + 1) % 3;
+            triangle.a[e] = y[from] - y[to];
+            triangle.b[e] = x[to] - x[from];
+            triangle.c[e] = -(triangle.a[e] * x[from] + triangle.b[e] * y[from]);
+        }
+        triangle.depth_a = ((z[1] - z[0]) * (y[2] - y[0]) - (z[2] - z[0]) * (y[1] - y[0])) / area;
+        triangle.depth_b = ((x[1] - x[0]) * (z[2] - z[0]) - (x[2] - x[0]) * (z[1] - z[0])) / area;
+        triangle.depth_c = z[0] - triangle.depth_a * x[0] - triangle.depth_b * y[0];
+        triangle.min_x = uint32_t(min_x);
+        triangle.min_y = uint32_t(min_y);
+        triangle.max_x = uint32_t(max_x);
+        triangle.max_y = uint32_t(max_y);
+
+        const auto index = uint32_t(m_triangles.size());
+        m_triangles.push_back(triangle);
+
+        for (auto bin_y = triangle.min_y / BinHeight; bin_y <= (triangle.max_y - 1) / BinHeight; bin_y++)
+        {
+            for (auto bin_x = triangle.min_x / BinWidth; bin_x <= (triangle.max_x - 1) / BinWidth; bin_x++)
+            {
+                m_bins[bin_y * m_bins_x + bin_x].push_back(index);
+            }
+        }
+    }
+
+    void OcclusionBuffer::Rasterize()
+    {
+        PROFILER_SCOPE;
+
+        for (usize_t bin = 0; bin < m_bins.size(); bin++)
+        {
+            RasterizeBin(bin);
+        }
+    }
+
+    void OcclusionBuffer::RasterizeBin(usize_t bin)
+    {
+        PROFILER_SCOPE;
+
+        const auto &triangles = m_bins[bin];
+        if (triangles.empty())
+        {
+            return;
+        }
+
+        const auto bin_x = uint32_t(bin % m_bins_x) * BinWidth;
+        const auto bin_y = uint32_t(bin / m_bins_x) * BinHeight;
+
+        for (const auto index : triangles)
+        {
+            const auto &t = m_triangles[index];
+
+            // Groups of four pixels, bins are made of whole groups.
+            const auto x0 = std::max(t.min_x, bin_x) & ~3u;
+            const auto x1 = std::min(t.max_x, bin_x + BinWidth);
+            const auto y0 = std::max(t.min_y, bin_y);
+            const auto y1 = std::min(t.max_y, bin_y + BinHeight);
+
+            for (auto y = y0; y < y1; y++)
+            {
+                const auto py = float(y) + 0.5f;
+                auto *row = m_depth.data() + usize_t(y) * m_width;
+#if defined(BE_SIMD_SSE2)
+                const auto offsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+                const auto a0 = _mm_set1_ps(t.a[0]), a1 = _mm_set1_ps(t.a[1]), a2 = _mm_set1_ps(t.a[2]);
+                const auto r0 = _mm_set1_ps(t.b[0] * py + t.c[0]);
+                const auto r1 = _mm_set1_ps(t.b[1] * py + t.c[1]);
+                const auto r2 = _mm_set1_ps(t.b[2] * py + t.c[2]);
+                const auto da = _mm_set1_ps(t.depth_a);
+                const auto dr = _mm_set1_ps(t.depth_b * py + t.depth_c);
+                const auto zero = _mm_setzero_ps();
+
+                for (auto x = x0; x < x1; x += 4)
+                {
+                    const auto px = _mm_add_ps(_mm_set1_ps(float(x)), offsets);
+                    const auto inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(a0, px), r0), zero),
+                                                              _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(a1, px), r1), zero)),
+                                                   _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(a2, px), r2), zero));
+                    const auto depth = _mm_add_ps(_mm_mul_ps(da, px), dr);
+                    const auto current = _mm_loadu_ps(row + x);
+                    const auto nearest = _mm_max_ps(current, depth);
+                    _mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, nearest), _mm_andnot_ps(inside, current)));
+                }
+#else
+                for (auto x = x0; x < AlignUp(x1, 4u); x++)
+                {
+                    const auto px = float(x) + 0.5f;
+                    const bool inside = t.a[0] * px + t.b[0] * py + t.c[0] >= 0.0f &&
+                                        t.a[1] * px + t.b[1] * py + t.c[1] >= 0.0f &&
+                                        t.a[2] * px + t.b[2] * py + t.c[2] >= 0.0f;
+                    if (inside)
+                    {
+                        row[x] = std::max(row[x], t.depth_a * px + t.depth_b * py + t.depth_c);
+                    }
+                }
+#endif
+            }
+        }
+
+        // Farthest depth of the tiles of the bin.
+        const auto tiles_x = m_width / TileWidth;
+        for (auto tile_y = bin_y / TileHeight; tile_y < (bin_y + BinHeight) / TileHeight; tile_y++)
+        {
+            for (auto tile_x = bin_x / TileWidth; tile_x < (bin_x + BinWidth) / TileWidth; tile_x++)
+            {
+                auto farthest = std::numeric_limits<float>::max();
+                for (auto y = tile_y * TileHeight; y < (tile_y + 1) * TileHeight; y++)
+                {
+                    const auto *row = m_depth.data() + usize_t(y) * m_width + tile_x * TileWidth;
+                    for (uint32_t x = 0; x < TileWidth; x++)
+                    {
+                        farthest = std::min(farthest, row[x]);
+                    }
+                }
+                m_tiles[tile_y * tiles_x + tile_x] = farthest;
+            }
+        }
+    }
+
+    bool OcclusionBuffer::IsVisible(const BBox &box) const noexcept
+    {
+        const Float3 min{box.min};
+        const Float3 max{box.max};
+
+        auto min_x = std::numeric_limits<float>::max();
+        auto min_y = std::numeric_limits<float>::max();
+        auto max_x = std::numeric_limits<float>::lowest();
+        auto max_y = std::numeric_limits<float>::lowest();
+        float nearest{0.0f};
+        for (uint32_t corner = 0; corner < 8; corner++)
+        {
+            const auto clip = ToClip(m_view_projection, (corner & 1) ? max.x : min.x, (corner & 2) ? max.y : min.y, (corner & 4) ? max.z : min.z);
+            if (clip.w < NearW)
+            {
+                return true;
+            }
+            const auto inv_w = 1.0f / clip.w;
+            const auto x = (clip.x * inv_w * 0.5f + 0.5f) * float(m_width);
+            const auto y = (clip.y * inv_w * 0.5f + 0.5f) * float(m_height);
+            min_x = std::min(min_x, x);
+            min_y = std::min(min_y, y);
+            max_x = std::max(max_x, x);
+            max_y = std::max(max_y, y);
+            nearest = std::max(nearest, inv_w);
+        }
+
+        // Every pixel the box touches, whole pixels count as covered by their centers.
+        const auto x0 = uint32_t(std::clamp(std::floor(min_x), 0.0f, float(m_width)));
+        const auto y0 = uint32_t(std::clamp(std::floor(min_y), 0.0f, float(m_height)));
+        const auto x1 = uint32_t(std::clamp(std::ceil(max_x), 0.0f, float(m_width)));
+        const auto y1 = uint32_t(std::clamp(std::ceil(max_y), 0.0f, float(m_height)));
+        if (x0 >= x1 || y0 >= y1)
+        {
+            return true;
+        }
+
+        const auto tiles_x = m_width / TileWidth;
+        for (auto tile_y = y0 / TileHeight; tile_y <= (y1 - 1) / TileHeight; tile_y++)
+        {
+            for (auto tile_x = x0 / TileWidth; tile_x <= (x1 - 1) / TileWidth; tile_x++)
+            {
+                if (nearest < m_tiles[tile_y * tiles_x + tile_x])
+                {
+                    continue;
+                }
+
+                const auto px0 = std::max(x0, tile_x * TileWidth);
+                const auto px1 = std::min(x1, (tile_x + 1) * TileWidth);
+                const auto py0 = std::max(y0, tile_y * TileHeight);
+                const auto py1 = std::min(y1, (tile_y + 1) * TileHeight);
+                for (auto y = py0; y < py1; y++)
+                {
+                    const auto *row = m_depth.data() + usize_t(y) * m_width;
+                    for (auto x = px0; x < px1; x++)
+                    {
+                        if (nearest >= row[x])
+                        {
+                            return true;
+                        }
+                    }
+                }
+            }
+        }
+        return false;
+    }
+
+    usize_t OcclusionBuffer::Cull(Span<const BBox> bounds, Span<const uint32_t> candidates, uint32_t *visible) const noexcept
+    {
+        PROFILER_SCOPE;
+
+        auto *out = visible;
+        for (const auto index : candidates)
+        {
+            *out = index;
+            out += IsVisible(bounds[index]);
+        }
+        return usize_t(out - visible);
+    }
+
+}
@@ -0,0 +1,152 @@
+#pragma once
+
+namespace Be
+{
+
+    // Low resolution depth buffer rasterized on the CPU from a few large occluders, boxes
+    // hidden behind them are culled without waiting for the GPU. Depth is stored as 1 / w,
+    // larger is nearer and the buffer clears to zero: the values interpolate linearly over
+    // the screen and no depth range convention matters. Matrices follow the convention of
+    // Frustum::FromMatrix. The screen is split into bins rasterized independently, every
+    // tile of the buffer keeps the farthest depth written into it, so most boxes are
+    // decided by a few tiles.
+    class OcclusionBuffer final
+    {
+    public:
+        static constexpr uint32_t TileWidth = 8;
+        static constexpr uint32_t TileHeight = 8;
+        static constexpr uint32_t BinWidth = 64;
+        static constexpr uint32_t BinHeight = 32;
+
+        // Triangles and boxes closer than this w are clipped, boxes crossing it are visible.
+        static constexpr float NearW = 1e-3f;
+
+    public:
+        // The size is rounded up to whole bins.
+        OcclusionBuffer(uint32_t width, uint32_t height);
+
+    public:
+        // Clears the buffer and the occluders of the previous frame.
+        void Begin(const Matrix4x4 &view_projection);
+
+        // Clips and bins the triangles, model_view_projection takes the positions to clip
+        // space. Both windings are drawn. Occluders are added from one thread.
+        void AddOccluder(Span<const Float3> positions, Span<const uint32_t> indices, const Matrix4x4 &model_view_projection);
+
+        void Rasterize();
+
+        // One task per bin. run(task_count, func) has to call func(task_index) for every
+        // task and return once all of them are done.
+        template <typename RunTasks>
+        void RasterizeParallel(RunTasks &&run)
+        {
+            PROFILER_SCOPE;
+
+            run(m_bins.size(), [this](usize_t bin)
+                { RasterizeBin(bin); });
+        }
+
+    public:
+        // False when the box is behind the occluders everywhere it covers the screen.
+        // Boxes off the screen are left to frustum culling and reported visible.
+        [[nodiscard]] bool IsVisible(const BBox &box) const noexcept;
+
+        // Writes the candidates whose bounds are visible and returns their count, in the
+        // candidate order. visible must have room for all candidates.
+        [[nodiscard]] usize_t Cull(Span<const BBox> bounds, Span<const uint32_t> candidates, uint32_t *visible) const noexcept;
+
+        // Same test split into blocks of candidates, one task per block writes to its own
+        // range of the output, the ranges are packed afterwards.
+        template <typename RunTasks>
+        [[nodiscard]] usize_t CullParallel(Span<const BBox> bounds, Span<const uint32_t> candidates, Span<uint32_t> visible,
+                                           usize_t task_count, RunTasks &&run) const
+        {
+            PROFILER_SCOPE;
+
+            constexpr usize_t MIN_BLOCK_SIZE = 1024;
+
+            const auto count = candidates.size();
+            ASSERT(visible.size() >= count);
+
+            const auto block_size = std::max((count + task_count - 1) / std::max(task_count, usize_t(1)), MIN_BLOCK_SIZE);
+            task_count = (count + block_size - 1) / block_size;
+            if (task_count < 2)
+            {
+                return Cull(bounds, candidates, visible.data());
+            }
+
+            Array<usize_t> counts(task_count);
+            run(task_count, [&](usize_t task)
+                {
+                    const auto begin = task * block_size;
+                    counts[task] = Cull(bounds, candidates.subspan(begin, std::min(block_size, count - begin)), visible.data() + begin); });
+
+            usize_t total{counts[0]};
+            for (usize_t task = 1; task < task_count; task++)
+            {
+                // Blocks in place while all the earlier ones are fully visible, std::copy can't
+                // take a destination at the start of its source.
+                const auto begin = visible.begin() + task * block_size;
+                if (total != task * block_size)
+                {
+                    std::copy(begin, begin + counts[task], visible.begin() + total);
+                }
+                total += counts[task];
+            }
+            return total;
+        }
+
+    public:
+        [[nodiscard]] forceinline uint32_t GetWidth() const noexcept
+        {
+            return m_width;
+        }
+
+        [[nodiscard]] forceinline uint32_t GetHeight() const noexcept
+        {
+            return m_height;
+        }
+
+        // 1 / w of the nearest occluder at the pixel center, zero where there is none.
+        [[nodiscard]] forceinline float GetDepth(uint32_t x, uint32_t y) const noexcept
+        {
+            return m_depth[y * m_width + x];
+        }
+
+        [[nodiscard]] forceinline usize_t GetTriangleCount() const noexcept
+        {
+            return m_triangles.size();
+        }
+
+    private:
+        // Edge functions a * x + b * y + c, positive inside, and the depth plane, in pixels.
+        struct Triangle
+        {
+            FixedArray<float, 3> a;
+            FixedArray<float, 3> b;
+            FixedArray<float, 3> c;
+            float depth_a;
+            float depth_b;
+            float depth_c;
+            uint32_t min_x;
+            uint32_t min_y;
+            uint32_t max_x; // Exclusive.
+            uint32_t max_y; // Exclusive.
+        };
+
+        void AddTriangle(const Float4 (&clip)[3]);
+        void RasterizeBin(usize_t bin);
+
+    private:
+        uint32_t m_width;
+        uint32_t m_height;
+        uint32_t m_bins_x;
+        Float4x4 m_view_projection;
+
+        Array<float> m_depth;
+        Array<float> m_tiles; // Farthest depth of every tile.
+        Array<Triangle> m_triangles;
+        Array<Array<uint32_t>> m_bins; // Triangles overlapping every bin.
+    };
+
+}
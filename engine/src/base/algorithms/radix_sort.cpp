@@ -0,0 +1,111 @@
+#include "base/base.h"
+
+namespace Be
+{
+
+    namespace details
+    {
+        void RadixInsertionSort(Span<uint64_t> keys, Span<uint32_t> values) noexcept
+        {
+            for (usize_t i = 1; i < keys.size(); i++)
+            {
+                const auto key = keys[i];
+                const auto value = values[i];
+
+                auto j = i;
+                for (; j > 0 && keys[j - 1] > key; j--)
+                {
+                    keys[j] = keys[j - 1];
+                    values[j] = values[j - 1];
+                }
+                keys[j] = key;
+                values[j] = value;
+            }
+        }
+
+        void RadixCount(Span<const uint64_t> keys, RadixHistogram *histograms, uint32_t first_pass, uint32_t pass_count) noexcept
+        {
+            PROFILER_SCOPE;
+
+            const auto last_pass = first_pass + pass_count;
+            for (auto pass = first_pass; pass < last_pass; pass++)
+            {
+                histograms[pass].fill(0);
+            }
+
+            for (const auto key : keys)
+            {
+                for (auto pass = first_pass; pass < last_pass; pass++)
+                {
+                    histograms[pass][RadixDigit(key, pass)]++;
+                }
+            }
+        }
+
+        void RadixScatter(Span<const uint64_t> src_keys, Span<const uint32_t> src_values, uint64_t *dst_keys, uint32_t *dst_values,
+                          RadixHistogram &offsets, uint32_t pass) noexcept
+        {
+            PROFILER_SCOPE;
+
+            for (usize_t i = 0; i < src_keys.size(); i++)
+            {
+                const auto key = src_keys[i];
+                const auto index = offsets[RadixDigit(key, pass)]++;
+                dst_keys[index] = key;
+                dst_values[index] = src_values[i];
+            }
+        }
+    }
+
+    void RadixSort(Span<uint64_t> keys, Span<uint32_t> values, Span<uint64_t> temp_keys, Span<uint32_t> temp_values) noexcept
+    {
+        PROFILER_SCOPE;
+
+        using namespace details;
+
+        const auto count = keys.size();
+        ASSERT(values.size() == count && temp_keys.size() >= count && temp_values.size() >= count);
+
+        if (count < RadixSortMinCount)
+        {
+            RadixInsertionSort(keys, values);
+            return;
+        }
+
+        // One read of the keys builds the histograms of all passes.
+        FixedArray<RadixHistogram, RadixPasses> histograms;
+        RadixCount(keys, histograms.data(), 0, RadixPasses);
+
+        auto src_keys = keys.data();
+        auto src_values = values.data();
+        auto dst_keys = temp_keys.data();
+        auto dst_values = temp_values.data();
+
+        for (uint32_t pass = 0; pass < RadixPasses; pass++)
+        {
+            auto &offsets = histograms[pass];
+            if (offsets[RadixDigit(src_keys[0], pass)] == count)
+            {
+                continue;
+            }
+
+            uint32_t offset{0};
+            for (auto &h : offsets)
+            {
+                offset += std::exchange(h, offset);
+            }
+
+            RadixScatter({src_keys, count}, {src_values, count}, dst_keys, dst_values, offsets, pass);
+
+            std::swap(src_keys, dst_keys);
+            std::swap(src_values, dst_values);
+        }
+
+        if (src_keys != keys.data())
+        {
+            std::copy_n(src_keys, count, keys.data());
+            std::copy_n(src_values, count, values.data());
+        }
+    }
+
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+namespace Be
+{
+
+    namespace details
+    {
+        static constexpr uint32_t RadixBits = 11;
+        static constexpr uint32_t RadixSize = 1u << RadixBits;
+        static constexpr uint32_t RadixMask = RadixSize - 1;
+        static constexpr uint32_t RadixPasses = (64 + RadixBits - 1) / RadixBits;
+
+        // Below this size the histograms cost more than the sort itself.
+        static constexpr usize_t RadixSortMinCount = 256;
+
+        using RadixHistogram = FixedArray<uint32_t, RadixSize>;
+
+        [[nodiscard]] forceinline uint32_t RadixDigit(uint64_t key, uint32_t pass) noexcept
+        {
+            return uint32_t(key >> (pass * RadixBits)) & RadixMask;
+        }
+
+        void RadixInsertionSort(Span<uint64_t> keys, Span<uint32_t> values) noexcept;
+        // Fills histograms[first_pass, first_pass + pass_count).
+        void RadixCount(Span<const uint64_t> keys, RadixHistogram *histograms, uint32_t first_pass, uint32_t pass_count) noexcept;
+        void RadixScatter(Span<const uint64_t> src_keys, Span<const uint32_t> src_values, uint64_t *dst_keys, uint32_t *dst_values,
+                          RadixHistogram &offsets, uint32_t pass) noexcept;
+    }
+
+    // Stable LSD radix sort of 64-bit keys carrying 32-bit payloads, usually indices of
+    // the records being sorted, so the records are moved once afterwards. 11-bit digits
+    // take 6 passes, a pass is skipped when all keys share its digit. The temp spans
+    // must be at least as large as the keys.
+    void RadixSort(Span<uint64_t> keys, Span<uint32_t> values, Span<uint64_t> temp_keys, Span<uint32_t> temp_values) noexcept;
+
+    // Same sort split into blocks, every block is counted and scattered by its own task
+    // with its own histogram. run(task_count, func) has to call func(task_index) for every
+    // task and return once all of them are done.
+    template <typename RunTasks>
+    void RadixSortParallel(Span<uint64_t> keys, Span<uint32_t> values, Span<uint64_t> temp_keys, Span<uint32_t> temp_values,
+                           usize_t task_count, RunTasks &&run)
+    {
+        PROFILER_SCOPE;
+
+        using namespace details;
+
+        const auto count = keys.size();
+        ASSERT(values.size() == count && temp_keys.size() >= count && temp_values.size() >= count);
+
+        const auto block_size = std::max((count + task_count - 1) / std::max(task_count, usize_t(1)), RadixSortMinCount);
+        task_count = (count + block_size - 1) / block_size;
+        if (task_count < 2)
+        {
+            RadixSort(keys, values, temp_keys, temp_values);
+            return;
+        }
+
+        const auto block = [=](auto span, usize_t task)
+        {
+            const auto begin = task * block_size;
+            return span.subspan(begin, std::min(block_size, count - begin));
+        };
+
+        // Histograms of all passes over the initial blocks: their sum tells which passes
+        // can be skipped and the first pass reuses them as is.
+        Array<RadixHistogram> histograms(task_count * RadixPasses);
+        run(task_count, [&](usize_t task)
+            { RadixCount(block(Span<const uint64_t>{keys}, task), &histograms[task * RadixPasses], 0, RadixPasses); });
+
+        Span<uint64_t> src_keys{keys}, dst_keys{temp_keys.first(count)};
+        Span<uint32_t> src_values{values}, dst_values{temp_values.first(count)};
+        bool first_pass{true};
+
+        for (uint32_t pass = 0; pass < RadixPasses; pass++)
+        {
+            const auto digit = RadixDigit(keys[0], pass);
+            usize_t digit_count{0};
+            for (usize_t task = 0; task < task_count; task++)
+            {
+                digit_count += histograms[task * RadixPasses + pass][digit];
+            }
+            if (digit_count == count)
+            {
+                continue;
+            }
+
+            if (!first_pass)
+            {
+                run(task_count, [&](usize_t task)
+                    { RadixCount(block(Span<const uint64_t>{src_keys}, task), &histograms[task * RadixPasses], pass, 1); });
+            }
+            first_pass = false;
+
+            // Offsets ordered by digit, then by block, keep the sort stable.
+            uint32_t offset{0};
+            for (uint32_t d = 0; d < RadixSize; d++)
+            {
+                for (usize_t task = 0; task < task_count; task++)
+                {
+                    auto &h = histograms[task * RadixPasses + pass][d];
+                    offset += std::exchange(h, offset);
+                }
+            }
+
+            run(task_count, [&](usize_t task)
+                { RadixScatter(block(Span<const uint64_t>{src_keys}, task), block(Span<const uint32_t>{src_values}, task),
+                               dst_keys.data(), dst_values.data(), histograms[task * RadixPasses + pass], pass); });
+
+            std::swap(src_keys, dst_keys);
+            std::swap(src_values, dst_values);
+        }
+
+        if (src_keys.data() != keys.data())
+        {
+            std::copy(src_keys.begin(), src_keys.end(), keys.begin());
+            std::copy(src_values.begin(), src_values.end(), values.begin());
+        }
+    }
+
+}
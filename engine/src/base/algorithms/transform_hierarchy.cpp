@@ -0,0 +1,301 @@
+#include "base/base.h"
+
+namespace Be
+{
+
+    namespace
+    {
+        // world = parent * T * R * S, the bottom row of the local matrix is (0, 0, 0, 1).
+        forceinline void ComposeWorld(const Float4x4 *parent, const Float3 &t, const Quatf &q, const Float3 &s, Float4x4 &world) noexcept
+        {
+            const auto xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+            const auto xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+            const auto wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+
+            const float local[3][4] = {
+                {(1.0f - 2.0f * (yy + zz)) * s.x, 2.0f * (xy - wz) * s.y, 2.0f * (xz + wy) * s.z, t.x},
+                {2.0f * (xy + wz) * s.x, (1.0f - 2.0f * (xx + zz)) * s.y, 2.0f * (yz - wx) * s.z, t.y},
+                {2.0f * (xz - wy) * s.x, 2.0f * (yz + wx) * s.y, (1.0f - 2.0f * (xx + yy)) * s.z, t.z},
+            };
+
+            if (parent == nullptr)
+            {
+                for (usize_t row = 0; row < 3; row++)
+                {
+                    for (usize_t col = 0; col < 4; col++)
+                    {
+                        world.data[row][col] = local[row][col];
+                    }
+                }
+                world.data[3][0] = world.data[3][1] = world.data[3][2] = 0.0f;
+                world.data[3][3] = 1.0f;
+                return;
+            }
+
+            const auto &p = parent->data;
+#if defined(BE_SIMD_SSE2)
+            const auto l0 = _mm_loadu_ps(local[0]);
+            const auto l1 = _mm_loadu_ps(local[1]);
+            const auto l2 = _mm_loadu_ps(local[2]);
+            const auto l3 = _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f);
+            for (usize_t row = 0; row < 4; row++)
+            {
+                const auto r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(p[row][0]), l0), _mm_mul_ps(_mm_set1_ps(p[row][1]), l1)),
+                                          _mm_add_ps(_mm_mul_ps(_mm_set1_ps(p[row][2]), l2), _mm_mul_ps(_mm_set1_ps(p[row][3]), l3)));
+                _mm_storeu_ps(world.data[row], r);
+            }
+#else
+            for (usize_t row = 0; row < 4; row++)
+            {
+                for (usize_t col = 0; col < 4; col++)
+                {
+                    world.data[row][col] = (p[row][0] * local[0][col] + p[row][1] * local[1][col]) + (p[row][2] * local[2][col] + (col == 3 ? p[row][3] : 0.0f));
+                }
+            }
+#endif
+        }
+    }
+
+    TransformHandle TransformHierarchy::Create(TransformHandle parent)
+    {
+        PROFILER_SCOPE;
+
+        const auto parent_index = parent ? GetIndex(parent) : NoParent;
+
+        uint32_t slot_index{m_free_head};
+        if (slot_index == NoParent)
+        {
+            VERIFY(m_slots.size() < NoParent, "Transform hierarchy is full.");
+            slot_index = uint32_t(m_slots.size());
+            m_slots.push_back({0, 1});
+        }
+        else
+        {
+            m_free_head = m_slots[slot_index].index;
+        }
+
+        auto &slot = m_slots[slot_index];
+        slot.index = uint32_t(m_nodes.size());
+        m_nodes.push_back(parent_index, Float3{0.0f}, Quatf{}, Float3{1.0f}, Float4x4{}, uint8_t(eLocalDirty), slot_index);
+
+        m_reorder = true;
+        m_dirty = true;
+
+        return {slot_index, slot.generation};
+    }
+
+    void TransformHierarchy::Destroy(TransformHandle node)
+    {
+        PROFILER_SCOPE;
+
+        if (!Contains(node))
+        {
+            return;
+        }
+
+        const auto index = m_slots[node.index].index;
+        m_nodes.Get<eFlags>(index) |= eDestroyed;
+        ReleaseSlot(node.index);
+
+        m_reorder = true;
+    }
+
+    void TransformHierarchy::SetParent(TransformHandle node, TransformHandle parent)
+    {
+        PROFILER_SCOPE;
+
+        const auto index = GetIndex(node);
+        const auto parent_index = parent ? GetIndex(parent) : NoParent;
+
+        for (auto ancestor = parent_index; ancestor != NoParent; ancestor = m_nodes.Get<eParent>(ancestor))
+        {
+            VERIFY(ancestor != index, "Transform node can't be parented to its own subtree.");
+        }
+
+        m_nodes.Get<eParent>(index) = parent_index;
+        MarkDirty(index);
+        m_reorder = true;
+    }
+
+    bool TransformHierarchy::Contains(TransformHandle node) const noexcept
+    {
+        return node.index < m_slots.size() && node.generation != 0 && m_slots[node.index].generation == node.generation;
+    }
+
+    void TransformHierarchy::SetLocal(TransformHandle node, const Float3 &position, const Quatf &rotation, const Float3 &scale)
+    {
+        const auto index = GetIndex(node);
+        m_nodes.Get<ePosition>(index) = position;
+        m_nodes.Get<eRotation>(index) = rotation;
+        m_nodes.Get<eScale>(index) = scale;
+        MarkDirty(index);
+    }
+
+    void TransformHierarchy::SetPosition(TransformHandle node, const Float3 &position)
+    {
+        const auto index = GetIndex(node);
+        m_nodes.Get<ePosition>(index) = position;
+        MarkDirty(index);
+    }
+
+    void TransformHierarchy::SetRotation(TransformHandle node, const Quatf &rotation)
+    {
+        const auto index = GetIndex(node);
+        m_nodes.Get<eRotation>(index) = rotation;
+        MarkDirty(index);
+    }
+
+    void TransformHierarchy::SetScale(TransformHandle node, const Float3 &scale)
+    {
+        const auto index = GetIndex(node);
+        m_nodes.Get<eScale>(index) = scale;
+        MarkDirty(index);
+    }
+
+    void TransformHierarchy::MarkDirty(uint32_t index) noexcept
+    {
+        m_nodes.Get<eFlags>(index) |= eLocalDirty;
+        m_dirty = true;
+    }
+
+    void TransformHierarchy::ReleaseSlot(uint32_t slot_index) noexcept
+    {
+        auto &slot = m_slots[slot_index];
+        slot.index = m_free_head;
+        slot.generation = slot.generation == UMax ? 1 : slot.generation + 1;
+        m_free_head = slot_index;
+    }
+
+    void TransformHierarchy::Update()
+    {
+        PROFILER_SCOPE;
+
+        if (!BeginUpdate())
+        {
+            return;
+        }
+
+        UpdateNodes(0, m_nodes.size());
+
+        EndUpdate();
+    }
+
+    bool TransformHierarchy::BeginUpdate()
+    {
+        if (m_reorder)
+        {
+            Reorder();
+        }
+        return m_dirty || m_changed;
+    }
+
+    void TransformHierarchy::EndUpdate() noexcept
+    {
+        m_changed = m_dirty;
+        m_dirty = false;
+    }
+
+    // A node is recomputed when its local transform changed or when the world matrix of
+    // its parent did, the parent is always in an earlier level.
+    void TransformHierarchy::UpdateNodes(usize_t begin, usize_t end) noexcept
+    {
+        const auto *parents = m_nodes.GetColumn<eParent>().data();
+        const auto *positions = m_nodes.GetColumn<ePosition>().data();
+        const auto *rotations = m_nodes.GetColumn<eRotation>().data();
+        const auto *scales = m_nodes.GetColumn<eScale>().data();
+        auto *worlds = m_nodes.GetColumn<eWorld>().data();
+        auto *flags = m_nodes.GetColumn<eFlags>().data();
+
+        for (auto i = begin; i < end; i++)
+        {
+            const auto parent = parents[i];
+            const bool changed = (flags[i] & eLocalDirty) || (parent != NoParent && (flags[parent] & eWorldChanged));
+            if (!changed)
+            {
+                flags[i] = 0;
+                continue;
+            }
+
+            ComposeWorld(parent != NoParent ? &worlds[parent] : nullptr, positions[i], rotations[i], scales[i], worlds[i]);
+            flags[i] = eWorldChanged;
+        }
+    }
+
+    // Breadth first from the roots, destroyed nodes and their subtrees are not reached and
+    // their slots are released.
+    void TransformHierarchy::Reorder()
+    {
+        PROFILER_SCOPE;
+
+        const auto count = uint32_t(m_nodes.size());
+        const auto parents = m_nodes.GetColumn<eParent>();
+        const auto flags = m_nodes.GetColumn<eFlags>();
+
+        // Children of every node in one array, roots first.
+        Array<uint32_t> child_offsets(count + 2, 0);
+        for (uint32_t i = 0; i < count; i++)
+        {
+            if (!(flags[i] & eDestroyed))
+            {
+                child_offsets[(parents[i] == NoParent ? 0 : parents[i] + 1) + 1]++;
+            }
+        }
+        for (uint32_t i = 1; i < child_offsets.size(); i++)
+        {
+            child_offsets[i] += child_offsets[i - 1];
+        }
+        Array<uint32_t> children(child_offsets.back());
+        {
+            auto cursor = child_offsets;
+            for (uint32_t i = 0; i < count; i++)
+            {
+                if (!(flags[i] & eDestroyed))
+                {
+                    children[cursor[parents[i] == NoParent ? 0 : parents[i] + 1]++] = i;
+                }
+            }
+        }
+
+        Array<uint32_t> order(children.begin(), children.begin() + child_offsets[1]);
+        order.reserve(count);
+        m_levels.clear();
+        m_levels.push_back(0);
+        for (usize_t level_begin = 0; level_begin < order.size();)
+        {
+            const auto level_end = order.size();
+            for (auto i = level_begin; i < level_end; i++)
+            {
+                const auto node = order[i];
+                order.insert(order.end(), children.begin() + child_offsets[node + 1], children.begin() + child_offsets[node + 2]);
+            }
+            m_levels.push_back(uint32_t(level_end));
+            level_begin = level_end;
+        }
+
+        Array<uint32_t> new_index(count, NoParent);
+        Nodes nodes;
+        nodes.reserve(order.size());
+        for (const auto node : order)
+        {
+            new_index[node] = uint32_t(nodes.size());
+            const auto parent = parents[node];
+            const auto slot = m_nodes.Get<eSlot>(node);
+            nodes.push_back(parent == NoParent ? NoParent : new_index[parent], m_nodes.Get<ePosition>(node), m_nodes.Get<eRotation>(node),
+                            m_nodes.Get<eScale>(node), m_nodes.Get<eWorld>(node), flags[node], slot);
+            m_slots[slot].index = new_index[node];
+        }
+
+        // Descendants of destroyed nodes.
+        for (uint32_t i = 0; i < count; i++)
+        {
+            if (new_index[i] == NoParent && !(flags[i] & eDestroyed))
+            {
+                ReleaseSlot(m_nodes.Get<eSlot>(i));
+            }
+        }
+
+        m_nodes = std::move(nodes);
+        m_reorder = false;
+    }
+
+}
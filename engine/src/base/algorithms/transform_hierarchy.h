@@ -0,0 +1,179 @@
+#pragma once
+
+namespace Be
+{
+
+    class TransformHierarchy;
+
+    using TransformHandle = SlotHandle<TransformHierarchy>;
+
+    // Parent and child transforms. Nodes are kept in breadth first order, so every level
+    // is a contiguous range that follows the level of its parents and can be updated in
+    // parallel. The local transform is T * R * S and the world matrix is the parent world
+    // matrix times the local one, with column vectors as in BBox::GetTransformed. Update
+    // only recomputes the subtrees of the nodes changed since the previous update.
+    // Structural changes are applied by the next update, which reorders the nodes.
+    class TransformHierarchy final : public Noncopyable
+    {
+    public:
+        TransformHierarchy() = default;
+
+    public:
+        // A root without a parent.
+        [[nodiscard]] TransformHandle Create(TransformHandle parent = {});
+
+        // The whole subtree is destroyed, the handles of the descendants stay valid until
+        // the next update.
+        void Destroy(TransformHandle node);
+
+        // The node keeps its local transform. The parent can't be one of its descendants.
+        void SetParent(TransformHandle node, TransformHandle parent);
+
+        [[nodiscard]] bool Contains(TransformHandle node) const noexcept;
+
+    public:
+        void SetLocal(TransformHandle node, const Float3 &position, const Quatf &rotation, const Float3 &scale);
+        void SetPosition(TransformHandle node, const Float3 &position);
+        void SetRotation(TransformHandle node, const Quatf &rotation);
+        void SetScale(TransformHandle node, const Float3 &scale);
+
+        [[nodiscard]] forceinline const Float3 &GetPosition(TransformHandle node) const
+        {
+            return m_nodes.Get<ePosition>(GetIndex(node));
+        }
+
+        [[nodiscard]] forceinline const Quatf &GetRotation(TransformHandle node) const
+        {
+            return m_nodes.Get<eRotation>(GetIndex(node));
+        }
+
+        [[nodiscard]] forceinline const Float3 &GetScale(TransformHandle node) const
+        {
+            return m_nodes.Get<eScale>(GetIndex(node));
+        }
+
+        // As of the last update.
+        [[nodiscard]] forceinline const Float4x4 &GetWorld(TransformHandle node) const
+        {
+            return m_nodes.Get<eWorld>(GetIndex(node));
+        }
+
+        // True when the last update recomputed the world matrix of the node.
+        [[nodiscard]] forceinline bool IsWorldChanged(TransformHandle node) const
+        {
+            return m_nodes.Get<eFlags>(GetIndex(node)) & eWorldChanged;
+        }
+
+    public:
+        void Update();
+
+        // One task per block of every level. run(task_count, func) has to call
+        // func(task_index) for every task and return once all of them are done.
+        template <typename RunTasks>
+        void UpdateParallel(usize_t task_count, RunTasks &&run)
+        {
+            PROFILER_SCOPE;
+
+            constexpr usize_t MIN_BLOCK_SIZE = 4096;
+
+            if (!BeginUpdate())
+            {
+                return;
+            }
+
+            for (usize_t level = 0; level + 1 < m_levels.size(); level++)
+            {
+                const usize_t begin = m_levels[level];
+                const usize_t count = m_levels[level + 1] - begin;
+                const auto block_size = std::max((count + task_count - 1) / std::max(task_count, usize_t(1)), MIN_BLOCK_SIZE);
+                const auto level_task_count = (count + block_size - 1) / block_size;
+                if (level_task_count < 2)
+                {
+                    UpdateNodes(begin, begin + count);
+                    continue;
+                }
+
+                run(level_task_count, [&](usize_t task)
+                    {
+                        const auto first = begin + task * block_size;
+                        UpdateNodes(first, std::min(first + block_size, begin + count)); });
+            }
+
+            EndUpdate();
+        }
+
+    public:
+        [[nodiscard]] forceinline usize_t size() const noexcept
+        {
+            return m_nodes.size();
+        }
+
+        [[nodiscard]] forceinline bool empty() const noexcept
+        {
+            return m_nodes.empty();
+        }
+
+        // As of the last update.
+        [[nodiscard]] forceinline usize_t GetLevelCount() const noexcept
+        {
+            return m_levels.empty() ? 0 : m_levels.size() - 1;
+        }
+
+    private:
+        static constexpr uint32_t NoParent = UMax;
+
+        enum : uint8_t
+        {
+            eLocalDirty = 1,
+            eWorldChanged = 2,
+            eDestroyed = 4,
+        };
+
+        // Parent as an index into the nodes, the slot of the handle of every node.
+        using Nodes = SoAArray<uint32_t, Float3, Quatf, Float3, Float4x4, uint8_t, uint32_t>;
+
+        enum : usize_t
+        {
+            eParent,
+            ePosition,
+            eRotation,
+            eScale,
+            eWorld,
+            eFlags,
+            eSlot,
+        };
+
+        // For a live slot index points to the node, for a free one to the next free slot.
+        struct Slot
+        {
+            uint32_t index;
+            uint32_t generation;
+        };
+
+    private:
+        [[nodiscard]] forceinline uint32_t GetIndex(TransformHandle node) const
+        {
+            ASSERT(Contains(node));
+            return m_slots[node.index].index;
+        }
+
+        void MarkDirty(uint32_t index) noexcept;
+        void ReleaseSlot(uint32_t slot_index) noexcept;
+        void Reorder();
+
+        // False when there is nothing to update.
+        [[nodiscard]] bool BeginUpdate();
+        void UpdateNodes(usize_t begin, usize_t end) noexcept;
+        void EndUpdate() noexcept;
+
+    private:
+        Nodes m_nodes;
+        Array<Slot> m_slots;
+        Array<uint32_t> m_levels; // First node of every level and the node count.
+        uint32_t m_free_head{NoParent};
+        bool m_reorder{false};
+        bool m_dirty{false};
+        bool m_changed{false};
+    };
+
+}
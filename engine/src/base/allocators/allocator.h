@@ -6,6 +6,11 @@ namespace Be
     class MemoryAllocator
     {
     public:
+        explicit MemoryAllocator(EMemoryTag tag = EMemoryTag::eUntagged) noexcept
+            : m_tag{tag}
+        {
+        }
+
         virtual ~MemoryAllocator() noexcept = default;
 
     public:
@@ -13,6 +18,15 @@ namespace Be
         [[nodiscard]] virtual void *Alloc(usize_t size, usize_t align) = 0;
         virtual void Free(void *ptr) = 0;
         virtual void Reset() = 0;
+
+    public:
+        [[nodiscard]] forceinline EMemoryTag GetTag() const noexcept
+        {
+            return m_tag;
+        }
+
+    protected:
+        EMemoryTag m_tag{EMemoryTag::eUntagged};
     };
 
 }
\ No newline at end of file
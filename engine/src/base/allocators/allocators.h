@@ -4,3 +4,5 @@
 #include "base/allocators/allocator.h"
 #include "base/allocators/linear_allocator.h"
 #include "base/allocators/stack_allocator.h"
+#include "base/allocators/frame_ring_allocator.h"
+#include "base/allocators/memory_resource.h"
@@ -0,0 +1,104 @@
+#include "base/base.h"
+
+namespace Be
+{
+
+    FrameRingAllocator::~FrameRingAllocator() noexcept
+    {
+        for (auto &frame : m_frames)
+        {
+            RetireFrame(frame);
+        }
+    }
+
+    void FrameRingAllocator::Reset() noexcept
+    {
+        PROFILER_SCOPE;
+
+        for (auto &frame : m_frames)
+        {
+            RetireFrame(frame);
+        }
+
+        m_current->retired = false;
+    }
+
+    void FrameRingAllocator::BeginFrame(uint64_t frame_value) noexcept
+    {
+        PROFILER_SCOPE;
+
+        auto &frame = m_frames[frame_value % m_frames.size()];
+        if (&frame == m_current && frame.value == frame_value)
+        {
+            return;
+        }
+
+        VERIFY(frame.retired, "Frame {} reuses memory of frame {} which is still in flight.", frame_value, frame.value);
+
+        frame.value = frame_value;
+        frame.retired = false;
+        m_current = &frame;
+    }
+
+    void FrameRingAllocator::RetireFrames(uint64_t completed_value) noexcept
+    {
+        PROFILER_SCOPE;
+
+        for (auto &frame : m_frames)
+        {
+            if (&frame != m_current && frame.value <= completed_value)
+            {
+                RetireFrame(frame);
+            }
+        }
+    }
+
+    void *FrameRingAllocator::AllocOverflow(Frame &frame, usize_t size, usize_t align) noexcept
+    {
+        PROFILER_SCOPE;
+
+        const auto block_size = size + align - 1;
+        auto block = malloc(block_size);
+        VERIFY(block != nullptr, "Failed to allocate {} bytes of frame overflow memory.", block_size);
+
+        SpinLock lock{frame.overflow_mutex};
+        frame.overflow_blocks.emplace_back(block, block_size);
+        frame.overflow_size += block_size;
+        MemoryTracker::OnAlloc(m_tag, block_size);
+
+        return AlignUp(static_cast<byte_t *>(block), align);
+    }
+
+    void FrameRingAllocator::RetireFrame(Frame &frame) noexcept
+    {
+        if (frame.retired)
+        {
+            return;
+        }
+
+        const auto used = std::min(frame.offset.load(std::memory_order_relaxed), frame.capacity);
+        m_stats.last_frame_used = used;
+        m_stats.peak_frame_used = std::max(m_stats.peak_frame_used, used);
+        m_stats.last_frame_overflow = frame.overflow_size;
+        m_stats.peak_frame_overflow = std::max(m_stats.peak_frame_overflow, frame.overflow_size);
+
+        if (frame.overflow_size > 0)
+        {
+            m_stats.overflow_frames++;
+            LOG_WARN("Frame {} spilled {} bytes out of the frame ring allocator ({} bytes per frame).",
+                     frame.value, frame.overflow_size, frame.capacity);
+        }
+
+        for (auto [block, block_size] : frame.overflow_blocks)
+        {
+            MemoryTracker::OnFree(m_tag, block_size);
+            free(block);
+        }
+        frame.overflow_blocks.clear();
+        frame.overflow_size = 0;
+
+        frame.offset.store(0, std::memory_order_relaxed);
+        frame.retired = true;
+    }
+
+}
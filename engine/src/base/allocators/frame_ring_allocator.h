@@ -0,0 +1,129 @@
+#pragma once
+
+namespace Be
+{
+
+    // Splits the arena into frame_count partitions. A partition is reused only after
+    // the frame that owns it has been retired (its fence value has been reached).
+    // Allocations that do not fit into the partition spill into heap blocks that are
+    // released together with the frame.
+    class FrameRingAllocator final : public MemoryAllocator, public Noncopyable
+    {
+    public:
+        struct Stats
+        {
+            usize_t frame_capacity{0};
+            usize_t last_frame_used{0};
+            usize_t peak_frame_used{0};
+            usize_t last_frame_overflow{0};
+            usize_t peak_frame_overflow{0};
+            uint64_t overflow_frames{0};
+        };
+
+    private:
+        struct alignas(BE_CACHE_LINE) Frame
+        {
+            byte_t *begin{nullptr};
+            usize_t capacity{0};
+            Atomic<usize_t> offset{0};
+
+            uint64_t value{0};
+            bool retired{true};
+
+            SpinMutex overflow_mutex;
+            Array<Pair<void *, usize_t>> overflow_blocks;
+            usize_t overflow_size{0};
+        };
+
+    public:
+        FrameRingAllocator(const MemoryArena auto &arena, uint32_t frame_count) noexcept
+            : MemoryAllocator{arena.GetTag()},
+              m_frames(frame_count)
+        {
+            VERIFY(frame_count > 0, "Frame ring allocator requires at least one frame.");
+
+            auto begin = static_cast<byte_t *>(arena.Begin());
+            const auto capacity = AlignDown(arena.Size() / frame_count, BE_CACHE_LINE);
+            for (auto &frame : m_frames)
+            {
+                frame.begin = AlignUp(begin, BE_CACHE_LINE);
+                frame.capacity = capacity - usize_t(frame.begin - begin);
+                begin += capacity;
+            }
+
+            m_stats.frame_capacity = m_frames.front().capacity;
+            m_current = &m_frames.front();
+            m_current->retired = false;
+        }
+
+        ~FrameRingAllocator() noexcept override;
+
+    public:
+        [[nodiscard]] forceinline void *Alloc(usize_t size) noexcept override
+        {
+            return Alloc(size, 1);
+        }
+
+        [[nodiscard]] forceinline void *Alloc(usize_t size, usize_t align) noexcept override
+        {
+            auto &frame = *m_current;
+
+            const auto reserve = size + align - 1;
+            const auto offset = frame.offset.fetch_add(reserve, std::memory_order_relaxed);
+            if (offset + reserve <= frame.capacity) [[likely]]
+            {
+                return AlignUp(frame.begin + offset, align);
+            }
+
+            return AllocOverflow(frame, size, align);
+        }
+
+        forceinline void Free(void *) noexcept override
+        {
+            FATAL("Method not supported");
+        }
+
+        // Drops all frames at once. Only valid when nothing is in flight.
+        void Reset() noexcept override;
+
+    public:
+        // Makes the partition of frame_value current. The partition must be retired.
+        void BeginFrame(uint64_t frame_value) noexcept;
+
+        // Retires every frame whose value is less or equal to completed_value.
+        void RetireFrames(uint64_t completed_value) noexcept;
+
+        [[nodiscard]] forceinline bool IsFrameRetired(uint64_t frame_value) const noexcept
+        {
+            const auto &frame = m_frames[frame_value % m_frames.size()];
+            return frame.retired || frame.value != frame_value;
+        }
+
+        [[nodiscard]] forceinline uint32_t GetFrameCount() const noexcept
+        {
+            return uint32_t(m_frames.size());
+        }
+
+        [[nodiscard]] forceinline uint64_t GetCurrentFrame() const noexcept
+        {
+            return m_current->value;
+        }
+
+        [[nodiscard]] forceinline const Stats &GetStats() const noexcept
+        {
+            return m_stats;
+        }
+
+    private:
+        [[nodiscard]] void *AllocOverflow(Frame &frame, usize_t size, usize_t align) noexcept;
+        void RetireFrame(Frame &frame) noexcept;
+
+    private:
+        Array<Frame> m_frames;
+        Frame *m_current{nullptr};
+
+    private:
+        Stats m_stats{};
+    };
+
+}
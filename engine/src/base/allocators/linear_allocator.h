@@ -7,7 +7,8 @@ namespace Be
     {
     public:
         explicit LinearAllocator(const MemoryArena auto &arena) noexcept
-            : m_ptr{static_cast<byte_t *>(arena.Begin())},
+            : MemoryAllocator{arena.GetTag()},
+              m_ptr{static_cast<byte_t *>(arena.Begin())},
               m_begin{static_cast<byte_t *>(arena.Begin())},
               m_end{static_cast<byte_t *>(arena.End())}
         {
@@ -53,7 +54,8 @@ namespace Be
     {
     public:
         explicit LinearAllocatorWaitFree(const MemoryArena auto &arena) noexcept
-            : m_ptr{static_cast<byte_t *>(arena.Begin())},
+            : MemoryAllocator{arena.GetTag()},
+              m_ptr{static_cast<byte_t *>(arena.Begin())},
               m_begin{static_cast<byte_t *>(arena.Begin())},
               m_end{static_cast<byte_t *>(arena.End())}
         {
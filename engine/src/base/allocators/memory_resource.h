@@ -0,0 +1,55 @@
+#pragma once
+
+namespace Be
+{
+
+    // std::pmr adapter over MemoryAllocator. With FREE == false deallocation is ignored,
+    // which is what linear and frame allocators need: their memory is released by
+    // Reset() or frame retirement, not by the containers.
+    template <bool FREE>
+    class BasicAllocatorMemoryResource final : public MemoryResource, public Noncopyable
+    {
+    public:
+        explicit BasicAllocatorMemoryResource(MemoryAllocator &allocator) noexcept
+            : m_allocator{allocator}
+        {
+        }
+
+    public:
+        [[nodiscard]] forceinline MemoryAllocator &GetAllocator() const noexcept
+        {
+            return m_allocator;
+        }
+
+    private:
+        [[nodiscard]] void *do_allocate(usize_t size, usize_t align) override
+        {
+            auto ptr = m_allocator.Alloc(size, align);
+            if (ptr == nullptr) [[unlikely]]
+            {
+                throw std::bad_alloc{};
+            }
+            return ptr;
+        }
+
+        void do_deallocate(void *ptr, usize_t, usize_t) override
+        {
+            if constexpr (FREE)
+            {
+                m_allocator.Free(ptr);
+            }
+        }
+
+        [[nodiscard]] bool do_is_equal(const MemoryResource &other) const noexcept override
+        {
+            return this == &other;
+        }
+
+    private:
+        MemoryAllocator &m_allocator;
+    };
+
+    using AllocatorMemoryResource = BasicAllocatorMemoryResource<true>;
+    using MonotonicMemoryResource = BasicAllocatorMemoryResource<false>;
+
+}
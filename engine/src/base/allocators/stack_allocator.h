@@ -5,53 +5,133 @@ namespace Be
 
     class StackAllocator final : public MemoryAllocator, public MovableOnly
     {
+    private:
+        // Stored right before every allocation so Free can rewind without extra bookkeeping.
+        struct Header
+        {
+            usize_t prev_offset;
+            DEBUG_ONLY(byte_t *prev_allocation;)
+        };
+
+    public:
+        struct Marker
+        {
+            usize_t offset{0};
+            DEBUG_ONLY(byte_t *last_allocation{nullptr};)
+        };
+
+        // Rewinds the allocator to the state it had when the scope was created.
+        class ScopeGuard final : public MovableOnly
+        {
+        public:
+            explicit ScopeGuard(StackAllocator &allocator) noexcept
+                : m_allocator{&allocator},
+                  m_marker{allocator.GetMarker()}
+            {
+            }
+
+            ScopeGuard(ScopeGuard &&other) noexcept
+                : m_allocator{std::exchange(other.m_allocator, nullptr)},
+                  m_marker{other.m_marker}
+            {
+            }
+
+            ScopeGuard &operator=(ScopeGuard &&) = delete;
+
+            ~ScopeGuard() noexcept
+            {
+                if (m_allocator != nullptr)
+                {
+                    m_allocator->Rewind(m_marker);
+                }
+            }
+
+        private:
+            StackAllocator *m_allocator{nullptr};
+            Marker m_marker{};
+        };
+
     public:
         explicit StackAllocator(const MemoryArena auto &arena) noexcept
-            : m_ptr{static_cast<byte_t *>(arena.Begin())},
+            : MemoryAllocator{arena.GetTag()},
               m_begin{static_cast<byte_t *>(arena.Begin())},
               m_end{static_cast<byte_t *>(arena.End())}
         {
         }
 
     public:
-        [[nodiscard]] void *Alloc(usize_t size) noexcept override
+        [[nodiscard]] forceinline void *Alloc(usize_t size) noexcept override
         {
             return Alloc(size, 1);
         }
 
-        [[nodiscard]] void *Alloc(usize_t size, usize_t alignment) noexcept override
+        [[nodiscard]] forceinline void *Alloc(usize_t size, usize_t alignment) noexcept override
         {
-            size = AlignUp(size, alignment);
-            auto ptr = AlignUp(m_ptr, alignment);
-            size += (ptr - m_ptr);
+            auto ptr = AlignUp(m_begin + m_offset + sizeof(Header), std::max(alignment, alignof(Header)));
+            ASSERT(ptr + size <= m_end);
 
-            ASSERT(m_ptr + size <= m_end);
-            m_allocations.emplace_back(m_ptr);
-            m_ptr += size;
+            auto header = reinterpret_cast<Header *>(ptr) - 1;
+            header->prev_offset = m_offset;
+            DEBUG_ONLY(header->prev_allocation = m_last_allocation;)
+            DEBUG_ONLY(m_last_allocation = ptr;)
+
+            m_offset = usize_t(ptr + size - m_begin);
 
             return ptr;
         }
 
-        forceinline void Free(void *) noexcept override
+        // Only the most recent allocation can be freed.
+        forceinline void Free(void *ptr) noexcept override
+        {
+            if (ptr == nullptr)
+            {
+                return;
+            }
+
+            ASSERT_MSG(ptr == m_last_allocation, "Stack allocator: out of order free.");
+
+            auto header = static_cast<Header *>(ptr) - 1;
+            m_offset = header->prev_offset;
+            DEBUG_ONLY(m_last_allocation = header->prev_allocation;)
+        }
+
+        forceinline void Reset() noexcept override
+        {
+            m_offset = 0;
+            DEBUG_ONLY(m_last_allocation = nullptr;)
+        }
+
+    public:
+        [[nodiscard]] forceinline Marker GetMarker() const noexcept
+        {
+            return Marker{m_offset DEBUG_ONLY(, m_last_allocation)};
+        }
+
+        forceinline void Rewind(const Marker &marker) noexcept
+        {
+            ASSERT_MSG(marker.offset <= m_offset, "Stack allocator: rewind to a released marker.");
+
+            m_offset = marker.offset;
+            DEBUG_ONLY(m_last_allocation = marker.last_allocation;)
+        }
+
+        [[nodiscard]] forceinline ScopeGuard Scope() noexcept
         {
-            ASSERT(m_allocations.size() > 0);
-            m_ptr = m_allocations.back();
-            m_allocations.pop_back();
+            return ScopeGuard{*this};
         }
 
-        void Reset() noexcept override
+        [[nodiscard]] forceinline usize_t GetUsedSize() const noexcept
         {
-            m_allocations.clear();
-            m_ptr = m_begin;
+            return m_offset;
         }
 
     private:
-        byte_t *m_ptr{nullptr};
-        Array<byte_t *> m_allocations;
+        usize_t m_offset{0};
+        DEBUG_ONLY(byte_t *m_last_allocation{nullptr};)
 
     private:
         byte_t *const m_begin{nullptr};
         byte_t *const m_end{nullptr};
     };
 
-}
\ No newline at end of file
+}
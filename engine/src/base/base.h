@@ -45,6 +45,7 @@
 #include "base/memory/memory.h"
 #include "base/allocators/allocators.h"
 #include "base/containers/containers.h"
+#include "base/algorithms/algorithms.h"
 #include "base/devices/device.h"
 #include "base/window/window.h"
 #include "base/io/io.h"
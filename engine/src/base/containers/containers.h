@@ -1,4 +1,10 @@
 #pragma once
 
 #include "base/containers/fixed_queue.h"
-#include "base/containers/virtual_mem_container.h"
\ No newline at end of file
+#include "base/containers/virtual_mem_container.h"
+#include "base/containers/flat_hash_map.h"
+#include "base/containers/slot_map.h"
+#include "base/containers/soa_array.h"
+#include "base/containers/ring_buffer.h"
+#include "base/containers/small_array.h"
+#include "base/containers/static_map.h"
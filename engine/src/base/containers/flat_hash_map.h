@@ -0,0 +1,930 @@
+#pragma once
+
+namespace Be
+{
+
+    namespace details
+    {
+        // Control byte of a slot: empty, deleted or the low 7 bits of the hash of a full slot.
+        using FlatHashCtrl = int8_t;
+
+        inline constexpr FlatHashCtrl FlatHashEmpty = -128;
+        inline constexpr FlatHashCtrl FlatHashDeleted = -2;
+        inline constexpr usize_t FlatHashGroupWidth = 16;
+
+        // Control bytes of a table without storage, so lookups never have to check for it.
+        alignas(FlatHashGroupWidth) inline constexpr FlatHashCtrl FlatHashEmptyGroup[FlatHashGroupWidth] = {
+            FlatHashEmpty, FlatHashEmpty, FlatHashEmpty, FlatHashEmpty,
+            FlatHashEmpty, FlatHashEmpty, FlatHashEmpty, FlatHashEmpty,
+            FlatHashEmpty, FlatHashEmpty, FlatHashEmpty, FlatHashEmpty,
+            FlatHashEmpty, FlatHashEmpty, FlatHashEmpty, FlatHashEmpty};
+
+        // Engine hashes are often identities (integers, named handles), so the bits are
+        // spread before they are split into the probe start (h1) and the control byte (h2).
+        [[nodiscard]] forceinline constexpr uint64_t FlatHashMix(uint64_t hash) noexcept
+        {
+            hash ^= hash >> 33;
+            hash *= 0xff51afd7ed558ccdull;
+            hash ^= hash >> 33;
+            return hash;
+        }
+
+        // Sixteen control bytes matched at once. Bit i of a mask refers to the i-th byte.
+        // Without SSE2 the group is matched as two 64-bit words.
+        class FlatHashGroup final
+        {
+        public:
+            explicit forceinline FlatHashGroup(const FlatHashCtrl *ctrl) noexcept
+#if defined(BE_SIMD_SSE2)
+                : m_ctrl{_mm_loadu_si128(reinterpret_cast<const __m128i *>(ctrl))}
+#endif
+            {
+#if !defined(BE_SIMD_SSE2)
+                std::memcpy(m_ctrl, ctrl, sizeof(m_ctrl));
+#endif
+            }
+
+        public:
+            // May report false positives, which are filtered out by the key comparison.
+            [[nodiscard]] forceinline uint32_t Match(FlatHashCtrl h2) const noexcept
+            {
+#if defined(BE_SIMD_SSE2)
+                return uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(m_ctrl, _mm_set1_epi8(h2))));
+#else
+                const auto pattern = LSB * uint8_t(h2);
+                return MatchWords([pattern](uint64_t word)
+                                  {
+                                      const auto x = word ^ pattern;
+                                      return (x - LSB) & ~x & MSB; });
+#endif
+            }
+
+            [[nodiscard]] forceinline uint32_t MatchEmpty() const noexcept
+            {
+#if defined(BE_SIMD_SSE2)
+                return uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(m_ctrl, _mm_set1_epi8(FlatHashEmpty))));
+#else
+                // Empty is the only control byte with the sign bit set and bit 1 cleared.
+                return MatchWords([](uint64_t word)
+                                  { return word & (~word << 6) & MSB; });
+#endif
+            }
+
+            // Full slots are the only ones with the sign bit cleared.
+            [[nodiscard]] forceinline uint32_t MatchEmptyOrDeleted() const noexcept
+            {
+#if defined(BE_SIMD_SSE2)
+                return uint32_t(_mm_movemask_epi8(m_ctrl));
+#else
+                return MatchWords([](uint64_t word)
+                                  { return word & MSB; });
+#endif
+            }
+
+        private:
+#if defined(BE_SIMD_SSE2)
+            __m128i m_ctrl;
+#else
+            static constexpr uint64_t LSB = 0x0101010101010101ull;
+            static constexpr uint64_t MSB = 0x8080808080808080ull;
+
+            // Packs the per-byte sign bits produced by pred into a bit per byte.
+            [[nodiscard]] forceinline uint32_t MatchWords(auto &&pred) const noexcept
+            {
+                const auto pack = [](uint64_t bits)
+                { return uint32_t(((bits >> 7) * 0x0102040810204080ull) >> 56); };
+
+                return pack(pred(m_ctrl[0])) | (pack(pred(m_ctrl[1])) << 8);
+            }
+
+            uint64_t m_ctrl[2];
+#endif
+        };
+
+        template <typename K, typename V>
+        struct FlatHashMapPolicy
+        {
+            using key_type = K;
+            using mapped_type = V;
+            using value_type = Pair<K, V>;
+
+            [[nodiscard]] static forceinline const K &GetKey(const value_type &value) noexcept
+            {
+                return value.first;
+            }
+        };
+
+        template <typename K>
+        struct FlatHashSetPolicy
+        {
+            using key_type = K;
+            using value_type = K;
+
+            [[nodiscard]] static forceinline const K &GetKey(const value_type &value) noexcept
+            {
+                return value;
+            }
+        };
+
+        // Open addressing table with SwissTable style metadata: one control byte per slot,
+        // probed a group at a time. Slots are stored inline, so references are invalidated
+        // by rehashing, and keys must not be modified through iterators.
+        template <typename Policy, typename Hash, typename Eq, typename Alloc>
+        class FlatHashTable
+        {
+        public:
+            using key_type = typename Policy::key_type;
+            using value_type = typename Policy::value_type;
+            using size_type = usize_t;
+            using hasher = Hash;
+            using key_equal = Eq;
+            using allocator_type = Alloc;
+
+        private:
+            using AllocTraits = std::allocator_traits<Alloc>;
+            using CtrlAllocator = typename AllocTraits::template rebind_alloc<FlatHashCtrl>;
+            using SlotAllocator = typename AllocTraits::template rebind_alloc<value_type>;
+
+        protected:
+            // Heterogeneous lookup is enabled when both functors opt in, as in the std containers.
+            static constexpr bool IsTransparent = requires {
+                typename Hash::is_transparent;
+                typename Eq::is_transparent;
+            };
+
+        protected:
+            template <bool CONST>
+            class Iterator final
+            {
+                friend class FlatHashTable;
+
+            public:
+                using iterator_category = std::forward_iterator_tag;
+                using value_type = typename Policy::value_type;
+                using difference_type = ptrdiff_t;
+                using reference = std::conditional_t<CONST, const value_type &, value_type &>;
+                using pointer = std::conditional_t<CONST, const value_type *, value_type *>;
+
+            public:
+                Iterator() noexcept = default;
+                Iterator(const Iterator &) noexcept = default;
+                Iterator &operator=(const Iterator &) noexcept = default;
+
+                forceinline Iterator(const Iterator<false> &other) noexcept
+                    requires CONST
+                    : m_ctrl{other.m_ctrl},
+                      m_end{other.m_end},
+                      m_slot{other.m_slot}
+                {
+                }
+
+            public:
+                [[nodiscard]] forceinline reference operator*() const noexcept
+                {
+                    return *m_slot;
+                }
+
+                [[nodiscard]] forceinline pointer operator->() const noexcept
+                {
+                    return m_slot;
+                }
+
+                forceinline Iterator &operator++() noexcept
+                {
+                    ++m_ctrl;
+                    ++m_slot;
+                    SkipEmpty();
+                    return *this;
+                }
+
+                forceinline Iterator operator++(int) noexcept
+                {
+                    auto tmp = *this;
+                    ++(*this);
+                    return tmp;
+                }
+
+                [[nodiscard]] forceinline bool operator==(const Iterator &other) const noexcept
+                {
+                    return m_ctrl == other.m_ctrl;
+                }
+
+            private:
+                forceinline Iterator(const FlatHashCtrl *ctrl, const FlatHashCtrl *end, pointer slot) noexcept
+                    : m_ctrl{ctrl},
+                      m_end{end},
+                      m_slot{slot}
+                {
+                }
+
+                forceinline void SkipEmpty() noexcept
+                {
+                    while (m_ctrl != m_end && *m_ctrl < 0)
+                    {
+                        ++m_ctrl;
+                        ++m_slot;
+                    }
+                }
+
+            private:
+                template <bool>
+                friend class Iterator;
+
+                const FlatHashCtrl *m_ctrl{nullptr};
+                const FlatHashCtrl *m_end{nullptr};
+                pointer m_slot{nullptr};
+            };
+
+        public:
+            using iterator = Iterator<false>;
+            using const_iterator = Iterator<true>;
+
+        public:
+            FlatHashTable() noexcept = default;
+
+            explicit FlatHashTable(const allocator_type &alloc) noexcept
+                : m_alloc{alloc}
+            {
+            }
+
+            explicit FlatHashTable(usize_t capacity, const allocator_type &alloc = allocator_type{})
+                : m_alloc{alloc}
+            {
+                reserve(capacity);
+            }
+
+            FlatHashTable(std::initializer_list<value_type> values, const allocator_type &alloc = allocator_type{})
+                : m_alloc{alloc}
+            {
+                reserve(values.size());
+                for (const auto &value : values)
+                {
+                    insert(value);
+                }
+            }
+
+            FlatHashTable(const FlatHashTable &other)
+                : m_alloc{AllocTraits::select_on_container_copy_construction(other.m_alloc)},
+                  m_hash{other.m_hash},
+                  m_eq{other.m_eq}
+            {
+                CopyFrom(other);
+            }
+
+            FlatHashTable(FlatHashTable &&other) noexcept
+                : m_alloc{std::move(other.m_alloc)},
+                  m_hash{std::move(other.m_hash)},
+                  m_eq{std::move(other.m_eq)}
+            {
+                StealFrom(other);
+            }
+
+            ~FlatHashTable() noexcept
+            {
+                DestroySlots();
+                Deallocate();
+            }
+
+        public:
+            FlatHashTable &operator=(const FlatHashTable &other)
+            {
+                if (this != &other)
+                {
+                    clear();
+                    m_hash = other.m_hash;
+                    m_eq = other.m_eq;
+                    CopyFrom(other);
+                }
+                return *this;
+            }
+
+            FlatHashTable &operator=(FlatHashTable &&other) noexcept
+            {
+                if (this == &other)
+                {
+                    return *this;
+                }
+
+                DestroySlots();
+                m_hash = std::move(other.m_hash);
+                m_eq = std::move(other.m_eq);
+
+                if (AllocTraits::propagate_on_container_move_assignment::value || m_alloc == other.m_alloc)
+                {
+                    Deallocate();
+                    if constexpr (AllocTraits::propagate_on_container_move_assignment::value)
+                    {
+                        m_alloc = std::move(other.m_alloc);
+                    }
+                    StealFrom(other);
+                }
+                else
+                {
+                    // Storage of another resource cannot be adopted, so the elements are moved one by one.
+                    ResetCtrl();
+                    reserve(other.m_size);
+                    for (auto &value : other)
+                    {
+                        InsertUnique(FlatHashMix(uint64_t(m_hash(Policy::GetKey(value)))), std::move(value));
+                    }
+                    other.clear();
+                }
+
+                return *this;
+            }
+
+        public:
+            [[nodiscard]] forceinline iterator begin() noexcept
+            {
+                iterator it{m_ctrl, m_ctrl + m_capacity, m_slots};
+                it.SkipEmpty();
+                return it;
+            }
+
+            [[nodiscard]] forceinline const_iterator begin() const noexcept
+            {
+                const_iterator it{m_ctrl, m_ctrl + m_capacity, m_slots};
+                it.SkipEmpty();
+                return it;
+            }
+
+            [[nodiscard]] forceinline iterator end() noexcept
+            {
+                return {m_ctrl + m_capacity, m_ctrl + m_capacity, m_slots + m_capacity};
+            }
+
+            [[nodiscard]] forceinline const_iterator end() const noexcept
+            {
+                return {m_ctrl + m_capacity, m_ctrl + m_capacity, m_slots + m_capacity};
+            }
+
+            [[nodiscard]] forceinline const_iterator cbegin() const noexcept
+            {
+                return begin();
+            }
+
+            [[nodiscard]] forceinline const_iterator cend() const noexcept
+            {
+                return end();
+            }
+
+        public:
+            [[nodiscard]] forceinline usize_t size() const noexcept
+            {
+                return m_size;
+            }
+
+            [[nodiscard]] forceinline bool empty() const noexcept
+            {
+                return m_size == 0;
+            }
+
+            [[nodiscard]] forceinline usize_t capacity() const noexcept
+            {
+                return m_capacity;
+            }
+
+            [[nodiscard]] forceinline float load_factor() const noexcept
+            {
+                return m_capacity == 0 ? 0.0f : float(m_size) / float(m_capacity);
+            }
+
+            [[nodiscard]] forceinline allocator_type get_allocator() const noexcept
+            {
+                return m_alloc;
+            }
+
+            // Keeps the storage, so a table that is refilled every frame does not reallocate.
+            void clear() noexcept
+            {
+                DestroySlots();
+                ResetCtrl();
+            }
+
+            void reserve(usize_t count)
+            {
+                if (count <= GrowthCapacity(m_capacity))
+                {
+                    return;
+                }
+
+                auto capacity = std::bit_ceil(std::max(count, FlatHashGroupWidth));
+                while (GrowthCapacity(capacity) < count)
+                {
+                    capacity *= 2;
+                }
+                Resize(capacity);
+            }
+
+            void swap(FlatHashTable &other) noexcept
+            {
+                using std::swap;
+                if constexpr (AllocTraits::propagate_on_container_swap::value)
+                {
+                    swap(m_alloc, other.m_alloc);
+                }
+                swap(m_hash, other.m_hash);
+                swap(m_eq, other.m_eq);
+                swap(m_ctrl, other.m_ctrl);
+                swap(m_slots, other.m_slots);
+                swap(m_capacity, other.m_capacity);
+                swap(m_size, other.m_size);
+                swap(m_growth_left, other.m_growth_left);
+            }
+
+        public:
+            [[nodiscard]] forceinline iterator find(const key_type &key) noexcept
+            {
+                return MakeIterator(Find(key));
+            }
+
+            [[nodiscard]] forceinline const_iterator find(const key_type &key) const noexcept
+            {
+                return MakeIterator(Find(key));
+            }
+
+            template <typename K>
+                requires IsTransparent
+            [[nodiscard]] forceinline iterator find(const K &key) noexcept
+            {
+                return MakeIterator(Find(key));
+            }
+
+            template <typename K>
+                requires IsTransparent
+            [[nodiscard]] forceinline const_iterator find(const K &key) const noexcept
+            {
+                return MakeIterator(Find(key));
+            }
+
+            [[nodiscard]] forceinline bool contains(const key_type &key) const noexcept
+            {
+                return Find(key) != m_capacity;
+            }
+
+            template <typename K>
+                requires IsTransparent
+            [[nodiscard]] forceinline bool contains(const K &key) const noexcept
+            {
+                return Find(key) != m_capacity;
+            }
+
+            [[nodiscard]] forceinline usize_t count(const key_type &key) const noexcept
+            {
+                return contains(key) ? 1 : 0;
+            }
+
+        public:
+            forceinline Pair<iterator, bool> insert(const value_type &value)
+            {
+                return EmplaceKey(Policy::GetKey(value), value);
+            }
+
+            forceinline Pair<iterator, bool> insert(value_type &&value)
+            {
+                const auto &key = Policy::GetKey(value);
+                return EmplaceKey(key, std::move(value));
+            }
+
+            template <typename InputIt>
+            void insert(InputIt first, InputIt last)
+            {
+                for (; first != last; ++first)
+                {
+                    insert(*first);
+                }
+            }
+
+            template <typename... Args>
+            Pair<iterator, bool> emplace(Args &&...args)
+            {
+                value_type value(std::forward<Args>(args)...);
+                const auto &key = Policy::GetKey(value);
+                return EmplaceKey(key, std::move(value));
+            }
+
+        public:
+            forceinline usize_t erase(const key_type &key) noexcept
+            {
+                return EraseKey(key);
+            }
+
+            template <typename K>
+                requires IsTransparent
+            forceinline usize_t erase(const K &key) noexcept
+            {
+                return EraseKey(key);
+            }
+
+            // Erasing does not move other elements, so only the erased iterator is invalidated.
+            forceinline iterator erase(const_iterator pos) noexcept
+            {
+                const auto index = usize_t(pos.m_ctrl - m_ctrl);
+                EraseAt(index);
+
+                iterator it{m_ctrl + index, m_ctrl + m_capacity, m_slots + index};
+                it.SkipEmpty();
+                return it;
+            }
+
+            forceinline iterator erase(iterator pos) noexcept
+            {
+                return erase(const_iterator{pos});
+            }
+
+        protected:
+            template <typename K>
+            [[nodiscard]] usize_t Find(const K &key) const noexcept
+            {
+                const auto hash = FlatHashMix(uint64_t(m_hash(key)));
+                const auto h2 = FlatHashCtrl(hash & 0x7F);
+
+                auto pos = usize_t(hash >> 7) & Mask();
+                for (usize_t step = FlatHashGroupWidth;; step += FlatHashGroupWidth)
+                {
+                    const FlatHashGroup group{m_ctrl + pos};
+                    for (auto match = group.Match(h2); match != 0; match &= match - 1)
+                    {
+                        const auto index = (pos + CountRightZero(match)) & Mask();
+                        if (m_eq(Policy::GetKey(m_slots[index]), key)) [[likely]]
+                        {
+                            return index;
+                        }
+                    }
+
+                    if (group.MatchEmpty() != 0) [[likely]]
+                    {
+                        return m_capacity;
+                    }
+
+                    pos = (pos + step) & Mask();
+                }
+            }
+
+            // Returns the slot of the key, constructing the element from args if it is missing.
+            template <typename K, typename... Args>
+            Pair<usize_t, bool> FindOrEmplace(const K &key, Args &&...args)
+            {
+                const auto hash = FlatHashMix(uint64_t(m_hash(key)));
+                const auto h2 = FlatHashCtrl(hash & 0x7F);
+
+                auto pos = usize_t(hash >> 7) & Mask();
+                for (usize_t step = FlatHashGroupWidth;; step += FlatHashGroupWidth)
+                {
+                    const FlatHashGroup group{m_ctrl + pos};
+                    for (auto match = group.Match(h2); match != 0; match &= match - 1)
+                    {
+                        const auto index = (pos + CountRightZero(match)) & Mask();
+                        if (m_eq(Policy::GetKey(m_slots[index]), key)) [[likely]]
+                        {
+                            return {index, false};
+                        }
+                    }
+
+                    if (group.MatchEmpty() != 0) [[likely]]
+                    {
+                        break;
+                    }
+
+                    pos = (pos + step) & Mask();
+                }
+
+                return {InsertUnique(hash, std::forward<Args>(args)...), true};
+            }
+
+            template <typename K, typename... Args>
+            forceinline Pair<iterator, bool> EmplaceKey(const K &key, Args &&...args)
+            {
+                const auto [index, inserted] = FindOrEmplace(key, std::forward<Args>(args)...);
+                return {MakeIterator(index), inserted};
+            }
+
+            [[nodiscard]] forceinline iterator MakeIterator(usize_t index) noexcept
+            {
+                return {m_ctrl + index, m_ctrl + m_capacity, m_slots + index};
+            }
+
+            [[nodiscard]] forceinline const_iterator MakeIterator(usize_t index) const noexcept
+            {
+                return {m_ctrl + index, m_ctrl + m_capacity, m_slots + index};
+            }
+
+            [[nodiscard]] forceinline value_type &SlotAt(usize_t index) noexcept
+            {
+                return m_slots[index];
+            }
+
+            [[nodiscard]] forceinline const value_type &SlotAt(usize_t index) const noexcept
+            {
+                return m_slots[index];
+            }
+
+        private:
+            [[nodiscard]] forceinline usize_t Mask() const noexcept
+            {
+                return m_capacity == 0 ? 0 : m_capacity - 1;
+            }
+
+            // Maximum load factor is 7/8.
+            [[nodiscard]] static forceinline usize_t GrowthCapacity(usize_t capacity) noexcept
+            {
+                return capacity - capacity / 8;
+            }
+
+            // The first group is mirrored past the end, so a group can be loaded at any slot.
+            forceinline void SetCtrl(usize_t index, FlatHashCtrl ctrl) noexcept
+            {
+                m_ctrl[index] = ctrl;
+                if (index < FlatHashGroupWidth)
+                {
+                    m_ctrl[m_capacity + index] = ctrl;
+                }
+            }
+
+            [[nodiscard]] usize_t FindFirstNonFull(uint64_t hash) const noexcept
+            {
+                auto pos = usize_t(hash >> 7) & Mask();
+                for (usize_t step = FlatHashGroupWidth;; step += FlatHashGroupWidth)
+                {
+                    const auto match = FlatHashGroup{m_ctrl + pos}.MatchEmptyOrDeleted();
+                    if (match != 0) [[likely]]
+                    {
+                        return (pos + CountRightZero(match)) & Mask();
+                    }
+                    pos = (pos + step) & Mask();
+                }
+            }
+
+            template <typename... Args>
+            usize_t InsertUnique(uint64_t hash, Args &&...args)
+            {
+                if (m_growth_left == 0) [[unlikely]]
+                {
+                    Grow();
+                }
+
+                // Constructed through the allocator, so scoped allocators reach the values.
+                const auto index = FindFirstNonFull(hash);
+                SlotAllocator slot_alloc{m_alloc};
+                std::allocator_traits<SlotAllocator>::construct(slot_alloc, m_slots + index, std::forward<Args>(args)...);
+
+                m_growth_left -= m_ctrl[index] == FlatHashEmpty ? 1 : 0;
+                SetCtrl(index, FlatHashCtrl(hash & 0x7F));
+                m_size++;
+
+                return index;
+            }
+
+            template <typename K>
+            usize_t EraseKey(const K &key) noexcept
+            {
+                const auto index = Find(key);
+                if (index == m_capacity)
+                {
+                    return 0;
+                }
+                EraseAt(index);
+                return 1;
+            }
+
+            void EraseAt(usize_t index) noexcept
+            {
+                std::destroy_at(m_slots + index);
+                m_size--;
+
+                // The slot can become empty again only if no probe sequence ever passed it,
+                // i.e. every group covering it already contains an empty slot.
+                const auto index_before = (index - FlatHashGroupWidth) & Mask();
+                const auto empty_after = FlatHashGroup{m_ctrl + index}.MatchEmpty();
+                const auto empty_before = FlatHashGroup{m_ctrl + index_before}.MatchEmpty();
+                const auto was_never_full = empty_before != 0 && empty_after != 0 &&
+                                            CountRightZero(empty_after) + (std::countl_zero(empty_before) - 16) < FlatHashGroupWidth;
+
+                SetCtrl(index, was_never_full ? FlatHashEmpty : FlatHashDeleted);
+                m_growth_left += was_never_full ? 1 : 0;
+            }
+
+            // Drops tombstones in place when they take most of the room, otherwise doubles.
+            void Grow()
+            {
+                if (m_capacity != 0 && m_size <= GrowthCapacity(m_capacity) / 2)
+                {
+                    Resize(m_capacity);
+                }
+                else
+                {
+                    Resize(m_capacity == 0 ? FlatHashGroupWidth : m_capacity * 2);
+                }
+            }
+
+            void Resize(usize_t capacity)
+            {
+                PROFILER_SCOPE;
+
+                ASSERT(std::has_single_bit(capacity) && capacity >= FlatHashGroupWidth);
+
+                auto old_ctrl = m_ctrl;
+                auto old_slots = m_slots;
+                const auto old_capacity = m_capacity;
+
+                CtrlAllocator ctrl_alloc{m_alloc};
+                SlotAllocator slot_alloc{m_alloc};
+                m_ctrl = std::allocator_traits<CtrlAllocator>::allocate(ctrl_alloc, capacity + FlatHashGroupWidth);
+                m_slots = std::allocator_traits<SlotAllocator>::allocate(slot_alloc, capacity);
+                m_capacity = capacity;
+
+                const auto size = m_size;
+                ResetCtrl();
+                m_size = size;
+
+                for (usize_t i = 0; i < old_capacity; i++)
+                {
+                    if (old_ctrl[i] >= 0)
+                    {
+                        auto &value = old_slots[i];
+                        const auto hash = FlatHashMix(uint64_t(m_hash(Policy::GetKey(value))));
+                        const auto index = FindFirstNonFull(hash);
+                        std::allocator_traits<SlotAllocator>::construct(slot_alloc, m_slots + index, std::move(value));
+                        std::destroy_at(&value);
+                        SetCtrl(index, FlatHashCtrl(hash & 0x7F));
+                    }
+                }
+                m_growth_left -= m_size;
+
+                if (old_capacity != 0)
+                {
+                    std::allocator_traits<CtrlAllocator>::deallocate(ctrl_alloc, old_ctrl, old_capacity + FlatHashGroupWidth);
+                    std::allocator_traits<SlotAllocator>::deallocate(slot_alloc, old_slots, old_capacity);
+                }
+            }
+
+            void ResetCtrl() noexcept
+            {
+                if (m_capacity != 0)
+                {
+                    std::memset(m_ctrl, FlatHashEmpty, m_capacity + FlatHashGroupWidth);
+                }
+                m_size = 0;
+                m_growth_left = GrowthCapacity(m_capacity);
+            }
+
+            void DestroySlots() noexcept
+            {
+                if constexpr (!std::is_trivially_destructible_v<value_type>)
+                {
+                    for (usize_t i = 0; i < m_capacity; i++)
+                    {
+                        if (m_ctrl[i] >= 0)
+                        {
+                            std::destroy_at(m_slots + i);
+                        }
+                    }
+                }
+            }
+
+            void Deallocate() noexcept
+            {
+                if (m_capacity != 0)
+                {
+                    CtrlAllocator ctrl_alloc{m_alloc};
+                    SlotAllocator slot_alloc{m_alloc};
+                    std::allocator_traits<CtrlAllocator>::deallocate(ctrl_alloc, m_ctrl, m_capacity + FlatHashGroupWidth);
+                    std::allocator_traits<SlotAllocator>::deallocate(slot_alloc, m_slots, m_capacity);
+                }
+                m_ctrl = const_cast<FlatHashCtrl *>(FlatHashEmptyGroup);
+                m_slots = nullptr;
+                m_capacity = 0;
+                m_size = 0;
+                m_growth_left = 0;
+            }
+
+            void CopyFrom(const FlatHashTable &other)
+            {
+                reserve(other.m_size);
+                for (usize_t i = 0; i < other.m_capacity; i++)
+                {
+                    if (other.m_ctrl[i] >= 0)
+                    {
+                        const auto &value = other.m_slots[i];
+                        InsertUnique(FlatHashMix(uint64_t(m_hash(Policy::GetKey(value)))), value);
+                    }
+                }
+            }
+
+            void StealFrom(FlatHashTable &other) noexcept
+            {
+                m_ctrl = std::exchange(other.m_ctrl, const_cast<FlatHashCtrl *>(FlatHashEmptyGroup));
+                m_slots = std::exchange(other.m_slots, nullptr);
+                m_capacity = std::exchange(other.m_capacity, 0);
+                m_size = std::exchange(other.m_size, 0);
+                m_growth_left = std::exchange(other.m_growth_left, 0);
+            }
+
+        private:
+            // The shared empty group is never written: a table without storage has no growth left.
+            FlatHashCtrl *m_ctrl{const_cast<FlatHashCtrl *>(FlatHashEmptyGroup)};
+            value_type *m_slots{nullptr};
+            usize_t m_capacity{0};
+            usize_t m_size{0};
+            usize_t m_growth_left{0};
+
+        private:
+            [[no_unique_address]] allocator_type m_alloc{};
+            [[no_unique_address]] hasher m_hash{};
+            [[no_unique_address]] key_equal m_eq{};
+        };
+    }
+
+    template <typename Key, typename T, typename Hash = std::hash<Key>, typename Eq = std::equal_to<Key>, typename Alloc = std::allocator<Pair<Key, T>>>
+    class FlatHashMap final : public details::FlatHashTable<details::FlatHashMapPolicy<Key, T>, Hash, Eq, Alloc>
+    {
+    private:
+        using Base = details::FlatHashTable<details::FlatHashMapPolicy<Key, T>, Hash, Eq, Alloc>;
+
+    public:
+        using mapped_type = T;
+        using typename Base::key_type;
+        using typename Base::iterator;
+        using typename Base::const_iterator;
+
+    public:
+        using Base::Base;
+
+    public:
+        template <typename... Args>
+        forceinline Pair<iterator, bool> try_emplace(const key_type &key, Args &&...args)
+        {
+            return Base::EmplaceKey(key, std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Args>(args)...));
+        }
+
+        template <typename... Args>
+        forceinline Pair<iterator, bool> try_emplace(key_type &&key, Args &&...args)
+        {
+            return Base::EmplaceKey(key, std::piecewise_construct, std::forward_as_tuple(std::move(key)), std::forward_as_tuple(std::forward<Args>(args)...));
+        }
+
+        template <typename V>
+        forceinline Pair<iterator, bool> insert_or_assign(const key_type &key, V &&value)
+        {
+            auto result = try_emplace(key, std::forward<V>(value));
+            if (!result.second)
+            {
+                result.first->second = std::forward<V>(value);
+            }
+            return result;
+        }
+
+        forceinline T &operator[](const key_type &key)
+        {
+            return try_emplace(key).first->second;
+        }
+
+        forceinline T &operator[](key_type &&key)
+        {
+            return try_emplace(std::move(key)).first->second;
+        }
+
+        [[nodiscard]] forceinline T &at(const key_type &key) noexcept
+        {
+            return AtImpl(key);
+        }
+
+        [[nodiscard]] forceinline const T &at(const key_type &key) const noexcept
+        {
+            return const_cast<FlatHashMap *>(this)->AtImpl(key);
+        }
+
+        template <typename K>
+            requires Base::IsTransparent
+        [[nodiscard]] forceinline const T &at(const K &key) const noexcept
+        {
+            return const_cast<FlatHashMap *>(this)->AtImpl(key);
+        }
+
+    private:
+        template <typename K>
+        [[nodiscard]] forceinline T &AtImpl(const K &key) noexcept
+        {
+            const auto index = Base::Find(key);
+            VERIFY(index != Base::capacity(), "Flat hash map: key not found.");
+            return Base::SlotAt(index).second;
+        }
+    };
+
+    template <typename Key, typename Hash = std::hash<Key>, typename Eq = std::equal_to<Key>, typename Alloc = std::allocator<Key>>
+    class FlatHashSet final : public details::FlatHashTable<details::FlatHashSetPolicy<Key>, Hash, Eq, Alloc>
+    {
+    private:
+        using Base = details::FlatHashTable<details::FlatHashSetPolicy<Key>, Hash, Eq, Alloc>;
+
+    public:
+        using Base::Base;
+    };
+
+    template <typename Key, typename T, typename Hash = std::hash<Key>, typename Eq = std::equal_to<Key>>
+    using PmrFlatHashMap = FlatHashMap<Key, T, Hash, Eq, PolymorphicAllocator<Pair<Key, T>>>;
+
+    template <typename Key, typename Hash = std::hash<Key>, typename Eq = std::equal_to<Key>>
+    using PmrFlatHashSet = FlatHashSet<Key, Hash, Eq, PolymorphicAllocator<Key>>;
+
+}
@@ -0,0 +1,303 @@
+#pragma once
+
+namespace Be
+{
+
+    namespace details
+    {
+        template <typename T>
+        struct RingBufferStorage
+        {
+            alignas(T) byte_t data[sizeof(T)];
+
+            [[nodiscard]] forceinline T *Get() noexcept
+            {
+                return std::launder(reinterpret_cast<T *>(data));
+            }
+        };
+    }
+
+    // Bounded single producer, single consumer queue. Both sides are wait-free: each
+    // one owns its index and caches the index of the other side to avoid touching
+    // its cache line on every call.
+    template <typename T, usize_t CAPACITY>
+    class SpscRingBuffer final : public Noncopyable
+    {
+        STATIC_ASSERT(std::has_single_bit(CAPACITY), "Ring buffer capacity must be a power of two.");
+
+    private:
+        static constexpr usize_t Mask = CAPACITY - 1;
+
+    public:
+        SpscRingBuffer() noexcept = default;
+
+        ~SpscRingBuffer() noexcept
+        {
+            T value;
+            while (TryPop(value))
+            {
+            }
+        }
+
+    public:
+        template <typename... Args>
+        [[nodiscard]] bool TryEmplace(Args &&...args) noexcept
+        {
+            const auto tail = m_producer.index.load(std::memory_order_relaxed);
+            if (tail - m_producer.cached_index == CAPACITY)
+            {
+                m_producer.cached_index = m_consumer.index.load(std::memory_order_acquire);
+                if (tail - m_producer.cached_index == CAPACITY)
+                {
+                    return false;
+                }
+            }
+
+            std::construct_at(m_slots[tail & Mask].Get(), std::forward<Args>(args)...);
+            m_producer.index.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        [[nodiscard]] forceinline bool TryPush(const T &value) noexcept
+        {
+            return TryEmplace(value);
+        }
+
+        [[nodiscard]] forceinline bool TryPush(T &&value) noexcept
+        {
+            return TryEmplace(std::move(value));
+        }
+
+        [[nodiscard]] bool TryPop(T &value) noexcept
+        {
+            return PopBatch(Span<T>{&value, 1}) == 1;
+        }
+
+        // Moves as many values as fit and publishes them at once. Returns the number pushed.
+        [[nodiscard]] usize_t PushBatch(Span<T> values) noexcept
+        {
+            const auto tail = m_producer.index.load(std::memory_order_relaxed);
+            auto free = CAPACITY - (tail - m_producer.cached_index);
+            if (free < values.size())
+            {
+                m_producer.cached_index = m_consumer.index.load(std::memory_order_acquire);
+                free = CAPACITY - (tail - m_producer.cached_index);
+            }
+
+            const auto count = std::min(free, values.size());
+            for (usize_t i = 0; i < count; i++)
+            {
+                std::construct_at(m_slots[(tail + i) & Mask].Get(), std::move(values[i]));
+            }
+            m_producer.index.store(tail + count, std::memory_order_release);
+            return count;
+        }
+
+        // Pops up to values.size() values. Returns the number popped.
+        [[nodiscard]] usize_t PopBatch(Span<T> values) noexcept
+        {
+            const auto head = m_consumer.index.load(std::memory_order_relaxed);
+            auto available = m_consumer.cached_index - head;
+            if (available < values.size())
+            {
+                m_consumer.cached_index = m_producer.index.load(std::memory_order_acquire);
+                available = m_consumer.cached_index - head;
+            }
+
+            const auto count = std::min(available, values.size());
+            for (usize_t i = 0; i < count; i++)
+            {
+                auto ptr = m_slots[(head + i) & Mask].Get();
+                values[i] = std::move(*ptr);
+                std::destroy_at(ptr);
+            }
+            m_consumer.index.store(head + count, std::memory_order_release);
+            return count;
+        }
+
+    public:
+        // Exact only when called from the producer or the consumer thread with the other side idle.
+        [[nodiscard]] forceinline usize_t Size() const noexcept
+        {
+            return m_producer.index.load(std::memory_order_acquire) - m_consumer.index.load(std::memory_order_acquire);
+        }
+
+        [[nodiscard]] forceinline bool Empty() const noexcept
+        {
+            return Size() == 0;
+        }
+
+        [[nodiscard]] static constexpr usize_t Capacity() noexcept
+        {
+            return CAPACITY;
+        }
+
+    private:
+        struct alignas(BE_CACHE_LINE) Side
+        {
+            Atomic<usize_t> index{0};
+            usize_t cached_index{0};
+        };
+
+        Side m_producer;
+        Side m_consumer;
+        details::RingBufferStorage<T> m_slots[CAPACITY];
+    };
+
+    // Bounded multi producer, multi consumer queue (Dmitry Vyukov's design). Every cell
+    // carries a sequence number telling whether it is ready for the producer or the
+    // consumer of a given position, so a push or a pop costs one CAS on its index.
+    template <typename T, usize_t CAPACITY>
+    class MpmcRingBuffer final : public Noncopyable
+    {
+        STATIC_ASSERT(std::has_single_bit(CAPACITY), "Ring buffer capacity must be a power of two.");
+
+    private:
+        static constexpr usize_t Mask = CAPACITY - 1;
+
+    public:
+        MpmcRingBuffer() noexcept
+        {
+            for (usize_t i = 0; i < CAPACITY; i++)
+            {
+                m_cells[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        ~MpmcRingBuffer() noexcept
+        {
+            T value;
+            while (TryPop(value))
+            {
+            }
+        }
+
+    public:
+        template <typename... Args>
+        [[nodiscard]] bool TryEmplace(Args &&...args) noexcept
+        {
+            auto pos = m_enqueue_index.value.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                auto &cell = m_cells[pos & Mask];
+                const auto sequence = cell.sequence.load(std::memory_order_acquire);
+                const auto diff = intptr_t(sequence) - intptr_t(pos);
+                if (diff == 0)
+                {
+                    if (m_enqueue_index.value.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        std::construct_at(cell.storage.Get(), std::forward<Args>(args)...);
+                        cell.sequence.store(pos + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (diff < 0)
+                {
+                    return false;
+                }
+                else
+                {
+                    pos = m_enqueue_index.value.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        [[nodiscard]] forceinline bool TryPush(const T &value) noexcept
+        {
+            return TryEmplace(value);
+        }
+
+        [[nodiscard]] forceinline bool TryPush(T &&value) noexcept
+        {
+            return TryEmplace(std::move(value));
+        }
+
+        [[nodiscard]] bool TryPop(T &value) noexcept
+        {
+            auto pos = m_dequeue_index.value.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                auto &cell = m_cells[pos & Mask];
+                const auto sequence = cell.sequence.load(std::memory_order_acquire);
+                const auto diff = intptr_t(sequence) - intptr_t(pos + 1);
+                if (diff == 0)
+                {
+                    if (m_dequeue_index.value.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        auto ptr = cell.storage.Get();
+                        value = std::move(*ptr);
+                        std::destroy_at(ptr);
+                        cell.sequence.store(pos + CAPACITY, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (diff < 0)
+                {
+                    return false;
+                }
+                else
+                {
+                    pos = m_dequeue_index.value.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        // Positions are claimed one at a time: a range claim would have to wait for slower
+        // producers or consumers of the cells inside it, which is no longer lock-free.
+        [[nodiscard]] usize_t PushBatch(Span<T> values) noexcept
+        {
+            usize_t count{0};
+            while (count < values.size() && TryPush(std::move(values[count])))
+            {
+                count++;
+            }
+            return count;
+        }
+
+        [[nodiscard]] usize_t PopBatch(Span<T> values) noexcept
+        {
+            usize_t count{0};
+            while (count < values.size() && TryPop(values[count]))
+            {
+                count++;
+            }
+            return count;
+        }
+
+    public:
+        // Approximate while other threads push or pop.
+        [[nodiscard]] forceinline usize_t Size() const noexcept
+        {
+            const auto tail = m_enqueue_index.value.load(std::memory_order_acquire);
+            const auto head = m_dequeue_index.value.load(std::memory_order_acquire);
+            return tail > head ? tail - head : 0;
+        }
+
+        [[nodiscard]] forceinline bool Empty() const noexcept
+        {
+            return Size() == 0;
+        }
+
+        [[nodiscard]] static constexpr usize_t Capacity() noexcept
+        {
+            return CAPACITY;
+        }
+
+    private:
+        struct Cell
+        {
+            Atomic<usize_t> sequence;
+            details::RingBufferStorage<T> storage;
+        };
+
+        struct alignas(BE_CACHE_LINE) Index
+        {
+            Atomic<usize_t> value{0};
+        };
+
+        Index m_enqueue_index;
+        Index m_dequeue_index;
+        alignas(BE_CACHE_LINE) Cell m_cells[CAPACITY];
+    };
+
+}
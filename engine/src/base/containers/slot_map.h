@@ -0,0 +1,285 @@
+#pragma once
+
+namespace Be
+{
+
+    // Index of a slot plus the generation the slot had when the handle was issued.
+    // Generation 0 is never issued, so a default constructed handle is null.
+    template <typename T>
+    struct SlotHandle
+    {
+        uint32_t index{0};
+        uint32_t generation{0};
+
+        [[nodiscard]] constexpr bool IsValid() const noexcept
+        {
+            return generation != 0;
+        }
+
+        [[nodiscard]] constexpr explicit operator bool() const noexcept
+        {
+            return IsValid();
+        }
+
+        [[nodiscard]] constexpr bool operator==(const SlotHandle &) const noexcept = default;
+    };
+
+    // Values are stored densely and moved on erase (swap with the last one), so bulk
+    // passes iterate a plain array. Handles stay valid until their value is erased;
+    // a stale handle is detected by the generation check. With REF_COUNTED the value
+    // is erased when the last reference is released.
+    template <typename T, bool REF_COUNTED = false>
+    class SlotMap final
+    {
+    public:
+        using Handle = SlotHandle<T>;
+        using iterator = typename Array<T>::iterator;
+        using const_iterator = typename Array<T>::const_iterator;
+
+    private:
+        static constexpr uint32_t InvalidIndex = UMax;
+
+        // For a live slot index points to the value, for a free one to the next free slot.
+        struct Slot
+        {
+            uint32_t index;
+            uint32_t generation;
+        };
+
+        struct RefCountedSlot : Slot
+        {
+            uint32_t ref_count;
+        };
+
+        using SlotType = std::conditional_t<REF_COUNTED, RefCountedSlot, Slot>;
+
+    public:
+        SlotMap() noexcept = default;
+
+        explicit SlotMap(usize_t capacity)
+        {
+            reserve(capacity);
+        }
+
+    public:
+        template <typename... Args>
+        Handle Emplace(Args &&...args)
+        {
+            const auto dense_index = uint32_t(m_values.size());
+            m_values.emplace_back(std::forward<Args>(args)...);
+
+            uint32_t slot_index{m_free_head};
+            if (slot_index == InvalidIndex)
+            {
+                VERIFY(m_slots.size() < InvalidIndex, "Slot map is full.");
+                slot_index = uint32_t(m_slots.size());
+                m_slots.push_back(SlotType{});
+                m_slots.back().generation = 1;
+            }
+            else
+            {
+                m_free_head = m_slots[slot_index].index;
+            }
+
+            auto &slot = m_slots[slot_index];
+            slot.index = dense_index;
+            if constexpr (REF_COUNTED)
+            {
+                slot.ref_count = 1;
+            }
+            m_dense_to_slot.push_back(slot_index);
+
+            return {slot_index, slot.generation};
+        }
+
+        forceinline Handle Insert(const T &value)
+        {
+            return Emplace(value);
+        }
+
+        forceinline Handle Insert(T &&value)
+        {
+            return Emplace(std::move(value));
+        }
+
+        // Returns false for a stale handle.
+        bool Erase(Handle handle) noexcept
+        {
+            if (!Contains(handle))
+            {
+                return false;
+            }
+
+            auto &slot = m_slots[handle.index];
+            const auto dense_index = slot.index;
+            const auto last_index = uint32_t(m_values.size() - 1);
+            if (dense_index != last_index)
+            {
+                m_values[dense_index] = std::move(m_values[last_index]);
+                m_dense_to_slot[dense_index] = m_dense_to_slot[last_index];
+                m_slots[m_dense_to_slot[dense_index]].index = dense_index;
+            }
+            m_values.pop_back();
+            m_dense_to_slot.pop_back();
+
+            ReleaseSlot(handle.index);
+
+            return true;
+        }
+
+        void clear() noexcept
+        {
+            for (const auto slot_index : m_dense_to_slot)
+            {
+                ReleaseSlot(slot_index);
+            }
+            m_values.clear();
+            m_dense_to_slot.clear();
+        }
+
+    public:
+        [[nodiscard]] forceinline bool Contains(Handle handle) const noexcept
+        {
+            return handle.index < m_slots.size() && m_slots[handle.index].generation == handle.generation;
+        }
+
+        [[nodiscard]] forceinline T *Get(Handle handle) noexcept
+        {
+            return Contains(handle) ? &m_values[m_slots[handle.index].index] : nullptr;
+        }
+
+        [[nodiscard]] forceinline const T *Get(Handle handle) const noexcept
+        {
+            return Contains(handle) ? &m_values[m_slots[handle.index].index] : nullptr;
+        }
+
+        [[nodiscard]] forceinline T &operator[](Handle handle) noexcept
+        {
+            ASSERT_MSG(Contains(handle), "Slot map: stale handle.");
+            return m_values[m_slots[handle.index].index];
+        }
+
+        [[nodiscard]] forceinline const T &operator[](Handle handle) const noexcept
+        {
+            ASSERT_MSG(Contains(handle), "Slot map: stale handle.");
+            return m_values[m_slots[handle.index].index];
+        }
+
+    public:
+        forceinline void AddRef(Handle handle) noexcept
+            requires REF_COUNTED
+        {
+            ASSERT_MSG(Contains(handle), "Slot map: stale handle.");
+            m_slots[handle.index].ref_count++;
+        }
+
+        // Returns true when the last reference was released and the value erased.
+        forceinline bool Release(Handle handle) noexcept
+            requires REF_COUNTED
+        {
+            ASSERT_MSG(Contains(handle), "Slot map: stale handle.");
+            if (--m_slots[handle.index].ref_count != 0)
+            {
+                return false;
+            }
+            return Erase(handle);
+        }
+
+        [[nodiscard]] forceinline uint32_t GetRefCount(Handle handle) const noexcept
+            requires REF_COUNTED
+        {
+            return Contains(handle) ? m_slots[handle.index].ref_count : 0;
+        }
+
+    public:
+        // Bulk access in dense order. The order changes when values are erased.
+        [[nodiscard]] forceinline Span<T> GetValues() noexcept
+        {
+            return m_values;
+        }
+
+        [[nodiscard]] forceinline Span<const T> GetValues() const noexcept
+        {
+            return m_values;
+        }
+
+        [[nodiscard]] forceinline Handle GetHandle(usize_t dense_index) const noexcept
+        {
+            const auto slot_index = m_dense_to_slot[dense_index];
+            return {slot_index, m_slots[slot_index].generation};
+        }
+
+        template <typename F>
+        forceinline void ForEach(F &&func)
+        {
+            for (usize_t i = 0; i < m_values.size(); i++)
+            {
+                func(GetHandle(i), m_values[i]);
+            }
+        }
+
+    public:
+        [[nodiscard]] forceinline iterator begin() noexcept
+        {
+            return m_values.begin();
+        }
+
+        [[nodiscard]] forceinline const_iterator begin() const noexcept
+        {
+            return m_values.begin();
+        }
+
+        [[nodiscard]] forceinline iterator end() noexcept
+        {
+            return m_values.end();
+        }
+
+        [[nodiscard]] forceinline const_iterator end() const noexcept
+        {
+            return m_values.end();
+        }
+
+        [[nodiscard]] forceinline usize_t size() const noexcept
+        {
+            return m_values.size();
+        }
+
+        [[nodiscard]] forceinline bool empty() const noexcept
+        {
+            return m_values.empty();
+        }
+
+        void reserve(usize_t capacity)
+        {
+            m_values.reserve(capacity);
+            m_dense_to_slot.reserve(capacity);
+            m_slots.reserve(capacity);
+        }
+
+    private:
+        forceinline void ReleaseSlot(uint32_t slot_index) noexcept
+        {
+            // Generation 0 is reserved for null handles.
+            auto &slot = m_slots[slot_index];
+            slot.generation = slot.generation == UMax ? 1 : slot.generation + 1;
+            slot.index = m_free_head;
+            m_free_head = slot_index;
+        }
+
+    private:
+        Array<T> m_values;
+        Array<uint32_t> m_dense_to_slot;
+        Array<SlotType> m_slots;
+        uint32_t m_free_head{InvalidIndex};
+    };
+
+}
+
+template <typename T>
+struct std::hash<Be::SlotHandle<T>>
+{
+    [[nodiscard]] size_t operator()(const Be::SlotHandle<T> &value) const noexcept
+    {
+        return size_t(value.index) | (size_t(value.generation) << 32);
+    }
+};
@@ -0,0 +1,347 @@
+#pragma once
+
+namespace Be
+{
+
+    // Array with room for N elements inside the object. Short lived arrays of the hot
+    // paths fit there and never touch the allocator; larger ones spill to it and keep
+    // working like Array.
+    template <typename T, usize_t N, typename Alloc = std::allocator<T>>
+    class SmallArray final
+    {
+        STATIC_ASSERT(N > 0, "Small array needs an inline capacity.");
+
+    private:
+        using AllocTraits = std::allocator_traits<Alloc>;
+
+    public:
+        using value_type = T;
+        using allocator_type = Alloc;
+        using size_type = usize_t;
+        using difference_type = ptrdiff_t;
+        using reference = T &;
+        using const_reference = const T &;
+        using pointer = T *;
+        using const_pointer = const T *;
+        using iterator = T *;
+        using const_iterator = const T *;
+
+        static constexpr usize_t InlineCapacity = N;
+
+    public:
+        SmallArray() noexcept = default;
+
+        explicit SmallArray(const Alloc &alloc) noexcept
+            : m_alloc{alloc}
+        {
+        }
+
+        explicit SmallArray(usize_t size, const Alloc &alloc = {})
+            : m_alloc{alloc}
+        {
+            resize(size);
+        }
+
+        SmallArray(usize_t size, const T &value, const Alloc &alloc = {})
+            : m_alloc{alloc}
+        {
+            resize(size, value);
+        }
+
+        SmallArray(std::initializer_list<T> values, const Alloc &alloc = {})
+            : m_alloc{alloc}
+        {
+            assign(values.begin(), values.end());
+        }
+
+        SmallArray(const SmallArray &other)
+            : m_alloc{AllocTraits::select_on_container_copy_construction(other.m_alloc)}
+        {
+            assign(other.begin(), other.end());
+        }
+
+        SmallArray(SmallArray &&other) noexcept
+            : m_alloc{other.m_alloc}
+        {
+            MoveFrom(other);
+        }
+
+        ~SmallArray() noexcept
+        {
+            clear();
+            Deallocate();
+        }
+
+    public:
+        SmallArray &operator=(const SmallArray &other)
+        {
+            if (this != &other)
+            {
+                assign(other.begin(), other.end());
+            }
+            return *this;
+        }
+
+        // The allocator stays with the object, as PMR containers do.
+        SmallArray &operator=(SmallArray &&other) noexcept
+        {
+            if (this != &other)
+            {
+                clear();
+                if (other.IsInline() || m_alloc != other.m_alloc)
+                {
+                    reserve(other.m_size);
+                    std::uninitialized_move(other.begin(), other.end(), m_data);
+                    m_size = std::exchange(other.m_size, 0);
+                    std::destroy(other.begin(), other.begin() + m_size);
+                }
+                else
+                {
+                    Deallocate();
+                    MoveFrom(other);
+                }
+            }
+            return *this;
+        }
+
+    public:
+        template <typename It>
+        void assign(It first, It last)
+        {
+            clear();
+            reserve(usize_t(std::distance(first, last)));
+            m_size = usize_t(std::uninitialized_copy(first, last, m_data) - m_data);
+        }
+
+        template <typename... Args>
+        forceinline T &emplace_back(Args &&...args)
+        {
+            if (m_size == m_capacity) [[unlikely]]
+            {
+                Grow(m_size + 1);
+            }
+            return *std::construct_at(m_data + m_size++, std::forward<Args>(args)...);
+        }
+
+        forceinline void push_back(const T &value)
+        {
+            emplace_back(value);
+        }
+
+        forceinline void push_back(T &&value)
+        {
+            emplace_back(std::move(value));
+        }
+
+        forceinline void pop_back() noexcept
+        {
+            ASSERT(m_size > 0);
+            std::destroy_at(m_data + --m_size);
+        }
+
+        iterator erase(const_iterator first, const_iterator last)
+        {
+            auto dst = m_data + (first - m_data);
+            if (first != last)
+            {
+                auto new_end = std::move(dst + (last - first), end(), dst);
+                std::destroy(new_end, end());
+                m_size = usize_t(new_end - m_data);
+            }
+            return dst;
+        }
+
+        forceinline iterator erase(const_iterator pos)
+        {
+            return erase(pos, pos + 1);
+        }
+
+        void resize(usize_t size)
+        {
+            reserve(size);
+            if (size > m_size)
+            {
+                std::uninitialized_value_construct(m_data + m_size, m_data + size);
+            }
+            else
+            {
+                std::destroy(m_data + size, m_data + m_size);
+            }
+            m_size = size;
+        }
+
+        void resize(usize_t size, const T &value)
+        {
+            reserve(size);
+            if (size > m_size)
+            {
+                std::uninitialized_fill(m_data + m_size, m_data + size, value);
+            }
+            else
+            {
+                std::destroy(m_data + size, m_data + m_size);
+            }
+            m_size = size;
+        }
+
+        forceinline void reserve(usize_t capacity)
+        {
+            if (capacity > m_capacity)
+            {
+                Grow(capacity);
+            }
+        }
+
+        forceinline void clear() noexcept
+        {
+            std::destroy(m_data, m_data + m_size);
+            m_size = 0;
+        }
+
+    public:
+        [[nodiscard]] forceinline T &operator[](usize_t index) noexcept
+        {
+            ASSERT(index < m_size);
+            return m_data[index];
+        }
+
+        [[nodiscard]] forceinline const T &operator[](usize_t index) const noexcept
+        {
+            ASSERT(index < m_size);
+            return m_data[index];
+        }
+
+        [[nodiscard]] forceinline T &front() noexcept
+        {
+            return (*this)[0];
+        }
+
+        [[nodiscard]] forceinline const T &front() const noexcept
+        {
+            return (*this)[0];
+        }
+
+        [[nodiscard]] forceinline T &back() noexcept
+        {
+            return (*this)[m_size - 1];
+        }
+
+        [[nodiscard]] forceinline const T &back() const noexcept
+        {
+            return (*this)[m_size - 1];
+        }
+
+        [[nodiscard]] forceinline T *data() noexcept
+        {
+            return m_data;
+        }
+
+        [[nodiscard]] forceinline const T *data() const noexcept
+        {
+            return m_data;
+        }
+
+    public:
+        [[nodiscard]] forceinline iterator begin() noexcept
+        {
+            return m_data;
+        }
+
+        [[nodiscard]] forceinline const_iterator begin() const noexcept
+        {
+            return m_data;
+        }
+
+        [[nodiscard]] forceinline iterator end() noexcept
+        {
+            return m_data + m_size;
+        }
+
+        [[nodiscard]] forceinline const_iterator end() const noexcept
+        {
+            return m_data + m_size;
+        }
+
+        [[nodiscard]] forceinline usize_t size() const noexcept
+        {
+            return m_size;
+        }
+
+        [[nodiscard]] forceinline bool empty() const noexcept
+        {
+            return m_size == 0;
+        }
+
+        [[nodiscard]] forceinline usize_t capacity() const noexcept
+        {
+            return m_capacity;
+        }
+
+        [[nodiscard]] forceinline bool IsInline() const noexcept
+        {
+            return m_data == InlineData();
+        }
+
+        [[nodiscard]] forceinline Alloc get_allocator() const noexcept
+        {
+            return m_alloc;
+        }
+
+    private:
+        [[nodiscard]] forceinline T *InlineData() const noexcept
+        {
+            return std::launder(reinterpret_cast<T *>(const_cast<byte_t *>(m_inline)));
+        }
+
+        void Grow(usize_t capacity)
+        {
+            capacity = std::max(capacity, m_capacity * 2);
+
+            auto data = AllocTraits::allocate(m_alloc, capacity);
+            std::uninitialized_move(m_data, m_data + m_size, data);
+            std::destroy(m_data, m_data + m_size);
+            Deallocate();
+
+            m_data = data;
+            m_capacity = capacity;
+        }
+
+        forceinline void Deallocate() noexcept
+        {
+            if (!IsInline())
+            {
+                AllocTraits::deallocate(m_alloc, m_data, m_capacity);
+            }
+            m_data = InlineData();
+            m_capacity = N;
+        }
+
+        // Expects this array to be empty and inline.
+        void MoveFrom(SmallArray &other) noexcept
+        {
+            if (other.IsInline())
+            {
+                std::uninitialized_move(other.begin(), other.end(), m_data);
+                m_size = std::exchange(other.m_size, 0);
+                std::destroy(other.begin(), other.begin() + m_size);
+            }
+            else
+            {
+                m_data = std::exchange(other.m_data, other.InlineData());
+                m_size = std::exchange(other.m_size, 0);
+                m_capacity = std::exchange(other.m_capacity, N);
+            }
+        }
+
+    private:
+        T *m_data{InlineData()};
+        usize_t m_size{0};
+        usize_t m_capacity{N};
+        [[no_unique_address]] Alloc m_alloc{};
+        alignas(T) byte_t m_inline[N * sizeof(T)];
+    };
+
+    template <typename T, usize_t N>
+    using PmrSmallArray = SmallArray<T, N, PolymorphicAllocator<T>>;
+
+}
@@ -0,0 +1,370 @@
+#pragma once
+
+namespace Be
+{
+
+    // Structure of arrays: every field lives in its own contiguous column, so a kernel
+    // touches only the fields it reads. Columns share one allocation, start on a cache
+    // line and are padded to a whole line, so vector loads past the last element stay
+    // inside the allocation.
+    template <typename... Fields>
+    class SoAArray final : public MovableOnly
+    {
+    public:
+        static constexpr usize_t FieldCount = sizeof...(Fields);
+        static constexpr usize_t ColumnAlignment = BE_CACHE_LINE;
+
+        template <usize_t I>
+        using FieldType = std::tuple_element_t<I, Tuple<Fields...>>;
+
+    private:
+        template <bool CONST, usize_t... Is>
+        class ZipIterator final
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using difference_type = ptrdiff_t;
+            using value_type = Tuple<FieldType<Is>...>;
+            using reference = Tuple<std::conditional_t<CONST, const FieldType<Is> &, FieldType<Is> &>...>;
+            using Columns = Tuple<std::conditional_t<CONST, const FieldType<Is> *, FieldType<Is> *>...>;
+
+        public:
+            ZipIterator() noexcept = default;
+
+            forceinline ZipIterator(const Columns &columns, usize_t index) noexcept
+                : m_columns{columns},
+                  m_index{index}
+            {
+            }
+
+        public:
+            [[nodiscard]] forceinline reference operator*() const noexcept
+            {
+                return std::apply([this](auto *...columns)
+                                  { return reference{columns[m_index]...}; }, m_columns);
+            }
+
+            forceinline ZipIterator &operator++() noexcept
+            {
+                m_index++;
+                return *this;
+            }
+
+            forceinline ZipIterator operator++(int) noexcept
+            {
+                auto tmp = *this;
+                m_index++;
+                return tmp;
+            }
+
+            [[nodiscard]] forceinline bool operator==(const ZipIterator &other) const noexcept
+            {
+                return m_index == other.m_index;
+            }
+
+        private:
+            Columns m_columns{};
+            usize_t m_index{0};
+        };
+
+        template <bool CONST, usize_t... Is>
+        class ZipRange final
+        {
+        public:
+            using Iterator = ZipIterator<CONST, Is...>;
+
+        public:
+            forceinline ZipRange(const typename Iterator::Columns &columns, usize_t size) noexcept
+                : m_begin{columns, 0},
+                  m_end{columns, size}
+            {
+            }
+
+        public:
+            [[nodiscard]] forceinline Iterator begin() const noexcept
+            {
+                return m_begin;
+            }
+
+            [[nodiscard]] forceinline Iterator end() const noexcept
+            {
+                return m_end;
+            }
+
+        private:
+            Iterator m_begin;
+            Iterator m_end;
+        };
+
+    public:
+        SoAArray() noexcept = default;
+
+        explicit SoAArray(usize_t capacity)
+        {
+            reserve(capacity);
+        }
+
+        SoAArray(SoAArray &&other) noexcept
+            : m_data{std::exchange(other.m_data, nullptr)},
+              m_columns{std::exchange(other.m_columns, {})},
+              m_size{std::exchange(other.m_size, 0)},
+              m_capacity{std::exchange(other.m_capacity, 0)}
+        {
+        }
+
+        ~SoAArray() noexcept
+        {
+            Release();
+        }
+
+    public:
+        SoAArray &operator=(SoAArray &&other) noexcept
+        {
+            if (this != &other)
+            {
+                Release();
+                m_data = std::exchange(other.m_data, nullptr);
+                m_columns = std::exchange(other.m_columns, {});
+                m_size = std::exchange(other.m_size, 0);
+                m_capacity = std::exchange(other.m_capacity, 0);
+            }
+            return *this;
+        }
+
+    public:
+        template <typename... Args>
+            requires(sizeof...(Args) == FieldCount)
+        void push_back(Args &&...args)
+        {
+            if (m_size == m_capacity) [[unlikely]]
+            {
+                Reallocate(std::max(m_capacity * 2, MinCapacity()));
+            }
+
+            ConstructAt(m_size, std::index_sequence_for<Fields...>{}, std::forward<Args>(args)...);
+            m_size++;
+        }
+
+        void pop_back() noexcept
+        {
+            ASSERT(m_size > 0);
+
+            m_size--;
+            ForEachColumn([this](auto *column)
+                          { std::destroy_at(column + m_size); });
+        }
+
+        // Moves the last element into the erased one, so the order is not preserved.
+        void erase_swap(usize_t index) noexcept
+        {
+            ASSERT(index < m_size);
+
+            const auto last = m_size - 1;
+            if (index != last)
+            {
+                ForEachColumn([index, last](auto *column)
+                              { column[index] = std::move(column[last]); });
+            }
+            pop_back();
+        }
+
+        void resize(usize_t size)
+        {
+            reserve(size);
+            ForEachColumn([this, size](auto *column)
+                          {
+                              if (size > m_size)
+                              {
+                                  std::uninitialized_value_construct(column + m_size, column + size);
+                              }
+                              else
+                              {
+                                  std::destroy(column + size, column + m_size);
+                              } });
+            m_size = size;
+        }
+
+        void reserve(usize_t capacity)
+        {
+            if (capacity > m_capacity)
+            {
+                Reallocate(std::max(capacity, MinCapacity()));
+            }
+        }
+
+        void clear() noexcept
+        {
+            ForEachColumn([this](auto *column)
+                          { std::destroy(column, column + m_size); });
+            m_size = 0;
+        }
+
+    public:
+        [[nodiscard]] forceinline usize_t size() const noexcept
+        {
+            return m_size;
+        }
+
+        [[nodiscard]] forceinline bool empty() const noexcept
+        {
+            return m_size == 0;
+        }
+
+        [[nodiscard]] forceinline usize_t capacity() const noexcept
+        {
+            return m_capacity;
+        }
+
+    public:
+        template <usize_t I>
+        [[nodiscard]] forceinline Span<FieldType<I>> GetColumn() noexcept
+        {
+            return {Column<I>(), m_size};
+        }
+
+        template <usize_t I>
+        [[nodiscard]] forceinline Span<const FieldType<I>> GetColumn() const noexcept
+        {
+            return {Column<I>(), m_size};
+        }
+
+        template <usize_t I>
+        [[nodiscard]] forceinline FieldType<I> &Get(usize_t index) noexcept
+        {
+            ASSERT(index < m_size);
+            return Column<I>()[index];
+        }
+
+        template <usize_t I>
+        [[nodiscard]] forceinline const FieldType<I> &Get(usize_t index) const noexcept
+        {
+            ASSERT(index < m_size);
+            return Column<I>()[index];
+        }
+
+    public:
+        // Iterates the selected columns in lockstep, yielding a tuple of references.
+        template <usize_t... Is>
+        [[nodiscard]] forceinline ZipRange<false, Is...> Zip() noexcept
+        {
+            return {{Column<Is>()...}, m_size};
+        }
+
+        template <usize_t... Is>
+        [[nodiscard]] forceinline ZipRange<true, Is...> Zip() const noexcept
+        {
+            return {{Column<Is>()...}, m_size};
+        }
+
+        [[nodiscard]] forceinline auto begin() noexcept
+        {
+            return ZipAll(*this, std::index_sequence_for<Fields...>{}).begin();
+        }
+
+        [[nodiscard]] forceinline auto begin() const noexcept
+        {
+            return ZipAll(*this, std::index_sequence_for<Fields...>{}).begin();
+        }
+
+        [[nodiscard]] forceinline auto end() noexcept
+        {
+            return ZipAll(*this, std::index_sequence_for<Fields...>{}).end();
+        }
+
+        [[nodiscard]] forceinline auto end() const noexcept
+        {
+            return ZipAll(*this, std::index_sequence_for<Fields...>{}).end();
+        }
+
+    private:
+        // Keeps every column a whole number of cache lines long.
+        [[nodiscard]] static constexpr usize_t MinCapacity() noexcept
+        {
+            return ColumnAlignment;
+        }
+
+        template <usize_t I>
+        [[nodiscard]] forceinline FieldType<I> *Column() const noexcept
+        {
+            return static_cast<FieldType<I> *>(m_columns[I]);
+        }
+
+        template <typename F>
+        forceinline void ForEachColumn(F &&func) const
+        {
+            [&]<usize_t... Is>(std::index_sequence<Is...>)
+            {
+                (func(Column<Is>()), ...);
+            }(std::index_sequence_for<Fields...>{});
+        }
+
+        template <usize_t... Is, typename... Args>
+        forceinline void ConstructAt(usize_t index, std::index_sequence<Is...>, Args &&...args)
+        {
+            (std::construct_at(Column<Is>() + index, std::forward<Args>(args)), ...);
+        }
+
+        template <typename Self, usize_t... Is>
+        [[nodiscard]] static forceinline auto ZipAll(Self &self, std::index_sequence<Is...>) noexcept
+        {
+            return self.template Zip<Is...>();
+        }
+
+        void Reallocate(usize_t capacity)
+        {
+            PROFILER_SCOPE;
+
+            constexpr usize_t sizes[] = {sizeof(Fields)...};
+
+            FixedArray<usize_t, FieldCount> offsets{};
+            usize_t total_size{0};
+            for (usize_t i = 0; i < FieldCount; i++)
+            {
+                offsets[i] = total_size;
+                total_size = AlignUp(total_size + sizes[i] * capacity, ColumnAlignment);
+            }
+
+            auto data = static_cast<byte_t *>(::operator new(total_size, std::align_val_t{ColumnAlignment}));
+            FixedArray<void *, FieldCount> columns{};
+            for (usize_t i = 0; i < FieldCount; i++)
+            {
+                columns[i] = data + offsets[i];
+            }
+
+            [&]<usize_t... Is>(std::index_sequence<Is...>)
+            {
+                ((std::uninitialized_move(Column<Is>(), Column<Is>() + m_size, static_cast<FieldType<Is> *>(columns[Is])),
+                  std::destroy(Column<Is>(), Column<Is>() + m_size)),
+                 ...);
+            }(std::index_sequence_for<Fields...>{});
+
+            if (m_data != nullptr)
+            {
+                ::operator delete(m_data, std::align_val_t{ColumnAlignment});
+            }
+
+            m_data = data;
+            m_columns = columns;
+            m_capacity = capacity;
+        }
+
+        void Release() noexcept
+        {
+            clear();
+            if (m_data != nullptr)
+            {
+                ::operator delete(m_data, std::align_val_t{ColumnAlignment});
+            }
+            m_data = nullptr;
+            m_columns = {};
+            m_capacity = 0;
+        }
+
+    private:
+        byte_t *m_data{nullptr};
+        FixedArray<void *, FieldCount> m_columns{};
+        usize_t m_size{0};
+        usize_t m_capacity{0};
+    };
+
+}
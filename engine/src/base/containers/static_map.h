@@ -0,0 +1,190 @@
+#pragma once
+
+namespace Be
+{
+
+    namespace details
+    {
+        [[nodiscard]] forceinline constexpr uint64_t StaticMapKey(auto key) noexcept
+        {
+            using K = decltype(key);
+            STATIC_ASSERT(std::is_integral_v<K> || std::is_enum_v<K>, "Static map keys must be integers or enums");
+
+            if constexpr (std::is_enum_v<K>)
+            {
+                return uint64_t(std::to_underlying(key));
+            }
+            else
+            {
+                return uint64_t(key);
+            }
+        }
+    }
+
+    // Immutable map of integer or enum keys built during constant evaluation with
+    // hash and displace: every key picks a bucket, every bucket gets its own seed so
+    // that all keys land in distinct slots. A lookup is two multiplies, two loads and
+    // a select, without probing or branches. Empty slots repeat a key placed elsewhere,
+    // so a key found in a slot it does not hash to can not exist.
+    template <typename K, typename V, usize_t N>
+    class StaticMap final
+    {
+        STATIC_ASSERT(N > 0, "Static map must not be empty");
+
+    public:
+        using key_type = K;
+        using mapped_type = V;
+
+        static constexpr usize_t TableSize = std::max(std::bit_ceil(N), usize_t(2));
+        static constexpr uint32_t TableBits = std::countr_zero(TableSize);
+
+    public:
+        consteval StaticMap(const FixedArray<Pair<K, V>, N> &items, V missing) noexcept
+            : m_missing{missing}
+        {
+            // Keys ordered by bucket.
+            FixedArray<uint32_t, TableSize + 1> bucket_offsets{};
+            for (usize_t i = 0; i < N; i++)
+            {
+                bucket_offsets[Bucket(KeyHash(items[i].first)) + 1]++;
+            }
+
+            usize_t max_size{0};
+            for (usize_t bucket = 0; bucket < TableSize; bucket++)
+            {
+                max_size = std::max(max_size, usize_t(bucket_offsets[bucket + 1]));
+                bucket_offsets[bucket + 1] += bucket_offsets[bucket];
+            }
+
+            FixedArray<uint32_t, N> order{};
+            FixedArray<uint32_t, TableSize> bucket_fill{};
+            for (uint32_t i = 0; i < N; i++)
+            {
+                const auto bucket = Bucket(KeyHash(items[i].first));
+                order[bucket_offsets[bucket] + bucket_fill[bucket]++] = i;
+            }
+
+            FixedArray<bool, TableSize> used{};
+            FixedArray<usize_t, N> slots{};
+
+            // Large buckets first, while most of the slots are free.
+            for (auto size = max_size; size > 0; size--)
+            {
+                for (usize_t bucket = 0; bucket < TableSize; bucket++)
+                {
+                    if (bucket_fill[bucket] != size)
+                    {
+                        continue;
+                    }
+                    const auto *keys = &order[bucket_offsets[bucket]];
+
+                    bool placed{false};
+                    for (uint64_t attempt = 1; !placed; attempt++)
+                    {
+                        VERIFY(attempt < (1ull << 20), "Static map has duplicate keys");
+
+                        const auto seed = details::WyMix(attempt, details::WY_SECRET[2]);
+                        placed = true;
+                        for (usize_t i = 0; i < size && placed; i++)
+                        {
+                            slots[i] = Slot(KeyHash(items[keys[i]].first), seed);
+                            placed = !used[slots[i]];
+                            for (usize_t j = 0; j < i && placed; j++)
+                            {
+                                placed = slots[i] != slots[j];
+                            }
+                        }
+
+                        if (placed)
+                        {
+                            m_seeds[bucket] = seed;
+                            for (usize_t i = 0; i < size; i++)
+                            {
+                                used[slots[i]] = true;
+                                m_keys[slots[i]] = items[keys[i]].first;
+                                m_values[slots[i]] = items[keys[i]].second;
+                            }
+                        }
+                    }
+                }
+            }
+
+            // The first key has its own slot, so it never matches in a free one.
+            for (usize_t slot = 0; slot < TableSize; slot++)
+            {
+                if (!used[slot])
+                {
+                    m_keys[slot] = items[0].first;
+                    m_values[slot] = missing;
+                }
+            }
+        }
+
+    public:
+        // The mapped value, or the missing value given at construction.
+        [[nodiscard]] forceinline constexpr V operator[](const K &key) const noexcept
+        {
+            const auto slot = Find(key);
+            return m_keys[slot] == key ? m_values[slot] : m_missing;
+        }
+
+        [[nodiscard]] forceinline constexpr const V *find(const K &key) const noexcept
+        {
+            const auto slot = Find(key);
+            return m_keys[slot] == key ? &m_values[slot] : nullptr;
+        }
+
+        [[nodiscard]] forceinline constexpr bool contains(const K &key) const noexcept
+        {
+            return m_keys[Find(key)] == key;
+        }
+
+        [[nodiscard]] forceinline constexpr usize_t size() const noexcept
+        {
+            return N;
+        }
+
+    private:
+        [[nodiscard]] static forceinline constexpr uint64_t KeyHash(const K &key) noexcept
+        {
+            return details::WyMix(details::StaticMapKey(key), details::WY_SECRET[1]);
+        }
+
+        [[nodiscard]] static forceinline constexpr usize_t Bucket(uint64_t hash) noexcept
+        {
+            return usize_t(hash & (TableSize - 1));
+        }
+
+        [[nodiscard]] static forceinline constexpr usize_t Slot(uint64_t hash, uint64_t seed) noexcept
+        {
+            return usize_t(((hash ^ seed) * 0x9E37'79B9'7F4A'7C15ull) >> (64 - TableBits));
+        }
+
+        [[nodiscard]] forceinline constexpr usize_t Find(const K &key) const noexcept
+        {
+            const auto hash = KeyHash(key);
+            return Slot(hash, m_seeds[Bucket(hash)]);
+        }
+
+    private:
+        FixedArray<uint64_t, TableSize> m_seeds{};
+        FixedArray<K, TableSize> m_keys{};
+        FixedArray<V, TableSize> m_values{};
+        V m_missing;
+    };
+
+    // STATIC_MAP = MakeStaticMap<K, V>({{key, value}, ...}, missing);
+    template <typename K, typename V, usize_t N>
+    [[nodiscard]] consteval StaticMap<K, V, N> MakeStaticMap(const Pair<K, V> (&items)[N], V missing = {}) noexcept
+    {
+        return StaticMap<K, V, N>{std::to_array(items), missing};
+    }
+
+    // Generated tables.
+    template <typename K, typename V, usize_t N>
+    [[nodiscard]] consteval StaticMap<K, V, N> MakeStaticMap(const FixedArray<Pair<K, V>, N> &items, V missing = {}) noexcept
+    {
+        return StaticMap<K, V, N>{items, missing};
+    }
+
+}
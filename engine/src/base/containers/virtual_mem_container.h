@@ -3,56 +3,203 @@
 namespace Be
 {
 
+    // Vector-like container over a reserved virtual range. Pages are committed on growth
+    // and elements are never relocated, so pointers to them stay valid until erased.
     template <typename T>
     class VirtualMemoryContainer : public MovableOnly
     {
-    private:
-        static constexpr usize_t ValueSize = sizeof(T);
-        static constexpr usize_t ValueAlign = alignof(T);
-
     private:
         using Self = VirtualMemoryContainer<T>;
-        using ValueType = T;
-        using AlignedType = std::aligned_storage_t<ValueSize, ValueAlign>;
+
+    public:
+        using value_type = T;
+        using iterator = T *;
+        using const_iterator = const T *;
 
     public:
         explicit VirtualMemoryContainer(usize_t max_elements) noexcept
-            : m_size{max_elements},
-              m_mem_size{sizeof(AlignedType) * max_elements}
+            : m_capacity{max_elements},
+              m_page_size{Platform::GetPageSize()}
         {
-            m_data = static_cast<T *>(Platform::AllocateVirtualMemory(m_mem_size));
+            m_reserved_size = AlignUp(sizeof(T) * max_elements, m_page_size);
+            m_data = static_cast<T *>(Platform::ReserveVirtualMemory(m_reserved_size));
         }
 
-        ~VirtualMemoryContainer()
+        VirtualMemoryContainer(Self &&other) noexcept
+            : m_data{std::exchange(other.m_data, nullptr)},
+              m_size{std::exchange(other.m_size, 0)},
+              m_capacity{std::exchange(other.m_capacity, 0)},
+              m_committed_size{std::exchange(other.m_committed_size, 0)},
+              m_reserved_size{std::exchange(other.m_reserved_size, 0)},
+              m_page_size{other.m_page_size}
         {
-            if (m_data != nullptr)
+        }
+
+        Self &operator=(Self &&other) noexcept
+        {
+            if (this != &other)
             {
-                Platform::FreeVirtualMemory(m_data, m_mem_size);
+                Release();
+                m_data = std::exchange(other.m_data, nullptr);
+                m_size = std::exchange(other.m_size, 0);
+                m_capacity = std::exchange(other.m_capacity, 0);
+                m_committed_size = std::exchange(other.m_committed_size, 0);
+                m_reserved_size = std::exchange(other.m_reserved_size, 0);
+                m_page_size = other.m_page_size;
             }
+            return *this;
+        }
+
+        ~VirtualMemoryContainer()
+        {
+            Release();
         }
 
     public:
-        [[nodiscard]] forceinline T &operator[](size_t idx)
+        [[nodiscard]] forceinline T &operator[](usize_t idx) noexcept
         {
+            ASSERT(idx < m_size);
             return m_data[idx];
         }
 
-        [[nodiscard]] forceinline const T &operator[](size_t idx) const
+        [[nodiscard]] forceinline const T &operator[](usize_t idx) const noexcept
         {
+            ASSERT(idx < m_size);
             return m_data[idx];
         }
 
-        [[nodiscard]] forceinline size_t size() const
+        [[nodiscard]] forceinline T &back() noexcept
+        {
+            return (*this)[m_size - 1];
+        }
+
+        [[nodiscard]] forceinline T *data() noexcept { return m_data; }
+        [[nodiscard]] forceinline const T *data() const noexcept { return m_data; }
+
+        [[nodiscard]] forceinline iterator begin() noexcept { return m_data; }
+        [[nodiscard]] forceinline iterator end() noexcept { return m_data + m_size; }
+        [[nodiscard]] forceinline const_iterator begin() const noexcept { return m_data; }
+        [[nodiscard]] forceinline const_iterator end() const noexcept { return m_data + m_size; }
+
+        [[nodiscard]] forceinline usize_t size() const noexcept { return m_size; }
+        [[nodiscard]] forceinline bool empty() const noexcept { return m_size == 0; }
+
+        // Maximum number of elements, fixed at construction.
+        [[nodiscard]] forceinline usize_t max_size() const noexcept { return m_capacity; }
+
+        // Number of elements that fit into the committed pages.
+        [[nodiscard]] forceinline usize_t capacity() const noexcept { return m_committed_size / sizeof(T); }
+
+        [[nodiscard]] forceinline usize_t GetCommittedSize() const noexcept { return m_committed_size; }
+
+    public:
+        template <typename... Args>
+        forceinline T &emplace_back(Args &&...args)
+        {
+            reserve(m_size + 1);
+            auto ptr = PlacementNew<T>(m_data + m_size, std::forward<Args>(args)...);
+            m_size++;
+            return *ptr;
+        }
+
+        forceinline void push_back(const T &value)
+        {
+            emplace_back(value);
+        }
+
+        forceinline void push_back(T &&value)
+        {
+            emplace_back(std::move(value));
+        }
+
+        void append(Span<const T> values)
+        {
+            reserve(m_size + values.size());
+            if constexpr (IsMemCopyAvailable<T>)
+            {
+                MemCopy(m_data + m_size, values.data(), values.size_bytes());
+            }
+            else
+            {
+                std::uninitialized_copy(values.begin(), values.end(), m_data + m_size);
+            }
+            m_size += values.size();
+        }
+
+        forceinline void pop_back() noexcept
+        {
+            ASSERT(m_size > 0);
+            m_size--;
+            std::destroy_at(m_data + m_size);
+        }
+
+        void resize(usize_t size)
+        {
+            if (size < m_size)
+            {
+                std::destroy(m_data + size, m_data + m_size);
+            }
+            else
+            {
+                reserve(size);
+                std::uninitialized_value_construct(m_data + m_size, m_data + size);
+            }
+            m_size = size;
+        }
+
+        forceinline void clear() noexcept
+        {
+            std::destroy(m_data, m_data + m_size);
+            m_size = 0;
+        }
+
+        void reserve(usize_t count) noexcept
         {
-            return m_size;
+            const auto required = sizeof(T) * count;
+            if (required <= m_committed_size) [[likely]]
+            {
+                return;
+            }
+
+            VERIFY(count <= m_capacity, "Virtual memory container is full ({} elements).", m_capacity);
+
+            // Grow geometrically to keep the number of commit calls low.
+            const auto new_size = std::min(AlignUp(std::max(required, m_committed_size * 2), m_page_size), m_reserved_size);
+            Platform::CommitVirtualMemory(reinterpret_cast<byte_t *>(m_data) + m_committed_size, new_size - m_committed_size);
+            m_committed_size = new_size;
+        }
+
+        // Returns the pages past the last element to the OS.
+        void shrink_to_fit() noexcept
+        {
+            const auto new_size = AlignUp(sizeof(T) * m_size, m_page_size);
+            if (new_size < m_committed_size)
+            {
+                Platform::DecommitVirtualMemory(reinterpret_cast<byte_t *>(m_data) + new_size, m_committed_size - new_size);
+                m_committed_size = new_size;
+            }
         }
 
     private:
-        size_t m_size{0};
-        usize_t m_mem_size{0};
+        void Release() noexcept
+        {
+            if (m_data != nullptr)
+            {
+                clear();
+                Platform::FreeVirtualMemory(m_data, m_reserved_size);
+                m_data = nullptr;
+            }
+        }
 
     private:
         T *m_data{nullptr};
+        usize_t m_size{0};
+        usize_t m_capacity{0};
+
+    private:
+        usize_t m_committed_size{0};
+        usize_t m_reserved_size{0};
+        usize_t m_page_size{0};
     };
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,295 @@
+#include "base/base.h"
+
+namespace Be
+{
+
+    namespace
+    {
+        constexpr usize_t LOG_THREAD_CAPACITY = 512;
+        constexpr usize_t LOG_BATCH_SIZE = 64;
+        constexpr auto LOG_IDLE_WAIT = Milliseconds{2};
+
+        constexpr const char *LEVEL_NAMES[] = {"ERROR", "WARN", "INFO", "DEBUG"};
+
+        struct LogThreadBuffer
+        {
+            SpscRingBuffer<Logger::Record, LOG_THREAD_CAPACITY> records;
+            Atomic<bool> closed{false};
+        };
+
+        void FormatText(String &out, const Logger::Record &record)
+        {
+            uint32_t size;
+            std::memcpy(&size, record.payload, sizeof(size));
+            out.append(reinterpret_cast<const char *>(record.payload + sizeof(size)), size);
+        }
+
+        // Text too long for the payload, the record owns a heap copy.
+        void FormatOwnedText(String &out, const Logger::Record &record)
+        {
+            String *text;
+            std::memcpy(&text, record.payload, sizeof(text));
+            out.append(*text);
+            delete text;
+        }
+
+        void FormatRecord(String &out, const Logger::Record &record)
+        {
+            out.append(LEVEL_NAMES[usize_t(record.level)]);
+            out.append(": ");
+            record.formatter(out, record);
+            out.push_back('\n');
+        }
+
+        void Write(const String &text)
+        {
+            std::cout.write(text.data(), std::streamsize(text.size()));
+            std::cout.flush();
+        }
+
+        Atomic<bool> s_sink_stopped{false};
+        Atomic<uint64_t> s_dropped_count{0};
+
+        class LogSink final : public Noncopyable
+        {
+        public:
+            LogSink() noexcept
+                : m_thread{[this]
+                           { Run(); }}
+            {
+            }
+
+            ~LogSink() noexcept
+            {
+                {
+                    EXCLUSIVE_LOCK(m_mutex);
+                    m_stop = true;
+                }
+                m_wake.notify_all();
+                m_thread.join();
+
+                s_sink_stopped.store(true, std::memory_order_release);
+
+                // Threads still running keep writing into their buffers until the process ends.
+                for (auto &buffer : m_buffers)
+                {
+                    if (!buffer->closed.load(std::memory_order_acquire))
+                    {
+                        (void)buffer.release();
+                    }
+                }
+            }
+
+        public:
+            [[nodiscard]] LogThreadBuffer *Register() noexcept
+            {
+                EXCLUSIVE_LOCK(m_mutex);
+                return m_buffers.emplace_back(MakeUnique<LogThreadBuffer>()).get();
+            }
+
+            void Flush() noexcept
+            {
+                std::unique_lock lock{m_mutex};
+                const auto target = ++m_flush_requested;
+                m_wake.notify_all();
+                m_wake.wait(lock, [&]
+                            { return m_flushed >= target; });
+            }
+
+        private:
+            void Run() noexcept
+            {
+                uint64_t requested{0};
+                while (true)
+                {
+                    const auto written = Drain();
+
+                    std::unique_lock lock{m_mutex};
+                    if (m_flushed < requested)
+                    {
+                        m_flushed = requested;
+                        m_wake.notify_all();
+                    }
+                    if (m_stop && !written)
+                    {
+                        break;
+                    }
+                    if (!written && m_flush_requested == requested)
+                    {
+                        m_wake.wait_for(lock, LOG_IDLE_WAIT, [&]
+                                        { return m_stop || m_flush_requested != requested; });
+                    }
+                    // Everything pushed before the request is drained by the next pass.
+                    requested = m_flush_requested;
+                }
+
+                MemoryTracker::FlushThread();
+            }
+
+            // Takes what every thread has logged so far and writes it as one batch.
+            [[nodiscard]] bool Drain() noexcept
+            {
+                PROFILER_SCOPE;
+
+                {
+                    EXCLUSIVE_LOCK(m_mutex);
+                    m_drain_buffers.clear();
+                    for (const auto &buffer : m_buffers)
+                    {
+                        m_drain_buffers.push_back(buffer.get());
+                    }
+                }
+
+                m_batch.clear();
+                bool closed_empty{false};
+                for (auto *buffer : m_drain_buffers)
+                {
+                    // Closing is published after the last push of the thread.
+                    const auto closed = buffer->closed.load(std::memory_order_acquire);
+
+                    FixedArray<Logger::Record, LOG_BATCH_SIZE> records;
+                    usize_t count;
+                    while ((count = buffer->records.PopBatch(records)) != 0)
+                    {
+                        m_batch.insert(m_batch.end(), records.begin(), records.begin() + count);
+                    }
+                    closed_empty |= closed;
+                }
+
+                if (closed_empty)
+                {
+                    EXCLUSIVE_LOCK(m_mutex);
+                    std::erase_if(m_buffers, [](const auto &buffer)
+                                  { return buffer->closed.load(std::memory_order_acquire) && buffer->records.Empty(); });
+                }
+
+                const auto dropped = s_dropped_count.load(std::memory_order_relaxed);
+                if (m_batch.empty() && dropped == m_reported_dropped)
+                {
+                    return false;
+                }
+
+                std::stable_sort(m_batch.begin(), m_batch.end(), [](const auto &lhs, const auto &rhs)
+                                 { return lhs.timestamp < rhs.timestamp; });
+
+                m_text.clear();
+                if (dropped != m_reported_dropped)
+                {
+                    std::format_to(std::back_inserter(m_text), "WARN: {} log messages dropped\n", dropped - m_reported_dropped);
+                    m_reported_dropped = dropped;
+                }
+                for (const auto &record : m_batch)
+                {
+                    FormatRecord(m_text, record);
+                }
+                Write(m_text);
+
+                return true;
+            }
+
+        private:
+            Mutex m_mutex;
+            ConditionVariable m_wake;
+            Array<UniquePtr<LogThreadBuffer>> m_buffers;
+            uint64_t m_flush_requested{0};
+            uint64_t m_flushed{0};
+            bool m_stop{false};
+
+            // Sink thread only.
+            Array<LogThreadBuffer *> m_drain_buffers;
+            Array<Logger::Record> m_batch;
+            String m_text;
+            uint64_t m_reported_dropped{0};
+
+            std::thread m_thread;
+        };
+
+        [[nodiscard]] LogSink &GetSink() noexcept
+        {
+            static LogSink sink;
+            return sink;
+        }
+
+        struct LogThreadHandle
+        {
+            LogThreadBuffer *buffer{nullptr};
+
+            ~LogThreadHandle() noexcept
+            {
+                if (buffer)
+                {
+                    buffer->closed.store(true, std::memory_order_release);
+                }
+            }
+        };
+
+        thread_local LogThreadHandle t_log;
+    }
+
+    void Logger::Push(Record &record) noexcept
+    {
+        record.timestamp = Clock::now().time_since_epoch().count();
+
+        // Logging during shutdown, after the sink is gone.
+        if (s_sink_stopped.load(std::memory_order_acquire))
+        {
+            String text;
+            FormatRecord(text, record);
+            Write(text);
+            return;
+        }
+
+        auto &sink = GetSink();
+        if (!t_log.buffer)
+        {
+            t_log.buffer = sink.Register();
+        }
+
+        if (!t_log.buffer->records.TryPush(record))
+        {
+            s_dropped_count.fetch_add(1, std::memory_order_relaxed);
+            if (record.formatter == &FormatOwnedText)
+            {
+                String text;
+                FormatOwnedText(text, record);
+            }
+        }
+
+        if (record.level == ELevel::eError)
+        {
+            sink.Flush();
+        }
+    }
+
+    void Logger::PushText(Record &record, String &&text) noexcept
+    {
+        const auto size = uint32_t(text.size());
+        if (sizeof(size) + size <= Record::PayloadSize)
+        {
+            std::memcpy(record.payload, &size, sizeof(size));
+            std::memcpy(record.payload + sizeof(size), text.data(), size);
+            record.formatter = &FormatText;
+        }
+        else
+        {
+            auto *owned = new String{std::move(text)};
+            std::memcpy(record.payload, &owned, sizeof(owned));
+            record.formatter = &FormatOwnedText;
+        }
+        Push(record);
+    }
+
+    void Logger::Flush() noexcept
+    {
+        if (!s_sink_stopped.load(std::memory_order_acquire))
+        {
+            GetSink().Flush();
+        }
+    }
+
+    uint64_t Logger::GetDroppedCount() noexcept
+    {
+        return s_dropped_count.load(std::memory_order_relaxed);
+    }
+
+}
@@ -1,9 +1,26 @@
 #pragma once
 
+// Messages above this level are compiled out: 0 errors, 1 warnings, 2 info, 3 debug.
+#ifndef BE_LOG_LEVEL
+#ifdef BE_DEBUG
+#define BE_LOG_LEVEL 3
+#else
+#define BE_LOG_LEVEL 2
+#endif
+#endif
+
 #define LOG_ERROR(...) ::Be::Logger::Log(::Be::Logger::ELevel::eError, __VA_ARGS__)
+#if BE_LOG_LEVEL >= 1
 #define LOG_WARN(...) ::Be::Logger::Log(::Be::Logger::ELevel::eWarn, __VA_ARGS__)
+#else
+#define LOG_WARN(...)
+#endif
+#if BE_LOG_LEVEL >= 2
 #define LOG_INFO(...) ::Be::Logger::Log(::Be::Logger::ELevel::eInfo, __VA_ARGS__)
-#ifdef BE_DEBUG
+#else
+#define LOG_INFO(...)
+#endif
+#if BE_LOG_LEVEL >= 3
 #define LOG_DEBUG(...) ::Be::Logger::Log(::Be::Logger::ELevel::eDebug, __VA_ARGS__)
 #else
 #define LOG_DEBUG(...)
@@ -11,6 +28,12 @@
 
 namespace Be
 {
+    // Log only copies the arguments into a ring of the calling thread, a background
+    // sink formats and writes them in batches, ordered by time. Strings are copied,
+    // other arguments must be trivially copyable values to be formatted later, views,
+    // ranges and everything else are formatted on the calling thread. A full ring
+    // drops the message and the sink reports the count. Errors are flushed before
+    // Log returns, so a message before exit is never lost.
     class Logger final
     {
     public:
@@ -22,6 +45,21 @@ namespace Be
             eDebug
         };
 
+        // One message as stored in the thread ring.
+        struct Record
+        {
+            static constexpr size_t PayloadSize = 208;
+
+            using Formatter = void (*)(std::string &out, const Record &record);
+
+            Formatter formatter;
+            std::string_view fmt;
+            int64_t timestamp;
+            ELevel level;
+            alignas(16) std::byte payload[PayloadSize];
+        };
+        static_assert(sizeof(Record) == 256);
+
     private:
         Logger() = default;
 
@@ -29,22 +67,120 @@ namespace Be
         template <class... Args>
         static void Log(ELevel level, std::format_string<Args...> fmt, Args &&...args)
         {
-            const auto msg = std::format(fmt, std::forward<Args>(args)...);
-            const char *lvl = "INFO";
-            if (level == ELevel::eDebug)
+            if (level > s_level.load(std::memory_order_relaxed))
+            {
+                return;
+            }
+
+            Record record;
+            record.level = level;
+            record.fmt = fmt.get();
+
+            if constexpr ((IsDeferred<std::decay_t<Args>> && ...))
+            {
+                size_t offset{0};
+                if ((Encode(record, offset, args) && ...))
+                {
+                    record.formatter = &FormatDeferred<Args...>;
+                    Push(record);
+                    return;
+                }
+            }
+
+            PushText(record, std::format(fmt, std::forward<Args>(args)...));
+        }
+
+        // Returns once everything logged before the call is written.
+        static void Flush() noexcept;
+
+        static void SetLevel(ELevel level) noexcept
+        {
+            s_level.store(level, std::memory_order_relaxed);
+        }
+
+        [[nodiscard]] static ELevel GetLevel() noexcept
+        {
+            return s_level.load(std::memory_order_relaxed);
+        }
+
+        [[nodiscard]] static uint64_t GetDroppedCount() noexcept;
+
+    private:
+        template <typename T>
+        static constexpr bool IsString = std::is_convertible_v<const T &, std::string_view>;
+
+        template <typename T>
+        static constexpr bool IsDeferred = IsString<T> || (std::is_trivially_copyable_v<T> && !std::ranges::range<T>);
+
+        template <typename T>
+        using Deferred = std::conditional_t<IsString<T>, std::string_view, T>;
+
+        static void Push(Record &record) noexcept;
+        static void PushText(Record &record, std::string &&text) noexcept;
+
+        template <typename T>
+        [[nodiscard]] static bool Encode(Record &record, size_t &offset, const T &arg) noexcept
+        {
+            using D = std::decay_t<T>;
+
+            if constexpr (IsString<D>)
+            {
+                const std::string_view str{arg};
+                const auto size = uint32_t(str.size());
+                if (offset + sizeof(size) + size > Record::PayloadSize)
+                {
+                    return false;
+                }
+                std::memcpy(record.payload + offset, &size, sizeof(size));
+                std::memcpy(record.payload + offset + sizeof(size), str.data(), size);
+                offset += sizeof(size) + size;
+            }
+            else
             {
-                lvl = "DEBUG";
+                offset = (offset + alignof(D) - 1) & ~(alignof(D) - 1);
+                if (offset + sizeof(D) > Record::PayloadSize)
+                {
+                    return false;
+                }
+                std::memcpy(record.payload + offset, &arg, sizeof(D));
+                offset += sizeof(D);
             }
-            else if (level == ELevel::eWarn)
+            return true;
+        }
+
+        template <typename T>
+        [[nodiscard]] static Deferred<T> Decode(const Record &record, size_t &offset) noexcept
+        {
+            if constexpr (IsString<T>)
             {
-                lvl = "WARN";
+                uint32_t size;
+                std::memcpy(&size, record.payload + offset, sizeof(size));
+                offset += sizeof(size) + size;
+                return {reinterpret_cast<const char *>(record.payload + offset - size), size};
             }
-            else if (level == ELevel::eError)
+            else
             {
-                lvl = "ERROR";
+                offset = (offset + alignof(T) - 1) & ~(alignof(T) - 1);
+                T value;
+                std::memcpy(&value, record.payload + offset, sizeof(T));
+                offset += sizeof(T);
+                return value;
             }
-            std::cout << std::format("{}: {}\n", lvl, msg);
         }
+
+        template <class... Args>
+        static void FormatDeferred(std::string &out, const Record &record)
+        {
+            // Braced initialization decodes the arguments in order.
+            size_t offset{0};
+            std::tuple<Deferred<std::decay_t<Args>>...> values{Decode<std::decay_t<Args>>(record, offset)...};
+            std::apply([&](auto &...args)
+                       { std::vformat_to(std::back_inserter(out), record.fmt, std::make_format_args(args...)); },
+                       values);
+        }
+
+    private:
+        static inline std::atomic<ELevel> s_level{ELevel::eDebug};
     };
 
-}
\ No newline at end of file
+}
@@ -361,6 +361,7 @@ namespace Be
             {
                 ret[i] = O(data[i]);
             }
+            return ret;
         }
 
         [[nodiscard]] forceinline operator String() const noexcept
@@ -531,6 +532,7 @@ namespace Be
             {
                 ret[i] = O(data[i]);
             }
+            return ret;
         }
 
         [[nodiscard]] forceinline operator String() const noexcept
@@ -6,15 +6,18 @@ namespace Be
     class MallocMemoryArena final : public MovableOnly
     {
     public:
-        explicit MallocMemoryArena(usize_t size) noexcept
-            : m_size{size}
+        explicit MallocMemoryArena(usize_t size, EMemoryTag tag = EMemoryTag::eUntagged) noexcept
+            : m_size{size},
+              m_tag{tag}
         {
             m_begin = malloc(m_size);
             m_end = static_cast<byte_t *>(m_begin) + m_size;
+            MemoryTracker::OnAlloc(m_tag, m_size);
         }
 
         ~MallocMemoryArena() noexcept
         {
+            MemoryTracker::OnFree(m_tag, m_size);
             free(m_begin);
         }
 
@@ -34,10 +37,16 @@ namespace Be
             return m_size;
         }
 
+        [[nodiscard]] forceinline EMemoryTag GetTag() const noexcept
+        {
+            return m_tag;
+        }
+
     private:
         void *m_begin{nullptr};
         void *m_end{nullptr};
         usize_t m_size{0};
+        EMemoryTag m_tag{EMemoryTag::eUntagged};
     };
 
 }
\ No newline at end of file
@@ -8,6 +8,7 @@ namespace Be
         {t.Begin()} -> std::same_as<void *>;
         {t.End()} -> std::same_as<void *>;
         {t.Size()} -> std::same_as<usize_t>;
+        {t.GetTag()} -> std::same_as<EMemoryTag>;
     };
     // clang-format on
 }
@@ -3,15 +3,26 @@
 namespace Be
 {
 
-    VirtualMemoryArena::VirtualMemoryArena(usize_t size) noexcept
-        : m_size{size}
+    VirtualMemoryArena::VirtualMemoryArena(usize_t size, EMemoryTag tag, uint32_t numa_node) noexcept
+        : m_size{size},
+          m_tag{tag},
+          m_numa_node{numa_node}
     {
         m_begin = Platform::AllocateVirtualMemory(size);
         m_end = static_cast<byte_t *>(m_begin) + m_size;
+        MemoryTracker::OnAlloc(m_tag, m_size);
+
+        // Pages are not touched yet, so without a binding they land on the node of the first user.
+        if (m_numa_node != Platform::AnyNumaNode && !Platform::BindMemoryToNumaNode(m_begin, m_size, m_numa_node))
+        {
+            LOG_WARN("Failed to bind virtual memory arena to NUMA node {}, relying on first touch.", m_numa_node);
+            m_numa_node = Platform::AnyNumaNode;
+        }
     }
 
     VirtualMemoryArena::~VirtualMemoryArena() noexcept
     {
+        MemoryTracker::OnFree(m_tag, m_size);
         Platform::FreeVirtualMemory(m_begin, m_size);
     }
 
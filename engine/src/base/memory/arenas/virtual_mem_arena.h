@@ -6,7 +6,7 @@ namespace Be
     class VirtualMemoryArena final : public MovableOnly
     {
     public:
-        explicit VirtualMemoryArena(usize_t size) noexcept;
+        explicit VirtualMemoryArena(usize_t size, EMemoryTag tag = EMemoryTag::eUntagged, uint32_t numa_node = Platform::AnyNumaNode) noexcept;
         ~VirtualMemoryArena() noexcept;
 
     public:
@@ -25,10 +25,22 @@ namespace Be
             return m_size;
         }
 
+        [[nodiscard]] forceinline EMemoryTag GetTag() const noexcept
+        {
+            return m_tag;
+        }
+
+        [[nodiscard]] forceinline uint32_t GetNumaNode() const noexcept
+        {
+            return m_numa_node;
+        }
+
     private:
         void *m_begin{nullptr};
         void *m_end{nullptr};
         usize_t m_size{0};
+        EMemoryTag m_tag{EMemoryTag::eUntagged};
+        uint32_t m_numa_node{Platform::AnyNumaNode};
     };
 
 }
\ No newline at end of file
@@ -0,0 +1,165 @@
+#include "base/base.h"
+
+namespace Be::MemoryTracker
+{
+
+    namespace
+    {
+        constexpr int64_t FLUSH_BYTES_THRESHOLD = 64 << 10;
+        constexpr uint32_t FLUSH_OPS_THRESHOLD = 1024;
+
+        constexpr const char *TAG_NAMES[EMemoryTagEnum::Count] = {
+            "Untagged",
+            "Renderer",
+            "RHI",
+            "Assets",
+            "Scripting",
+            "Threading",
+        };
+
+        struct alignas(BE_CACHE_LINE) GlobalTagStats
+        {
+            Atomic<int64_t> current_bytes{0};
+            Atomic<int64_t> peak_bytes{0};
+            Atomic<uint64_t> alloc_count{0};
+            Atomic<uint64_t> free_count{0};
+            FixedArray<Atomic<uint64_t>, HistogramBucketCount> size_histogram{};
+        };
+
+        // Plain data only: it is touched from operator new, possibly before
+        // or after the thread's dynamic thread_local objects exist.
+        struct ThreadTagStats
+        {
+            int64_t delta_bytes;
+            uint64_t alloc_count;
+            uint64_t free_count;
+            uint32_t ops;
+            uint64_t size_histogram[HistogramBucketCount];
+        };
+
+        GlobalTagStats s_stats[EMemoryTagEnum::Count];
+
+        thread_local ThreadTagStats t_stats[EMemoryTagEnum::Count];
+        thread_local EMemoryTag t_tag{EMemoryTag::eUntagged};
+
+        [[nodiscard]] forceinline usize_t GetHistogramBucket(usize_t size) noexcept
+        {
+            const auto bucket = size > 16 ? usize_t(BitWidth(size - 1)) - 4 : 0;
+            return std::min(bucket, HistogramBucketCount - 1);
+        }
+
+        void Flush(EMemoryTag tag) noexcept
+        {
+            auto &local = t_stats[tag];
+            auto &global = s_stats[tag];
+
+            const auto current = global.current_bytes.fetch_add(local.delta_bytes, std::memory_order_relaxed) + local.delta_bytes;
+            auto peak = global.peak_bytes.load(std::memory_order_relaxed);
+            while (current > peak && !global.peak_bytes.compare_exchange_weak(peak, current, std::memory_order_relaxed))
+            {
+            }
+
+            global.alloc_count.fetch_add(local.alloc_count, std::memory_order_relaxed);
+            global.free_count.fetch_add(local.free_count, std::memory_order_relaxed);
+            for (usize_t i = 0; i < HistogramBucketCount; i++)
+            {
+                if (local.size_histogram[i] != 0)
+                {
+                    global.size_histogram[i].fetch_add(local.size_histogram[i], std::memory_order_relaxed);
+                }
+            }
+
+            local = {};
+        }
+
+        forceinline void FlushIfNeeded(EMemoryTag tag) noexcept
+        {
+            const auto &local = t_stats[tag];
+            if (local.ops >= FLUSH_OPS_THRESHOLD || local.delta_bytes >= FLUSH_BYTES_THRESHOLD || local.delta_bytes <= -FLUSH_BYTES_THRESHOLD)
+            {
+                Flush(tag);
+            }
+        }
+    }
+
+    void OnAlloc(EMemoryTag tag, usize_t size) noexcept
+    {
+        auto &local = t_stats[tag];
+        local.delta_bytes += int64_t(size);
+        local.alloc_count++;
+        local.ops++;
+        local.size_histogram[GetHistogramBucket(size)]++;
+
+        FlushIfNeeded(tag);
+    }
+
+    void OnFree(EMemoryTag tag, usize_t size) noexcept
+    {
+        auto &local = t_stats[tag];
+        local.delta_bytes -= int64_t(size);
+        local.free_count++;
+        local.ops++;
+
+        FlushIfNeeded(tag);
+    }
+
+    void FlushThread() noexcept
+    {
+        for (auto tag : EMemoryTagEnum::All)
+        {
+            Flush(tag);
+        }
+    }
+
+    Snapshot TakeSnapshot() noexcept
+    {
+        PROFILER_SCOPE;
+
+        FlushThread();
+
+        Snapshot snapshot{};
+        for (auto tag : EMemoryTagEnum::All)
+        {
+            const auto &global = s_stats[tag];
+            auto &stats = snapshot[tag];
+
+            stats.current_bytes = global.current_bytes.load(std::memory_order_relaxed);
+            stats.peak_bytes = usize_t(global.peak_bytes.load(std::memory_order_relaxed));
+            stats.alloc_count = global.alloc_count.load(std::memory_order_relaxed);
+            stats.free_count = global.free_count.load(std::memory_order_relaxed);
+            for (usize_t i = 0; i < HistogramBucketCount; i++)
+            {
+                stats.size_histogram[i] = global.size_histogram[i].load(std::memory_order_relaxed);
+            }
+        }
+
+        return snapshot;
+    }
+
+    void LogSnapshot() noexcept
+    {
+        const auto snapshot = TakeSnapshot();
+        for (auto tag : EMemoryTagEnum::All)
+        {
+            const auto &stats = snapshot[tag];
+            LOG_INFO("Memory [{}]: current {} bytes, peak {} bytes, {} allocs, {} frees",
+                     GetTagName(tag), stats.current_bytes, stats.peak_bytes, stats.alloc_count, stats.free_count);
+        }
+    }
+
+    const char *GetTagName(EMemoryTag tag) noexcept
+    {
+        return tag < EMemoryTagEnum::Count ? TAG_NAMES[tag] : "Unknown";
+    }
+
+    EMemoryTag GetThreadTag() noexcept
+    {
+        return t_tag;
+    }
+
+    void SetThreadTag(EMemoryTag tag) noexcept
+    {
+        t_tag = tag;
+    }
+
+}
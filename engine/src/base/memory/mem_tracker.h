@@ -0,0 +1,70 @@
+#pragma once
+
+#define MEMORY_TAG_SCOPE(TAG) \
+    ::Be::MemoryTagScope BE_CONCAT_RAW(mem_tag_scope_, __COUNTER__) { TAG }
+
+namespace Be
+{
+
+    ITERABLE_ENUM(EMemoryTag, uint8_t,
+                  eUntagged,
+                  eRenderer,
+                  eRhi,
+                  eAssets,
+                  eScripting,
+                  eThreading);
+
+    namespace MemoryTracker
+    {
+        // Bucket i counts allocations of up to 16 << i bytes, the last one everything larger.
+        inline constexpr usize_t HistogramBucketCount = 16;
+
+        struct TagStats
+        {
+            // Negative while memory freed by one thread is still batched as allocated by another.
+            int64_t current_bytes{0};
+            usize_t peak_bytes{0};
+            uint64_t alloc_count{0};
+            uint64_t free_count{0};
+            FixedArray<uint64_t, HistogramBucketCount> size_histogram{};
+        };
+
+        using Snapshot = FixedArray<TagStats, EMemoryTagEnum::Count>;
+
+        // Counters are batched per thread and published once the thread has accumulated
+        // enough changes, so a snapshot may lag by a few kilobytes per thread.
+        void OnAlloc(EMemoryTag tag, usize_t size) noexcept;
+        void OnFree(EMemoryTag tag, usize_t size) noexcept;
+
+        // Publishes the batched counters of the calling thread.
+        void FlushThread() noexcept;
+
+        [[nodiscard]] Snapshot TakeSnapshot() noexcept;
+        void LogSnapshot() noexcept;
+
+        [[nodiscard]] const char *GetTagName(EMemoryTag tag) noexcept;
+
+        // Tag applied to global new/delete on the calling thread.
+        [[nodiscard]] EMemoryTag GetThreadTag() noexcept;
+        void SetThreadTag(EMemoryTag tag) noexcept;
+    }
+
+    class MemoryTagScope final : public Noncopyable
+    {
+    public:
+        explicit forceinline MemoryTagScope(EMemoryTag tag) noexcept
+            : m_prev_tag{MemoryTracker::GetThreadTag()}
+        {
+            MemoryTracker::SetThreadTag(tag);
+        }
+
+        forceinline ~MemoryTagScope() noexcept
+        {
+            MemoryTracker::SetThreadTag(m_prev_tag);
+        }
+
+    private:
+        EMemoryTag m_prev_tag;
+    };
+
+}
@@ -2,5 +2,7 @@
 
 #include "base/memory/mem_size.h"
 #include "base/memory/mem_utils.h"
+#include "base/memory/mem_tracker.h"
+#include "base/memory/object_pool.h"
 #include "base/memory/arenas/mem_arena.h"
 #include "base/memory/new_delete.h"
\ No newline at end of file
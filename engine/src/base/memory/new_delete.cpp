@@ -1,39 +1,111 @@
 #include "base/base.h"
 
+namespace
+{
+    using namespace Be;
+
+    // Keeps the size and tag of a global allocation for the memory tracker.
+    struct alignas(__STDCPP_DEFAULT_NEW_ALIGNMENT__) AllocationHeader
+    {
+        usize_t size;
+        EMemoryTag tag;
+    };
+
+    forceinline void *TrackedAlloc(size_t size)
+    {
+        auto header = static_cast<AllocationHeader *>(malloc(sizeof(AllocationHeader) + size));
+        if (header == nullptr) [[unlikely]]
+        {
+            throw std::bad_alloc{};
+        }
+
+        header->size = size;
+        header->tag = MemoryTracker::GetThreadTag();
+        MemoryTracker::OnAlloc(header->tag, size);
+
+        auto ptr = header + 1;
+        PROFILER_MEM_ALLOC(ptr, size);
+        return ptr;
+    }
+
+    forceinline void TrackedFree(void *ptr) noexcept
+    {
+        if (ptr == nullptr)
+        {
+            return;
+        }
+
+        PROFILER_MEM_FREE(ptr);
+
+        auto header = static_cast<AllocationHeader *>(ptr) - 1;
+        MemoryTracker::OnFree(header->tag, header->size);
+        free(header);
+    }
+}
+
 void *operator new(size_t size)
 {
-    auto ptr = malloc(size);
-    PROFILER_MEM_ALLOC(ptr, size);
-    return ptr;
+    return TrackedAlloc(size);
 }
 
 void *operator new[](size_t size)
 {
-    auto ptr = malloc(size);
-    PROFILER_MEM_ALLOC(ptr, size);
-    return ptr;
+    return TrackedAlloc(size);
+}
+
+// The default nothrow forms forward to the replaceable ones above, but sanitizer
+// runtimes interpose them with their own allocator instead, and their memory then
+// reaches TrackedFree. Replacing them keeps the same header on every allocation.
+void *operator new(size_t size, const std::nothrow_t &) noexcept
+{
+    try
+    {
+        return TrackedAlloc(size);
+    }
+    catch (...)
+    {
+        return nullptr;
+    }
+}
+
+void *operator new[](size_t size, const std::nothrow_t &) noexcept
+{
+    try
+    {
+        return TrackedAlloc(size);
+    }
+    catch (...)
+    {
+        return nullptr;
+    }
 }
 
 void operator delete(void *ptr) noexcept
 {
-    PROFILER_MEM_FREE(ptr);
-    free(ptr);
+    TrackedFree(ptr);
 }
 
 void operator delete(void *ptr, size_t size) noexcept
 {
-    PROFILER_MEM_FREE(ptr);
-    free(ptr);
+    TrackedFree(ptr);
 }
 
 void operator delete[](void *ptr) noexcept
 {
-    PROFILER_MEM_FREE(ptr);
-    free(ptr);
+    TrackedFree(ptr);
 }
 
 void operator delete[](void *ptr, size_t size) noexcept
 {
-    PROFILER_MEM_FREE(ptr);
-    free(ptr);
+    TrackedFree(ptr);
+}
+
+void operator delete(void *ptr, const std::nothrow_t &) noexcept
+{
+    TrackedFree(ptr);
+}
+
+void operator delete[](void *ptr, const std::nothrow_t &) noexcept
+{
+    TrackedFree(ptr);
 }
@@ -0,0 +1,129 @@
+#pragma once
+
+// Routes new/delete of the class to a per-type ObjectPool. Objects of derived classes
+// with a different size fall back to the global heap.
+#define POOLED_ALLOCATION(T)                                                    \
+public:                                                                         \
+    [[nodiscard]] static void *operator new(::Be::usize_t size)                 \
+    {                                                                           \
+        if (size != sizeof(T)) [[unlikely]]                                     \
+        {                                                                       \
+            return ::operator new(size);                                        \
+        }                                                                       \
+        return ::Be::ObjectPool<T>::Get().Alloc();                              \
+    }                                                                           \
+    static void operator delete(void *ptr, ::Be::usize_t size) noexcept         \
+    {                                                                           \
+        if (size != sizeof(T)) [[unlikely]]                                     \
+        {                                                                       \
+            return ::operator delete(ptr);                                      \
+        }                                                                       \
+        ::Be::ObjectPool<T>::Get().Free(ptr);                                   \
+    }
+
+namespace Be
+{
+
+    // Fixed-size slot pool, one instance per type. Chunks are never returned to the OS,
+    // so the pool has a trivial destructor and outlives every object allocated from it.
+    template <typename T, usize_t CHUNK_SLOTS = 64>
+    class ObjectPool final
+    {
+    private:
+        union Slot
+        {
+            Slot *next;
+            alignas(T) byte_t storage[sizeof(T)];
+        };
+
+        struct Chunk
+        {
+            Chunk *next;
+            Slot slots[CHUNK_SLOTS];
+        };
+
+    public:
+        [[nodiscard]] static forceinline ObjectPool &Get() noexcept
+        {
+            static constinit ObjectPool s_pool;
+            return s_pool;
+        }
+
+    public:
+        [[nodiscard]] void *Alloc()
+        {
+            SpinLock lock{m_mutex};
+
+            if (m_free == nullptr) [[unlikely]]
+            {
+                AllocChunk();
+            }
+
+            auto slot = m_free;
+            m_free = slot->next;
+            m_live_count++;
+
+            return slot->storage;
+        }
+
+        void Free(void *ptr) noexcept
+        {
+            if (ptr == nullptr)
+            {
+                return;
+            }
+
+            auto slot = static_cast<Slot *>(ptr);
+
+            SpinLock lock{m_mutex};
+            ASSERT(m_live_count > 0);
+
+            slot->next = m_free;
+            m_free = slot;
+            m_live_count--;
+        }
+
+    public:
+        [[nodiscard]] forceinline usize_t GetLiveCount() const noexcept
+        {
+            return m_live_count;
+        }
+
+        [[nodiscard]] forceinline usize_t GetCapacity() const noexcept
+        {
+            return m_chunk_count * CHUNK_SLOTS;
+        }
+
+    private:
+        void AllocChunk()
+        {
+            Chunk *chunk{nullptr};
+            if constexpr (alignof(Chunk) > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+            {
+                chunk = static_cast<Chunk *>(::operator new(sizeof(Chunk), std::align_val_t{alignof(Chunk)}));
+            }
+            else
+            {
+                chunk = static_cast<Chunk *>(::operator new(sizeof(Chunk)));
+            }
+            chunk->next = m_chunks;
+            m_chunks = chunk;
+            m_chunk_count++;
+
+            // Link slots in address order so consecutive allocations are adjacent.
+            for (usize_t i = 0; i < CHUNK_SLOTS; i++)
+            {
+                chunk->slots[i].next = (i + 1 < CHUNK_SLOTS) ? &chunk->slots[i + 1] : m_free;
+            }
+            m_free = &chunk->slots[0];
+        }
+
+    private:
+        SpinMutex m_mutex;
+        Slot *m_free{nullptr};
+        Chunk *m_chunks{nullptr};
+        usize_t m_chunk_count{0};
+        usize_t m_live_count{0};
+    };
+
+}
@@ -5,10 +5,14 @@
 #include <unistd.h>
 #include <sys/mman.h>
 #include <sys/resource.h>
+#include <sys/syscall.h>
 
 #define MAP_HUGE_2MB (21 << MAP_HUGE_SHIFT)
 #define MAP_HUGE_1GB (30 << MAP_HUGE_SHIFT)
 
+// from linux/mempolicy.h, to avoid a libnuma dependency
+#define BE_MPOL_PREFERRED 1
+
 namespace Be::Platform
 {
 
@@ -37,7 +41,7 @@ namespace Be::Platform
 
         const auto page_size = GetPageSize();
         const auto page_count = size / page_size;
-        const auto pages_per_block = page_count / 128;
+        const auto pages_per_block = std::max(page_count / 128, usize_t(1));
         const ssize_t block_size = pages_per_block * GetPageSize();
         
         ssize_t remains = size;
@@ -59,6 +63,82 @@ namespace Be::Platform
         auto res = munmap(ptr, size);
         VERIFY(res == 0, "Failed to unmap virtual memory");
     }
+
+    void *ReserveVirtualMemory(usize_t size) noexcept
+    {
+        auto ptr = mmap(nullptr, size,
+                        PROT_NONE,
+                        MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE,
+                        -1, 0);
+        VERIFY(ptr != MAP_FAILED, "Failed to reserve virtual memory");
+
+        return ptr;
+    }
+
+    void CommitVirtualMemory(void *ptr, usize_t size) noexcept
+    {
+        auto res = mprotect(ptr, size, PROT_READ | PROT_WRITE);
+        VERIFY(res == 0, "Failed to commit virtual memory");
+    }
+
+    void DecommitVirtualMemory(void *ptr, usize_t size) noexcept
+    {
+        auto res = madvise(ptr, size, MADV_DONTNEED);
+        VERIFY(res == 0, "Failed to release physical pages");
+
+        res = mprotect(ptr, size, PROT_NONE);
+        VERIFY(res == 0, "Failed to decommit virtual memory");
+    }
+
+    uint32_t GetNumaNodeCount() noexcept
+    {
+        static const uint32_t count = []
+        {
+            // "0" or "0-N"
+            std::ifstream file{"/sys/devices/system/node/possible"};
+            String nodes;
+            if (!(file >> nodes))
+            {
+                return 1u;
+            }
+            const auto dash = nodes.find('-');
+            return dash == String::npos ? 1u : uint32_t(std::stoul(nodes.substr(dash + 1)) + 1);
+        }();
+        return count;
+    }
+
+    uint32_t GetCurrentNumaNode() noexcept
+    {
+        unsigned cpu{0};
+        unsigned node{0};
+        if (syscall(SYS_getcpu, &cpu, &node, nullptr) != 0)
+        {
+            return 0;
+        }
+        return node;
+    }
+
+    bool BindMemoryToNumaNode(void *ptr, usize_t size, uint32_t node) noexcept
+    {
+        if (node >= GetNumaNodeCount() || node >= sizeof(unsigned long) * 8)
+        {
+            return false;
+        }
+
+        const unsigned long mask = 1ul << node;
+        return syscall(SYS_mbind, ptr, size, BE_MPOL_PREFERRED, &mask, sizeof(mask) * 8, 0) == 0;
+    }
+
+    bool SetThreadNumaNode(uint32_t node) noexcept
+    {
+        if (node >= GetNumaNodeCount() || node >= sizeof(unsigned long) * 8)
+        {
+            return false;
+        }
+
+        const unsigned long mask = 1ul << node;
+        return syscall(SYS_set_mempolicy, BE_MPOL_PREFERRED, &mask, sizeof(mask) * 8) == 0;
+    }
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -8,4 +8,20 @@ namespace Be::Platform
     void *AllocateVirtualMemory(usize_t size) noexcept;
     void FreeVirtualMemory(void *ptr, usize_t size) noexcept;
 
+    // Reserved address space is inaccessible until it is committed.
+    // Sizes and pointers passed to commit/decommit must be page aligned.
+    void *ReserveVirtualMemory(usize_t size) noexcept;
+    void CommitVirtualMemory(void *ptr, usize_t size) noexcept;
+    void DecommitVirtualMemory(void *ptr, usize_t size) noexcept;
+
+    inline constexpr uint32_t AnyNumaNode = ~0u;
+
+    [[nodiscard]] uint32_t GetNumaNodeCount() noexcept;
+    [[nodiscard]] uint32_t GetCurrentNumaNode() noexcept;
+
+    // Both return false when the kernel has no NUMA support. Pages that are not bound
+    // are placed on the node of the thread that touches them first.
+    bool BindMemoryToNumaNode(void *ptr, usize_t size, uint32_t node) noexcept;
+    bool SetThreadNumaNode(uint32_t node) noexcept;
+
 }
\ No newline at end of file
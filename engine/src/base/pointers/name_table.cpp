@@ -0,0 +1,106 @@
+#include "base/base.h"
+
+namespace Be
+{
+
+    namespace
+    {
+        // Sharded by the top bits of the hash, so threads interning different names rarely
+        // meet on a lock, and lookups of known names only take it shared.
+        constexpr usize_t SHARD_BITS = 5;
+        constexpr usize_t BLOCK_SIZE = 64 * 1024;
+
+        struct alignas(BE_CACHE_LINE) NameTableShard
+        {
+            SharedMutex mutex;
+            FlatHashMap<uint64_t, StringView> names;
+            Array<UniquePtr<char[]>> blocks;
+            usize_t block_offset{BLOCK_SIZE};
+
+            [[nodiscard]] StringView Store(StringView name)
+            {
+                if (name.empty())
+                {
+                    return {};
+                }
+
+                if (name.size() > BLOCK_SIZE / 4)
+                {
+                    auto &block = blocks.emplace_back(std::make_unique_for_overwrite<char[]>(name.size()));
+                    std::memcpy(block.get(), name.data(), name.size());
+                    return {block.get(), name.size()};
+                }
+
+                if (block_offset + name.size() > BLOCK_SIZE)
+                {
+                    blocks.emplace_back(std::make_unique_for_overwrite<char[]>(BLOCK_SIZE));
+                    block_offset = 0;
+                }
+
+                auto dst = blocks.back().get() + block_offset;
+                std::memcpy(dst, name.data(), name.size());
+                block_offset += name.size();
+                return {dst, name.size()};
+            }
+        };
+
+        // Function local, so handles created during static initialization can intern too.
+        [[nodiscard]] NameTableShard &GetShard(HashValue hash) noexcept
+        {
+            static FixedArray<NameTableShard, usize_t(1) << SHARD_BITS> shards;
+            return shards[uint64_t(hash) >> (64 - SHARD_BITS)];
+        }
+    }
+
+    StringView NameTable::Intern(HashValue hash, StringView name) noexcept
+    {
+        PROFILER_SCOPE;
+
+        auto &shard = GetShard(hash);
+
+        {
+            SHARED_LOCK(shard.mutex);
+            const auto &names = shard.names;
+            if (const auto it = names.find(uint64_t(hash)); it != names.end())
+            {
+                VERIFY(it->second == name, "Name hash collision: '{}' and '{}' share hash {:#x}.", it->second, name, uint64_t(hash));
+                return it->second;
+            }
+        }
+
+        EXCLUSIVE_LOCK(shard.mutex);
+        auto [it, inserted] = shard.names.try_emplace(uint64_t(hash));
+        if (inserted)
+        {
+            it->second = shard.Store(name);
+        }
+        VERIFY(it->second == name, "Name hash collision: '{}' and '{}' share hash {:#x}.", it->second, name, uint64_t(hash));
+        return it->second;
+    }
+
+    StringView NameTable::Find(HashValue hash) noexcept
+    {
+        PROFILER_SCOPE;
+
+        auto &shard = GetShard(hash);
+
+        SHARED_LOCK(shard.mutex);
+        const auto &names = shard.names;
+        const auto it = names.find(uint64_t(hash));
+        return it != names.end() ? it->second : StringView{};
+    }
+
+    usize_t NameTable::Size() noexcept
+    {
+        usize_t size{0};
+        for (usize_t i = 0; i < (usize_t(1) << SHARD_BITS); i++)
+        {
+            auto &shard = GetShard(HashValue{uint64_t(i) << (64 - SHARD_BITS)});
+
+            SHARED_LOCK(shard.mutex);
+            size += shard.names.size();
+        }
+        return size;
+    }
+
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+namespace Be
+{
+
+    // Process wide hash to name registry behind NamedHandle. Every name is stored once and
+    // never released, so returned views stay valid for the lifetime of the process.
+    // Interning a different name under a known hash is a fatal collision.
+    class NameTable final : public Noninstanceable
+    {
+    public:
+        // Returns the stored copy of the name, safe to call from any thread.
+        static StringView Intern(HashValue hash, StringView name) noexcept;
+
+        // Empty for hashes that were never interned.
+        [[nodiscard]] static StringView Find(HashValue hash) noexcept;
+
+        [[nodiscard]] static usize_t Size() noexcept;
+    };
+
+}
@@ -3,6 +3,10 @@
 namespace Be
 {
 
+    // 8-byte handle of a name hash. Unless OPTIMIZED, handles built at runtime intern their
+    // name in NameTable, which detects hash collisions and keeps the name for logs and tools.
+    // Optimized handles skip interning but still find names interned by anyone else.
+    // Handles built during constant evaluation can't intern.
     template <typename ID, usize_t SIZE, bool OPTIMIZED, uint32_t SEED = UMax>
     struct NamedHandle
     {
@@ -19,6 +23,7 @@ namespace Be
         using HasherType = std::hash<Self>;
 
     public:
+        // Names with equal hashes are equal, NameTable rejects anything else.
         struct EqualToType
         {
             [[nodiscard]] bool operator()(const Self &lhs, const Self &rhs) const noexcept
@@ -49,112 +54,24 @@ namespace Be
         explicit constexpr NamedHandle(StringView name) noexcept
             : m_hash{ConstHashOf(name.data(), name.length(), Seed)}
         {
+            Register(name);
         }
 
         explicit constexpr NamedHandle(const char *name) noexcept
-            : m_hash{ConstHashOf(name, SIZE, Seed)}
+            : NamedHandle{StringView{name}}
         {
         }
 
         template <usize_t StringSize>
         explicit constexpr NamedHandle(const FixedString<StringSize> &name) noexcept
-            : m_hash{ConstHashOf(name.data(), std::min(SIZE, StringSize), Seed)}
+            : NamedHandle{StringView{name.data(), name.length()}}
         {
         }
 
-        constexpr NamedHandle(Self &&) noexcept = default;
-        constexpr NamedHandle(const Self &) noexcept = default;
-
-    public:
-        constexpr Self &operator=(Self &&) noexcept = default;
-        constexpr Self &operator=(const Self &) noexcept = default;
-
-        // template <usize_t StringSize>
-        // constexpr Self &operator=(const FixedString<StringSize> *name) noexcept
-        //     : m_hash{ConstHashOf(name.data(), std::min<UMax, StringSize>, Seed)}
-        // {
-        // }
-
-    public:
-        [[nodiscard]] auto operator<=>(const Self &) const = default;
-
-    public:
-        [[nodiscard]] constexpr HashValue Hash() const noexcept
-        {
-            return m_hash;
-        }
-
-        [[nodiscard]] constexpr bool IsDefined() const noexcept
-        {
-            return m_hash != EmptyHash;
-        }
-
-    private:
-        HashValue m_hash{};
-    };
-
-    template <typename ID, usize_t SIZE, uint32_t SEED>
-    struct NamedHandle<ID, SIZE, false, SEED>
-    {
-    public:
-        static constexpr usize_t Size = SIZE;
-
-    public:
-        using Self = NamedHandle<ID, SIZE, false, SEED>;
-        using ValueType = HashValue;
-        using OptimizedType = NamedHandle<ID, SIZE, true, SEED>;
-        using WithStringType = NamedHandle<ID, SIZE, false, SEED>;
-
-    public:
-        using HasherType = std::hash<Self>;
-
-    public:
-        struct EqualToType
-        {
-            [[nodiscard]] bool operator()(const Self &lhs, const Self &rhs) const noexcept
-            {
-                return lhs.m_hash == rhs.m_hash and lhs.m_name == rhs.m_name;
-            }
-        };
-
-    public:
-        static constexpr usize_t MaxStringLength = SIZE;
-        static constexpr uint32_t Seed = SEED;
-        static constexpr bool IsOptimized = false;
-
-    private:
-        static constexpr HashValue EmptyHash = ConstHashOf("", 0, SEED);
-
-    public:
-        constexpr NamedHandle() noexcept : m_hash{EmptyHash}
-        {
-        }
-
-        explicit constexpr NamedHandle(HashValue hash) noexcept
-            : m_hash{hash}
-        {
-        }
-
-        explicit constexpr NamedHandle(StringView name) noexcept
-            : m_hash{ConstHashOf(name.data(), name.length(), Seed)},
-              m_name{name}
-        {
-        }
-
-        explicit constexpr NamedHandle(const char *name) noexcept
-            : m_hash{ConstHashOf(name, UMax, Seed)},
-              m_name{name}
-        {
-        }
-
-        template <usize_t StrSize>
-        explicit constexpr NamedHandle(const FixedString<StrSize> &name) noexcept
-            : m_hash{ConstHashOf(name.data(), name.length(), Seed)},
-              m_name{name}
-        {
-        }
-
-        explicit constexpr NamedHandle(const OptimizedType &other) noexcept
+        // Optimized handles convert implicitly, the other way round has to be explicit.
+        template <bool OTHER_OPTIMIZED>
+            requires(OTHER_OPTIMIZED != OPTIMIZED)
+        explicit(!OPTIMIZED) constexpr NamedHandle(const NamedHandle<ID, SIZE, OTHER_OPTIMIZED, SEED> &other) noexcept
             : m_hash{other.Hash()}
         {
         }
@@ -170,29 +87,36 @@ namespace Be
         [[nodiscard]] auto operator<=>(const Self &) const = default;
 
     public:
-        [[nodiscard]] constexpr operator OptimizedType() const noexcept
+        [[nodiscard]] constexpr HashValue Hash() const noexcept
         {
-            return OptimizedType{Hash()};
+            return m_hash;
         }
 
-        [[nodiscard]] constexpr StringView GetName() const noexcept
+        [[nodiscard]] constexpr bool IsDefined() const noexcept
         {
-            return m_name;
+            return m_hash != EmptyHash;
         }
 
-        [[nodiscard]] constexpr HashValue Hash() const noexcept
+        // Empty when the name was never interned.
+        [[nodiscard]] StringView GetName() const noexcept
         {
-            return m_hash;
+            return NameTable::Find(m_hash);
         }
 
-        [[nodiscard]] constexpr bool IsDefined() const noexcept
+    private:
+        constexpr void Register(StringView name) noexcept
         {
-            return m_hash != EmptyHash;
+            if constexpr (!OPTIMIZED)
+            {
+                if (!std::is_constant_evaluated())
+                {
+                    NameTable::Intern(m_hash, name);
+                }
+            }
         }
 
     private:
-        HashValue m_hash;
-        FixedString<SIZE> m_name;
+        HashValue m_hash{};
     };
 
     template <typename UID, usize_t Size, uint32_t Seed>
@@ -238,7 +162,7 @@ namespace Be
         template <typename UID, usize_t Size, uint32_t Seed>
         struct TriviallySerializable<NamedHandle<UID, Size, false, Seed>>
         {
-            static constexpr bool value = false;
+            static constexpr bool value = true;
         };
     }
 
@@ -1,4 +1,5 @@
 #pragma once
 
 #include "base/pointers/ref_counter.h"
+#include "base/pointers/name_table.h"
 #include "base/pointers/named_handle.h"
\ No newline at end of file
@@ -24,10 +24,39 @@ namespace Be
             return result;
         }
 
-    private:
+        // Only a snapshot while other threads hold references.
+        [[nodiscard]] forceinline uint64_t GetRefCount() const noexcept
+        {
+            return m_ref_count.load(std::memory_order_acquire);
+        }
+
+    protected:
         Atomic<uint64_t> m_ref_count{1};
     };
 
+    // Reference counter for objects owned and released by a single thread.
+    class LocalRefCounter : public RefCounter
+    {
+    public:
+        uint64_t AddRef() noexcept override
+        {
+            const auto result = m_ref_count.load(std::memory_order_relaxed) + 1;
+            m_ref_count.store(result, std::memory_order_relaxed);
+            return result;
+        }
+
+        uint64_t Release() noexcept override
+        {
+            const auto result = m_ref_count.load(std::memory_order_relaxed) - 1;
+            m_ref_count.store(result, std::memory_order_relaxed);
+            if (result == 0)
+            {
+                delete this;
+            }
+            return result;
+        }
+    };
+
     template <typename T>
         requires(IsBaseOf<RefCounter, T>)
     class RefCountPtr
@@ -20,6 +20,7 @@
 #define PROFILER_SCOPE_N(N) ZoneNamed(N, true)
 #define PROFILER_MEM_ALLOC(PTR, SIZE) TracyAlloc(PTR, SIZE)
 #define PROFILER_MEM_FREE(PTR) TracyFree(PTR)
+#define PROFILER_PLOT(N, V) TracyPlot(N, V)
 #define MUTEX(N) TracyLockable(Mutex, N)
 
 #else
@@ -30,6 +31,7 @@
 #define PROFILER_END_FRAME(N)
 #define PROFILER_SCOPE
 #define PROFILER_SCOPE_N(N)
+#define PROFILER_PLOT(N, V)
 #define MUTEX(N) Mutex N
 
 #endif
\ No newline at end of file
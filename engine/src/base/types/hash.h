@@ -26,17 +26,7 @@ namespace Be
         }
 
     public:
-        constexpr HashValue &operator+=(const HashValue &rhs) noexcept
-        {
-            const uint64_t mask = (sizeof(value) * 8 - 1);
-            uint64_t val = rhs.value;
-            uint64_t shift = 8;
-
-            shift &= mask;
-            value ^= (val << shift) | (val >> (~(shift - 1) & mask));
-
-            return *this;
-        }
+        constexpr HashValue &operator+=(const HashValue &rhs) noexcept;
 
         constexpr HashValue &operator+=(uint64_t rhs) noexcept
         {
@@ -64,60 +54,146 @@ namespace Be
 
     namespace details
     {
-        // from https://stackoverflow.com/questions/2111667/compile-time-string-hashing
-        static constexpr uint32_t CRC_TABLE[256] = {
-            0x00000000, 0x77073096, 0xee0e612c, 0x990951ba, 0x076dc419, 0x706af48f,
-            0xe963a535, 0x9e6495a3, 0x0edb8832, 0x79dcb8a4, 0xe0d5e91e, 0x97d2d988,
-            0x09b64c2b, 0x7eb17cbd, 0xe7b82d07, 0x90bf1d91, 0x1db71064, 0x6ab020f2,
-            0xf3b97148, 0x84be41de, 0x1adad47d, 0x6ddde4eb, 0xf4d4b551, 0x83d385c7,
-            0x136c9856, 0x646ba8c0, 0xfd62f97a, 0x8a65c9ec, 0x14015c4f, 0x63066cd9,
-            0xfa0f3d63, 0x8d080df5, 0x3b6e20c8, 0x4c69105e, 0xd56041e4, 0xa2677172,
-            0x3c03e4d1, 0x4b04d447, 0xd20d85fd, 0xa50ab56b, 0x35b5a8fa, 0x42b2986c,
-            0xdbbbc9d6, 0xacbcf940, 0x32d86ce3, 0x45df5c75, 0xdcd60dcf, 0xabd13d59,
-            0x26d930ac, 0x51de003a, 0xc8d75180, 0xbfd06116, 0x21b4f4b5, 0x56b3c423,
-            0xcfba9599, 0xb8bda50f, 0x2802b89e, 0x5f058808, 0xc60cd9b2, 0xb10be924,
-            0x2f6f7c87, 0x58684c11, 0xc1611dab, 0xb6662d3d, 0x76dc4190, 0x01db7106,
-            0x98d220bc, 0xefd5102a, 0x71b18589, 0x06b6b51f, 0x9fbfe4a5, 0xe8b8d433,
-            0x7807c9a2, 0x0f00f934, 0x9609a88e, 0xe10e9818, 0x7f6a0dbb, 0x086d3d2d,
-            0x91646c97, 0xe6635c01, 0x6b6b51f4, 0x1c6c6162, 0x856530d8, 0xf262004e,
-            0x6c0695ed, 0x1b01a57b, 0x8208f4c1, 0xf50fc457, 0x65b0d9c6, 0x12b7e950,
-            0x8bbeb8ea, 0xfcb9887c, 0x62dd1ddf, 0x15da2d49, 0x8cd37cf3, 0xfbd44c65,
-            0x4db26158, 0x3ab551ce, 0xa3bc0074, 0xd4bb30e2, 0x4adfa541, 0x3dd895d7,
-            0xa4d1c46d, 0xd3d6f4fb, 0x4369e96a, 0x346ed9fc, 0xad678846, 0xda60b8d0,
-            0x44042d73, 0x33031de5, 0xaa0a4c5f, 0xdd0d7cc9, 0x5005713c, 0x270241aa,
-            0xbe0b1010, 0xc90c2086, 0x5768b525, 0x206f85b3, 0xb966d409, 0xce61e49f,
-            0x5edef90e, 0x29d9c998, 0xb0d09822, 0xc7d7a8b4, 0x59b33d17, 0x2eb40d81,
-            0xb7bd5c3b, 0xc0ba6cad, 0xedb88320, 0x9abfb3b6, 0x03b6e20c, 0x74b1d29a,
-            0xead54739, 0x9dd277af, 0x04db2615, 0x73dc1683, 0xe3630b12, 0x94643b84,
-            0x0d6d6a3e, 0x7a6a5aa8, 0xe40ecf0b, 0x9309ff9d, 0x0a00ae27, 0x7d079eb1,
-            0xf00f9344, 0x8708a3d2, 0x1e01f268, 0x6906c2fe, 0xf762575d, 0x806567cb,
-            0x196c3671, 0x6e6b06e7, 0xfed41b76, 0x89d32be0, 0x10da7a5a, 0x67dd4acc,
-            0xf9b9df6f, 0x8ebeeff9, 0x17b7be43, 0x60b08ed5, 0xd6d6a3e8, 0xa1d1937e,
-            0x38d8c2c4, 0x4fdff252, 0xd1bb67f1, 0xa6bc5767, 0x3fb506dd, 0x48b2364b,
-            0xd80d2bda, 0xaf0a1b4c, 0x36034af6, 0x41047a60, 0xdf60efc3, 0xa867df55,
-            0x316e8eef, 0x4669be79, 0xcb61b38c, 0xbc66831a, 0x256fd2a0, 0x5268e236,
-            0xcc0c7795, 0xbb0b4703, 0x220216b9, 0x5505262f, 0xc5ba3bbe, 0xb2bd0b28,
-            0x2bb45a92, 0x5cb36a04, 0xc2d7ffa7, 0xb5d0cf31, 0x2cd99e8b, 0x5bdeae1d,
-            0x9b64c2b0, 0xec63f226, 0x756aa39c, 0x026d930a, 0x9c0906a9, 0xeb0e363f,
-            0x72076785, 0x05005713, 0x95bf4a82, 0xe2b87a14, 0x7bb12bae, 0x0cb61b38,
-            0x92d28e9b, 0xe5d5be0d, 0x7cdcefb7, 0x0bdbdf21, 0x86d3d2d4, 0xf1d4e242,
-            0x68ddb3f8, 0x1fda836e, 0x81be16cd, 0xf6b9265b, 0x6fb077e1, 0x18b74777,
-            0x88085ae6, 0xff0f6a70, 0x66063bca, 0x11010b5c, 0x8f659eff, 0xf862ae69,
-            0x616bffd3, 0x166ccf45, 0xa00ae278, 0xd70dd2ee, 0x4e048354, 0x3903b3c2,
-            0xa7672661, 0xd06016f7, 0x4969474d, 0x3e6e77db, 0xaed16a4a, 0xd9d65adc,
-            0x40df0b66, 0x37d83bf0, 0xa9bcae53, 0xdebb9ec5, 0x47b2cf7f, 0x30b5ffe9,
-            0xbdbdf21c, 0xcabac28a, 0x53b39330, 0x24b4a3a6, 0xbad03605, 0xcdd70693,
-            0x54de5729, 0x23d967bf, 0xb3667a2e, 0xc4614ab8, 0x5d681b02, 0x2a6f2b94,
-            0xb40bbe37, 0xc30c8ea1, 0x5a05df1b, 0x2d02ef8d};
-
-        [[nodiscard]] forceinline constexpr uint32_t Crc32Hash(char const *str, size_t len, uint32_t prev_crc) noexcept
+        // wyhash (final version 4) by Wang Yi, public domain: https://github.com/wangyi-fudan/wyhash
+        // Short inputs are two overlapping reads, long ones run three independent
+        // 64x64->128 multiply lanes over 48 bytes per step.
+        static constexpr uint64_t WY_SECRET[4] = {0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull, 0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull};
+
+        // Constant evaluation reads bytes in little endian order, runtime reads must agree.
+        STATIC_ASSERT(std::endian::native == std::endian::little, "Hashing expects a little endian target.");
+
+        forceinline constexpr void WyMum(uint64_t &a, uint64_t &b) noexcept
+        {
+#if defined(__SIZEOF_INT128__)
+            const auto r = static_cast<unsigned __int128>(a) * b;
+            a = uint64_t(r);
+            b = uint64_t(r >> 64);
+#else
+            const uint64_t ha = a >> 32, hb = b >> 32, la = uint32_t(a), lb = uint32_t(b);
+            const uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+            const uint64_t t = rl + (rm0 << 32);
+            const uint64_t lo = t + (rm1 << 32);
+            const uint64_t hi = rh + (rm0 >> 32) + (rm1 >> 32) + (t < rl) + (lo < t);
+            a = lo;
+            b = hi;
+#endif
+        }
+
+        [[nodiscard]] forceinline constexpr uint64_t WyMix(uint64_t a, uint64_t b) noexcept
+        {
+            WyMum(a, b);
+            return a ^ b;
+        }
+
+        template <usize_t N, typename CharType>
+        [[nodiscard]] forceinline constexpr uint64_t WyRead(const CharType *p) noexcept
+        {
+            if (std::is_constant_evaluated())
+            {
+                uint64_t v{0};
+                for (usize_t i = 0; i < N; i++)
+                {
+                    v |= uint64_t(uint8_t(p[i])) << (i * 8);
+                }
+                return v;
+            }
+
+            std::conditional_t<N == 8, uint64_t, uint32_t> v;
+            std::memcpy(&v, p, N);
+            return v;
+        }
+
+        template <typename CharType>
+        [[nodiscard]] constexpr uint64_t WyHash(const CharType *p, usize_t len, uint64_t seed) noexcept
+        {
+            seed ^= WyMix(seed ^ WY_SECRET[0], WY_SECRET[1]);
+
+            uint64_t a, b;
+            if (len <= 16) [[likely]]
+            {
+                if (len >= 4) [[likely]]
+                {
+                    const auto shift = (len >> 3) << 2;
+                    a = (WyRead<4>(p) << 32) | WyRead<4>(p + shift);
+                    b = (WyRead<4>(p + len - 4) << 32) | WyRead<4>(p + len - 4 - shift);
+                }
+                else if (len > 0) [[likely]]
+                {
+                    a = (uint64_t(uint8_t(p[0])) << 16) | (uint64_t(uint8_t(p[len >> 1])) << 8) | uint64_t(uint8_t(p[len - 1]));
+                    b = 0;
+                }
+                else
+                {
+                    a = b = 0;
+                }
+            }
+            else
+            {
+                auto i = len;
+                if (i >= 48) [[unlikely]]
+                {
+                    auto see1 = seed, see2 = seed;
+                    do
+                    {
+                        seed = WyMix(WyRead<8>(p) ^ WY_SECRET[1], WyRead<8>(p + 8) ^ seed);
+                        see1 = WyMix(WyRead<8>(p + 16) ^ WY_SECRET[2], WyRead<8>(p + 24) ^ see1);
+                        see2 = WyMix(WyRead<8>(p + 32) ^ WY_SECRET[3], WyRead<8>(p + 40) ^ see2);
+                        p += 48;
+                        i -= 48;
+                    } while (i >= 48);
+                    seed ^= see1 ^ see2;
+                }
+                while (i > 16)
+                {
+                    seed = WyMix(WyRead<8>(p) ^ WY_SECRET[1], WyRead<8>(p + 8) ^ seed);
+                    i -= 16;
+                    p += 16;
+                }
+                a = WyRead<8>(p + i - 16);
+                b = WyRead<8>(p + i - 8);
+            }
+
+            a ^= WY_SECRET[1];
+            b ^= seed;
+            WyMum(a, b);
+            return WyMix(a ^ WY_SECRET[0] ^ len, b ^ WY_SECRET[1]);
+        }
+
+        // Length of a string that is either NUL terminated or max_len long.
+        [[nodiscard]] forceinline constexpr usize_t StringLength(const char *str, usize_t max_len) noexcept
         {
-            return (*str and len)
-                       ? Crc32Hash(str + 1, len - 1, (prev_crc >> 8) ^ CRC_TABLE[(prev_crc ^ *str) & 0xFF])
-                       : (prev_crc ^ 0xFFFFFFFF);
+            if (std::is_constant_evaluated())
+            {
+                usize_t len{0};
+                while (len < max_len && str[len] != '\0')
+                {
+                    len++;
+                }
+                return len;
+            }
+
+            const auto end = static_cast<const char *>(std::memchr(str, '\0', max_len));
+            return end != nullptr ? usize_t(end - str) : max_len;
         }
     }
 
+    // Order dependent and avalanching: HashCombine(a, b) != HashCombine(b, a).
+    [[nodiscard]] forceinline constexpr uint64_t HashCombine(uint64_t lhs, uint64_t rhs) noexcept
+    {
+        using namespace details;
+
+        lhs ^= WY_SECRET[0];
+        rhs ^= WY_SECRET[1];
+        WyMum(lhs, rhs);
+        return WyMix(lhs ^ WY_SECRET[0], rhs ^ WY_SECRET[1]);
+    }
+
+    constexpr HashValue &HashValue::operator+=(const HashValue &rhs) noexcept
+    {
+        value = HashCombine(value, rhs.value);
+        return *this;
+    }
+
     template <typename T>
         requires(!IsFloat<T> && !IsEnum<T>)
     [[nodiscard]] forceinline HashValue HashOf(const T &value) noexcept
@@ -149,29 +225,15 @@ namespace Be
 
         uint64_t dst;
         std::memcpy(&dst, &value, sizeof(dst));
-        dst &= ~((1 << ignore_mantissa_bits) - 1);
+        dst &= ~((uint64_t{1} << ignore_mantissa_bits) - 1);
         return HashValue(std::hash<uint64_t>()(dst));
     }
 
-    [[nodiscard]] forceinline HashValue HashOf(const void *ptr, size_t size) noexcept
+    [[nodiscard]] forceinline HashValue HashOf(const void *ptr, size_t size, uint64_t seed = 0) noexcept
     {
-        assert(ptr && size);
-
-#if defined(BE_HAS_HASHFN_HashArrayRepresentation)
-        return HashValue{std::_Hash_array_representation(static_cast<const unsigned char *>(ptr), size)};
-#elif defined(BE_HAS_HASHFN_Murmur2OrCityhash)
-        return HashValue{std::__murmur2_or_cityhash<usize_t>()(ptr, size)};
-#elif defined(BE_HAS_HASHFN_HashBytes)
-        return HashValue{std::_Hash_bytes(ptr, size, 0)};
-#else
-        const auto buf = static_cast<const uint8_t *>(ptr);
-        HashValue result;
-        for (size_t i = 0; i < size; ++i)
-        {
-            result += HashValue{buf[i]};
-        }
-        return result;
-#endif
+        assert(ptr || size == 0);
+
+        return HashValue{details::WyHash(static_cast<const uint8_t *>(ptr), size, seed)};
     }
 
     template <typename T>
@@ -180,15 +242,27 @@ namespace Be
         return HashOf(value.data(), value.size() * sizeof(T));
     }
 
-    [[nodiscard]] forceinline constexpr HashValue ConstHashOf(const char *str, size_t len, uint32_t seed) noexcept
+    // Hashes up to len characters, stopping at a NUL, so fixed size buffers hash like their strings.
+    [[nodiscard]] forceinline constexpr HashValue ConstHashOf(const char *str, size_t len, uint64_t seed) noexcept
     {
-        return HashValue{details::Crc32Hash(str, len, seed)};
+        return HashValue{details::WyHash(str, details::StringLength(str, len), seed)};
     }
 
     [[nodiscard]] forceinline constexpr HashValue ConstHashOf(const char *str) noexcept
     {
-        return HashValue{details::Crc32Hash(str, strlen(str), 123456)};
+        return ConstHashOf(str, UMax, 123456);
     }
+
+    // Transparent hasher, so string keyed containers can be searched with views and literals.
+    struct StringHash
+    {
+        using is_transparent = void;
+
+        [[nodiscard]] forceinline size_t operator()(StringView str) const noexcept
+        {
+            return size_t(HashOf(str.data(), str.size()));
+        }
+    };
 }
 
 namespace std
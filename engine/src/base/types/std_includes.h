@@ -46,4 +46,14 @@
 #include <utility>
 #include <variant>
 #include <vector>
-#include <version>
\ No newline at end of file
+#include <version>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BE_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(__AVX__)
+#define BE_SIMD_AVX
+#include <immintrin.h>
+#endif
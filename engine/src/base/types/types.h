@@ -92,6 +92,24 @@ namespace Be
     using ByteArray = Array<byte_t>;
     using Data = Span<const byte_t>;
 
+    // polymorphic allocator container types
+
+    using MemoryResource = std::pmr::memory_resource;
+
+    template <typename T>
+    using PolymorphicAllocator = std::pmr::polymorphic_allocator<T>;
+
+    template <typename T>
+    using PmrArray = Array<T, PolymorphicAllocator<T>>;
+
+    template <typename T, typename Hash = std::hash<T>, typename Pred = std::equal_to<T>>
+    using PmrSet = Set<T, Hash, Pred, PolymorphicAllocator<T>>;
+
+    template <typename Key, typename T, typename Hash = std::hash<Key>, typename Pred = std::equal_to<Key>>
+    using PmrMap = Map<Key, T, Hash, Pred, PolymorphicAllocator<std::pair<const Key, T>>>;
+
+    using PmrString = BasicString<ansi_t, PolymorphicAllocator<ansi_t>>;
+
     // other types
 
     template <typename T>
@@ -0,0 +1,10 @@
+#pragma once
+
+#include "frameworks/threading/threading.h"
+
+#include "frameworks/ecs/world/component.h"
+#include "frameworks/ecs/world/archetype.h"
+#include "frameworks/ecs/world/world.h"
+#include "frameworks/ecs/world/command_buffer.h"
+#include "frameworks/ecs/systems/system_scheduler.h"
+#include "frameworks/ecs/systems/transform_systems.h"
\ No newline at end of file
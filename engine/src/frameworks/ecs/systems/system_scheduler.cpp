@@ -0,0 +1,76 @@
+#include "frameworks/ecs/ecs.h"
+
+namespace Be::Framework::ECS
+{
+
+    thread_local uint32_t SystemContext::s_command_slot{0};
+
+    SystemScheduler::SystemScheduler(World &world)
+        : m_world{world}
+    {
+    }
+
+    uint32_t SystemScheduler::Add(String name, const SystemAccess &access, SystemFunction function)
+    {
+        uint32_t stage{0};
+        for (const auto &system : m_systems)
+        {
+            if (system.access.ConflictsWith(access))
+            {
+                stage = std::max(stage, system.stage + 1);
+            }
+        }
+
+        const auto index = uint32_t(m_systems.size());
+        m_systems.push_back({std::move(name), access, std::move(function), stage});
+        // Queries run at most MaxThreadCount blocks, and one when it is unknown.
+        m_command_buffers.emplace_back(usize_t(std::max(ThreadUtils::MaxThreadCount(), 1u)) + 1);
+        if (stage == m_stages.size())
+        {
+            m_stages.emplace_back();
+        }
+        m_stages[stage].push_back(index);
+
+        return index;
+    }
+
+    void SystemScheduler::Run()
+    {
+        PROFILER_SCOPE;
+
+        const auto run = [this](uint32_t system)
+        {
+            const SystemContext context{m_world, m_command_buffers[system]};
+            SystemContext::RunInSlot(0, [&]
+                                     { m_systems[system].function(context); });
+        };
+        const bool parallel = Threading::AsyncTaskScheduler::IsRunning();
+
+        for (const auto &stage : m_stages)
+        {
+            if (parallel && stage.size() > 1)
+            {
+                Threading::ParallelInvoke(stage.size(), [&](usize_t i)
+                                          { run(stage[i]); });
+                continue;
+            }
+
+            for (const auto system : stage)
+            {
+                run(system);
+            }
+        }
+
+        for (const auto &stage : m_stages)
+        {
+            for (const auto system : stage)
+            {
+                for (auto &buffer : m_command_buffers[system])
+                {
+                    buffer.Playback(m_world);
+                }
+            }
+        }
+    }
+
+}
@@ -0,0 +1,188 @@
+#pragma once
+
+namespace Be::Framework::ECS
+{
+
+    // Components and resources a system reads and writes. Two systems conflict when one
+    // of them writes what the other one reads or writes.
+    struct SystemAccess
+    {
+        ComponentMask read{0};
+        ComponentMask write{0};
+
+        template <typename... Ts>
+        SystemAccess &Read()
+        {
+            read |= ComponentMaskOf<Ts...>();
+            return *this;
+        }
+
+        template <typename... Ts>
+        SystemAccess &Write()
+        {
+            write |= ComponentMaskOf<Ts...>();
+            return *this;
+        }
+
+        // Const types are read, the others are written.
+        template <typename... Ts>
+        [[nodiscard]] static SystemAccess Of()
+        {
+            SystemAccess access;
+            (((std::is_const_v<Ts> ? access.read : access.write) |= ComponentMaskOf<Ts>()), ...);
+            return access;
+        }
+
+        [[nodiscard]] forceinline bool ConflictsWith(const SystemAccess &other) const noexcept
+        {
+            return (write & (other.read | other.write)) != 0 || (other.write & read) != 0;
+        }
+    };
+
+    // What a running system gets. Queries split their chunks into the same blocks
+    // whether the task scheduler is running or not, and run them as tasks only when it
+    // is. Structural changes are recorded and applied once all systems are done: the
+    // system has one command buffer for its own code and one per query block, so the
+    // commands of its own code play back first and the order never depends on threads.
+    class SystemContext final : public Noncopyable
+    {
+    public:
+        SystemContext(World &world, Span<CommandBuffer> command_buffers) noexcept
+            : m_world{world},
+              m_command_buffers{command_buffers}
+        {
+        }
+
+    public:
+        [[nodiscard]] forceinline World &GetWorld() const noexcept
+        {
+            return m_world;
+        }
+
+        [[nodiscard]] forceinline CommandBuffer &GetCommandBuffer() const noexcept
+        {
+            ASSERT(s_command_slot < m_command_buffers.size());
+            return m_command_buffers[s_command_slot];
+        }
+
+    public:
+        template <Component... Ts, typename F>
+        void ForEachChunk(F &&func) const
+        {
+            m_world.ForEachChunkParallel<Ts...>(ThreadUtils::MaxThreadCount(),
+                                                [](usize_t task_count, const auto &task)
+                                                {
+                                                    const auto run = [&task](usize_t i)
+                                                    { RunInSlot(uint32_t(i + 1), [&]
+                                                                { task(i); }); };
+                                                    if (task_count > 1 && Threading::AsyncTaskScheduler::IsRunning())
+                                                    {
+                                                        Threading::ParallelInvoke(task_count, run);
+                                                        return;
+                                                    }
+                                                    for (usize_t i = 0; i < task_count; i++)
+                                                    {
+                                                        run(i);
+                                                    }
+                                                },
+                                                func);
+        }
+
+        template <Component... Ts, typename F>
+        void ForEach(F &&func) const
+        {
+            ForEachChunk<Ts...>([&func](usize_t count, const Entity *entities, Ts *...columns)
+                                {
+                                    for (usize_t i = 0; i < count; i++)
+                                    {
+                                        func(entities[i], columns[i]...);
+                                    } });
+        }
+
+    private:
+        // Command buffer of the code running on this thread. A thread waiting for tasks
+        // runs other tasks in between, so the slot is restored after each of them.
+        template <typename F>
+        static void RunInSlot(uint32_t slot, F &&func)
+        {
+            const auto previous = std::exchange(s_command_slot, slot);
+            func();
+            s_command_slot = previous;
+        }
+
+        static thread_local uint32_t s_command_slot;
+
+    private:
+        World &m_world;
+        Span<CommandBuffer> m_command_buffers;
+
+        friend class SystemScheduler;
+    };
+
+    using SystemFunction = Function<void(const SystemContext &)>;
+
+    // Systems are grouped into stages in the order they are added: a system goes to the
+    // stage after the last one holding a system it conflicts with, so conflicting systems
+    // keep their order and the systems of a stage run as parallel tasks. Command buffers
+    // are played back after the last stage in stage and system order, so the result
+    // doesn't depend on the threads that ran the systems.
+    class SystemScheduler final : public Noncopyable
+    {
+    public:
+        explicit SystemScheduler(World &world);
+
+    public:
+        // Returns the index of the system.
+        uint32_t Add(String name, const SystemAccess &access, SystemFunction function);
+
+        // A system that calls func(entity, components...) for every entity with the
+        // components, the const ones are read and the others written.
+        template <Component... Ts, typename F>
+        uint32_t AddForEach(String name, F &&func)
+        {
+            return Add(std::move(name), SystemAccess::Of<Ts...>(), [func = std::forward<F>(func)](const SystemContext &context)
+                       { context.ForEach<Ts...>(func); });
+        }
+
+        void Run();
+
+    public:
+        [[nodiscard]] forceinline usize_t GetSystemCount() const noexcept
+        {
+            return m_systems.size();
+        }
+
+        [[nodiscard]] forceinline usize_t GetStageCount() const noexcept
+        {
+            return m_stages.size();
+        }
+
+        [[nodiscard]] forceinline uint32_t GetStage(uint32_t system) const noexcept
+        {
+            ASSERT(system < m_systems.size());
+            return m_systems[system].stage;
+        }
+
+        [[nodiscard]] forceinline const String &GetName(uint32_t system) const noexcept
+        {
+            ASSERT(system < m_systems.size());
+            return m_systems[system].name;
+        }
+
+    private:
+        struct System
+        {
+            String name;
+            SystemAccess access;
+            SystemFunction function;
+            uint32_t stage;
+        };
+
+    private:
+        World &m_world;
+        Array<System> m_systems;
+        Array<Array<uint32_t>> m_stages;
+        Array<Array<CommandBuffer>> m_command_buffers; // Per system, see SystemContext.
+    };
+
+}
@@ -0,0 +1,61 @@
+#include "frameworks/ecs/ecs.h"
+
+namespace Be::Framework::ECS
+{
+
+    void AddTransformSystems(SystemScheduler &scheduler, TransformHierarchy &hierarchy)
+    {
+        // The setters of the hierarchy aren't thread safe, so the chunks are visited in
+        // order on this thread.
+        const auto apply = [&hierarchy](const SystemContext &context)
+        {
+            context.GetWorld().ForEachChunk<const LocalTransform, const TransformNode>([&hierarchy](usize_t count, const Entity *, const LocalTransform *locals, const TransformNode *nodes)
+                                                                                       {
+                                                                                           for (usize_t i = 0; i < count; i++)
+                                                                                           {
+                                                                                               const auto node = nodes[i].handle;
+                                                                                               const auto &local = locals[i];
+                                                                                               if (!hierarchy.Contains(node))
+                                                                                               {
+                                                                                                   continue;
+                                                                                               }
+                                                                                               if (local.position != hierarchy.GetPosition(node) || local.rotation.data != hierarchy.GetRotation(node).data || local.scale != hierarchy.GetScale(node))
+                                                                                               {
+                                                                                                   hierarchy.SetLocal(node, local.position, local.rotation, local.scale);
+                                                                                               }
+                                                                                           } });
+        };
+
+        const auto update = [&hierarchy](const SystemContext &)
+        {
+            if (Threading::AsyncTaskScheduler::IsRunning())
+            {
+                hierarchy.UpdateParallel(ThreadUtils::MaxThreadCount(), [](usize_t task_count, const auto &func)
+                                         { Threading::ParallelInvoke(task_count, func); });
+            }
+            else
+            {
+                hierarchy.Update();
+            }
+        };
+
+        const auto sync = [&hierarchy](const SystemContext &context)
+        {
+            context.ForEachChunk<const TransformNode, WorldTransform>([&hierarchy](usize_t count, const Entity *, const TransformNode *nodes, WorldTransform *worlds)
+                                                                      {
+                                                                          for (usize_t i = 0; i < count; i++)
+                                                                          {
+                                                                              const auto node = nodes[i].handle;
+                                                                              if (hierarchy.Contains(node) && hierarchy.IsWorldChanged(node))
+                                                                              {
+                                                                                  worlds[i].matrix = hierarchy.GetWorld(node);
+                                                                              }
+                                                                          } });
+        };
+
+        scheduler.Add("LocalTransformApply", SystemAccess::Of<const LocalTransform, const TransformNode>().Write<TransformHierarchy>(), apply);
+        scheduler.Add("TransformHierarchyUpdate", SystemAccess{}.Write<TransformHierarchy>(), update);
+        scheduler.Add("WorldTransformSync", SystemAccess::Of<const TransformHierarchy, const TransformNode, WorldTransform>(), sync);
+    }
+
+}
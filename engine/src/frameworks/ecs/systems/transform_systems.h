@@ -0,0 +1,38 @@
+#pragma once
+
+namespace Be::Framework::ECS
+{
+
+    // Node of the entity in the transform hierarchy. The node is owned by the caller and
+    // is not destroyed with the entity: destroying a node destroys its whole subtree,
+    // which may hold the nodes of other entities, and entities are destroyed by command
+    // playback, which has no access to the hierarchy.
+    struct TransformNode
+    {
+        TransformHandle handle;
+    };
+
+    // Local transform of the node, written into the hierarchy when it differs from the
+    // one the node has.
+    struct LocalTransform
+    {
+        Float3 position{0.0f, 0.0f, 0.0f};
+        Quatf rotation;
+        Float3 scale{1.0f, 1.0f, 1.0f};
+    };
+
+    // World matrix of the node, with column vectors as in the transform hierarchy. It is
+    // only written when the world matrix of the node changes, so it starts with the
+    // current one.
+    struct WorldTransform
+    {
+        Float4x4 matrix;
+    };
+
+    // Writes the LocalTransform components into the nodes of their entities, updates the
+    // hierarchy, then copies the world matrices the update changed into the
+    // WorldTransform components of the entities with a TransformNode. Systems reading
+    // WorldTransform and added later run after them.
+    void AddTransformSystems(SystemScheduler &scheduler, TransformHierarchy &hierarchy);
+
+}
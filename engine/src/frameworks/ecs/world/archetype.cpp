@@ -0,0 +1,122 @@
+#include "frameworks/ecs/ecs.h"
+
+namespace Be::Framework::ECS
+{
+
+    namespace
+    {
+        struct alignas(BE_CACHE_LINE) ChunkMemory
+        {
+            byte_t data[CHUNK_SIZE];
+        };
+
+        using ChunkPool = ObjectPool<ChunkMemory, 16>;
+
+        // Size of a chunk holding capacity rows, every column starts aligned to its component.
+        [[nodiscard]] usize_t GetChunkLayoutSize(const Array<ComponentId> &components, usize_t capacity, FixedArray<uint16_t, MAX_COMPONENTS> *offsets)
+        {
+            auto offset = sizeof(Entity) * capacity;
+            for (const auto id : components)
+            {
+                const auto &info = GetComponentInfo(id);
+                offset = AlignUp(offset, usize_t(info.alignment));
+                if (offsets != nullptr)
+                {
+                    (*offsets)[id] = uint16_t(offset);
+                }
+                offset += usize_t(info.size) * capacity;
+            }
+            return offset;
+        }
+    }
+
+    Archetype::Archetype(ComponentMask mask)
+        : m_mask{mask}
+    {
+        m_add_edges.fill(NoEdge);
+        m_remove_edges.fill(NoEdge);
+
+        usize_t row_size = sizeof(Entity);
+        for (auto bits = mask; bits != 0; bits &= bits - 1)
+        {
+            const auto id = ComponentId(std::countr_zero(bits));
+            m_components.push_back(id);
+            row_size += GetComponentInfo(id).size;
+        }
+
+        auto capacity = CHUNK_SIZE / row_size;
+        while (capacity > 0 && GetChunkLayoutSize(m_components, capacity, nullptr) > CHUNK_SIZE)
+        {
+            capacity--;
+        }
+        VERIFY(capacity > 0, "Components of an archetype don't fit into a chunk of {} bytes.", CHUNK_SIZE);
+
+        m_chunk_capacity = uint32_t(capacity);
+        (void)GetChunkLayoutSize(m_components, capacity, &m_offsets);
+    }
+
+    Archetype::~Archetype()
+    {
+        for (auto *chunk : m_chunks)
+        {
+            ChunkPool::Get().Free(chunk);
+        }
+    }
+
+    uint32_t Archetype::PushRow(Entity entity)
+    {
+        constexpr uint32_t MAX_ROWS = UMax;
+        VERIFY(m_size < MAX_ROWS, "Archetype is full.");
+
+        if (m_size == m_chunks.size() * m_chunk_capacity)
+        {
+            m_chunks.push_back(static_cast<byte_t *>(ChunkPool::Get().Alloc()));
+        }
+
+        const auto row = uint32_t(m_size++);
+        GetEntities(row / m_chunk_capacity)[row % m_chunk_capacity] = entity;
+        return row;
+    }
+
+    Entity Archetype::RemoveRow(uint32_t row)
+    {
+        ASSERT(row < m_size);
+
+        const auto last = uint32_t(m_size - 1);
+        Entity moved{};
+        if (row != last)
+        {
+            const auto chunk = row / m_chunk_capacity, index = row % m_chunk_capacity;
+            const auto last_chunk = last / m_chunk_capacity, last_index = last % m_chunk_capacity;
+
+            moved = GetEntities(last_chunk)[last_index];
+            GetEntities(chunk)[index] = moved;
+            for (const auto id : m_components)
+            {
+                const auto size = GetComponentInfo(id).size;
+                std::memcpy(GetColumn(chunk, id) + usize_t(index) * size, GetColumn(last_chunk, id) + usize_t(last_index) * size, size);
+            }
+        }
+
+        m_size--;
+        if (m_size == (m_chunks.size() - 1) * m_chunk_capacity)
+        {
+            ChunkPool::Get().Free(m_chunks.back());
+            m_chunks.pop_back();
+        }
+
+        return moved;
+    }
+
+    void Archetype::CopyRow(uint32_t row, const Archetype &source, uint32_t source_row) noexcept
+    {
+        for (const auto id : m_components)
+        {
+            if (source.Has(id))
+            {
+                std::memcpy(GetComponent(row, id), source.GetComponent(source_row, id), GetComponentInfo(id).size);
+            }
+        }
+    }
+
+}
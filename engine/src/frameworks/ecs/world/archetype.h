@@ -0,0 +1,120 @@
+#pragma once
+
+namespace Be::Framework::ECS
+{
+
+    inline constexpr usize_t CHUNK_SIZE = 16 * 1024;
+
+    // Entities with the same set of components. They are packed into chunks of
+    // CHUNK_SIZE bytes, every chunk holds the entity handles and then one column per
+    // component for the same rows. Rows are dense: all chunks but the last are full and a
+    // removed row is filled with the last one.
+    class Archetype final : public Noncopyable
+    {
+        friend class World;
+
+    public:
+        explicit Archetype(ComponentMask mask);
+        ~Archetype();
+
+    public:
+        [[nodiscard]] forceinline ComponentMask GetMask() const noexcept
+        {
+            return m_mask;
+        }
+
+        [[nodiscard]] forceinline bool Has(ComponentId id) const noexcept
+        {
+            return m_mask & (ComponentMask{1} << id);
+        }
+
+        [[nodiscard]] forceinline bool Matches(ComponentMask mask) const noexcept
+        {
+            return (m_mask & mask) == mask;
+        }
+
+    public:
+        // The components of the new row are left uninitialized.
+        [[nodiscard]] uint32_t PushRow(Entity entity);
+
+        // Returns the entity moved into the row, an invalid handle when the row was the last.
+        Entity RemoveRow(uint32_t row);
+
+        // Copies the components both archetypes have.
+        void CopyRow(uint32_t row, const Archetype &source, uint32_t source_row) noexcept;
+
+        [[nodiscard]] forceinline Entity GetEntity(uint32_t row) const noexcept
+        {
+            ASSERT(row < m_size);
+            return GetEntities(row / m_chunk_capacity)[row % m_chunk_capacity];
+        }
+
+        [[nodiscard]] forceinline void *GetComponent(uint32_t row, ComponentId id) const noexcept
+        {
+            ASSERT(row < m_size && Has(id));
+            return GetColumn(row / m_chunk_capacity, id) + usize_t(row % m_chunk_capacity) * GetComponentInfo(id).size;
+        }
+
+    public:
+        [[nodiscard]] forceinline usize_t size() const noexcept
+        {
+            return m_size;
+        }
+
+        [[nodiscard]] forceinline bool empty() const noexcept
+        {
+            return m_size == 0;
+        }
+
+        [[nodiscard]] forceinline uint32_t GetChunkCapacity() const noexcept
+        {
+            return m_chunk_capacity;
+        }
+
+        [[nodiscard]] forceinline usize_t GetChunkCount() const noexcept
+        {
+            return m_chunks.size();
+        }
+
+        [[nodiscard]] forceinline usize_t GetChunkSize(usize_t chunk) const noexcept
+        {
+            ASSERT(chunk < m_chunks.size());
+            return std::min(usize_t(m_chunk_capacity), m_size - chunk * m_chunk_capacity);
+        }
+
+        [[nodiscard]] forceinline Entity *GetEntities(usize_t chunk) const noexcept
+        {
+            ASSERT(chunk < m_chunks.size());
+            return reinterpret_cast<Entity *>(m_chunks[chunk]);
+        }
+
+        [[nodiscard]] forceinline byte_t *GetColumn(usize_t chunk, ComponentId id) const noexcept
+        {
+            ASSERT(chunk < m_chunks.size() && Has(id));
+            return m_chunks[chunk] + m_offsets[id];
+        }
+
+        template <typename T>
+        [[nodiscard]] forceinline T *GetColumn(usize_t chunk) const noexcept
+        {
+            return reinterpret_cast<T *>(GetColumn(chunk, ComponentIdOf<T>()));
+        }
+
+    private:
+        static constexpr uint32_t NoEdge = UMax;
+
+    private:
+        ComponentMask m_mask;
+        Array<ComponentId> m_components;
+        FixedArray<uint16_t, MAX_COMPONENTS> m_offsets{}; // Column offsets in a chunk.
+        uint32_t m_chunk_capacity{0};
+        Array<byte_t *> m_chunks;
+        usize_t m_size{0};
+
+    private:
+        // Archetypes reached by adding or removing one component, cached by the world.
+        FixedArray<uint32_t, MAX_COMPONENTS> m_add_edges;
+        FixedArray<uint32_t, MAX_COMPONENTS> m_remove_edges;
+    };
+
+}
@@ -0,0 +1,61 @@
+#include "frameworks/ecs/ecs.h"
+
+namespace Be::Framework::ECS
+{
+
+    void CommandBuffer::WriteCommand(ECommand command, Entity entity, ComponentMask mask, ComponentId component, const void *data, usize_t size)
+    {
+        const Header header{mask, entity, component, uint32_t(size), command};
+
+        const auto offset = m_data.size();
+        m_data.resize(offset + sizeof(Header) + size);
+        std::memcpy(m_data.data() + offset, &header, sizeof(Header));
+        if (size != 0)
+        {
+            std::memcpy(m_data.data() + offset + sizeof(Header), data, size);
+        }
+    }
+
+    void CommandBuffer::Playback(World &world)
+    {
+        PROFILER_SCOPE;
+
+        Entity created{};
+        for (usize_t offset = 0; offset < m_data.size();)
+        {
+            Header header;
+            std::memcpy(&header, m_data.data() + offset, sizeof(Header));
+            const auto *data = m_data.data() + offset + sizeof(Header);
+            offset += sizeof(Header) + header.size;
+
+            switch (header.command)
+            {
+            case ECommand::eCreate:
+                created = world.CreateEntity(header.mask);
+                break;
+
+            case ECommand::eInitialize:
+                std::memcpy(world.GetComponent(created, header.component), data, header.size);
+                break;
+
+            case ECommand::eDestroy:
+                world.Destroy(header.entity);
+                break;
+
+            case ECommand::eAdd:
+                if (world.IsAlive(header.entity))
+                {
+                    std::memcpy(world.AddComponent(header.entity, header.component), data, header.size);
+                }
+                break;
+
+            case ECommand::eRemove:
+                world.RemoveComponent(header.entity, header.component);
+                break;
+            }
+        }
+
+        m_data.clear();
+    }
+
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+namespace Be::Framework::ECS
+{
+
+    // Structural changes recorded while the world is iterated and applied later in the
+    // recording order. Commands on entities destroyed in the meantime are ignored.
+    class CommandBuffer final : public MovableOnly
+    {
+    public:
+        CommandBuffer() = default;
+
+    public:
+        template <Component... Ts>
+        void Create(const Ts &...components)
+        {
+            WriteCommand(ECommand::eCreate, {}, ComponentMaskOf<Ts...>(), 0, nullptr, 0);
+            (WriteCommand(ECommand::eInitialize, {}, 0, ComponentIdOf<Ts>(), &components, sizeof(Ts)), ...);
+        }
+
+        void Destroy(Entity entity)
+        {
+            WriteCommand(ECommand::eDestroy, entity, 0, 0, nullptr, 0);
+        }
+
+        template <Component T>
+        void Add(Entity entity, const T &component = {})
+        {
+            WriteCommand(ECommand::eAdd, entity, 0, ComponentIdOf<T>(), &component, sizeof(T));
+        }
+
+        template <Component T>
+        void Remove(Entity entity)
+        {
+            WriteCommand(ECommand::eRemove, entity, 0, ComponentIdOf<T>(), nullptr, 0);
+        }
+
+    public:
+        // Applies the commands and clears the buffer.
+        void Playback(World &world);
+
+        [[nodiscard]] forceinline bool empty() const noexcept
+        {
+            return m_data.empty();
+        }
+
+        forceinline void clear() noexcept
+        {
+            m_data.clear();
+        }
+
+    private:
+        enum class ECommand : uint8_t
+        {
+            eCreate,
+            eInitialize, // A component of the last created entity.
+            eDestroy,
+            eAdd,
+            eRemove,
+        };
+
+        // Followed by size bytes of component data.
+        struct Header
+        {
+            ComponentMask mask;
+            Entity entity;
+            ComponentId component;
+            uint32_t size;
+            ECommand command;
+        };
+
+    private:
+        void WriteCommand(ECommand command, Entity entity, ComponentMask mask, ComponentId component, const void *data, usize_t size);
+
+    private:
+        Array<byte_t> m_data;
+    };
+
+}
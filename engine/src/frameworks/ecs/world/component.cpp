@@ -0,0 +1,32 @@
+#include "frameworks/ecs/ecs.h"
+
+namespace Be::Framework::ECS
+{
+
+    namespace
+    {
+        FixedArray<ComponentInfo, MAX_COMPONENTS> s_components{};
+        Atomic<ComponentId> s_component_count{0};
+    }
+
+    namespace details
+    {
+        ComponentId RegisterComponent(uint32_t size, uint32_t alignment)
+        {
+            VERIFY(alignment <= BE_CACHE_LINE, "Component alignment {} is greater than the chunk alignment.", alignment);
+
+            const auto id = s_component_count.fetch_add(1);
+            VERIFY(id < MAX_COMPONENTS, "Too many component types, the limit is {}.", MAX_COMPONENTS);
+
+            s_components[id] = {size, alignment};
+            return id;
+        }
+    }
+
+    const ComponentInfo &GetComponentInfo(ComponentId id) noexcept
+    {
+        ASSERT(id < s_component_count.load());
+        return s_components[id];
+    }
+
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+namespace Be::Framework::ECS
+{
+
+    class World;
+
+    // Stays valid until the entity is destroyed, a stale handle is detected by the
+    // generation check.
+    using Entity = SlotHandle<World>;
+
+    // Dense ids handed out on first use. Resources shared by systems, such as the
+    // transform hierarchy, take ids from the same space for the access masks of the
+    // system scheduler, so a mask of 64 bits covers all of them.
+    using ComponentId = uint32_t;
+    using ComponentMask = uint64_t;
+
+    inline constexpr ComponentId MAX_COMPONENTS = 64;
+
+    struct ComponentInfo
+    {
+        uint32_t size;
+        uint32_t alignment;
+    };
+
+    // Components are moved between chunks with memcpy and never destroyed.
+    template <typename T>
+    concept Component = std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T> && !std::is_reference_v<T>;
+
+    namespace details
+    {
+        [[nodiscard]] ComponentId RegisterComponent(uint32_t size, uint32_t alignment);
+
+        template <typename T>
+        [[nodiscard]] ComponentId ComponentIdOf()
+        {
+            static const auto s_id = RegisterComponent(uint32_t(sizeof(T)), uint32_t(alignof(T)));
+            return s_id;
+        }
+    }
+
+    [[nodiscard]] const ComponentInfo &GetComponentInfo(ComponentId id) noexcept;
+
+    template <typename T>
+    [[nodiscard]] forceinline ComponentId ComponentIdOf()
+    {
+        return details::ComponentIdOf<std::remove_cv_t<T>>();
+    }
+
+    template <typename... Ts>
+    [[nodiscard]] forceinline ComponentMask ComponentMaskOf()
+    {
+        return (ComponentMask{0} | ... | (ComponentMask{1} << ComponentIdOf<Ts>()));
+    }
+
+}
@@ -0,0 +1,160 @@
+#include "frameworks/ecs/ecs.h"
+
+namespace Be::Framework::ECS
+{
+
+    World::World()
+    {
+        // Entities without components.
+        (void)GetArchetype(0);
+    }
+
+    World::~World() = default;
+
+    Entity World::CreateEntity(ComponentMask mask)
+    {
+        PROFILER_SCOPE;
+
+        uint32_t slot_index{m_free_head};
+        if (slot_index == NoSlot)
+        {
+            VERIFY(m_entities.size() < NoSlot, "Too many entities.");
+            slot_index = uint32_t(m_entities.size());
+            m_entities.push_back({NoArchetype, 0, 1});
+        }
+        else
+        {
+            m_free_head = m_entities[slot_index].row;
+        }
+
+        const auto archetype = GetArchetype(mask);
+        auto &record = m_entities[slot_index];
+        const Entity entity{slot_index, record.generation};
+        record.archetype = archetype;
+        record.row = m_archetypes[archetype]->PushRow(entity);
+        m_size++;
+
+        return entity;
+    }
+
+    void World::Destroy(Entity entity)
+    {
+        PROFILER_SCOPE;
+
+        const auto *found = Find(entity);
+        if (found == nullptr)
+        {
+            return;
+        }
+
+        RemoveRow(found->archetype, found->row);
+
+        auto &record = m_entities[entity.index];
+        record.archetype = NoArchetype;
+        record.row = m_free_head;
+        record.generation = record.generation == UMax ? 1 : record.generation + 1;
+        m_free_head = entity.index;
+        m_size--;
+    }
+
+    bool World::IsAlive(Entity entity) const noexcept
+    {
+        return Find(entity) != nullptr;
+    }
+
+    void *World::AddComponent(Entity entity, ComponentId id)
+    {
+        const auto *record = Find(entity);
+        VERIFY(record != nullptr, "Component added to a destroyed entity.");
+
+        if (!m_archetypes[record->archetype]->Has(id))
+        {
+            MoveEntity(entity, GetEdge(record->archetype, id, true));
+        }
+        return m_archetypes[record->archetype]->GetComponent(record->row, id);
+    }
+
+    void World::RemoveComponent(Entity entity, ComponentId id)
+    {
+        const auto *record = Find(entity);
+        if (record == nullptr || !m_archetypes[record->archetype]->Has(id))
+        {
+            return;
+        }
+        MoveEntity(entity, GetEdge(record->archetype, id, false));
+    }
+
+    void *World::GetComponent(Entity entity, ComponentId id) const noexcept
+    {
+        const auto *record = Find(entity);
+        if (record == nullptr || !m_archetypes[record->archetype]->Has(id))
+        {
+            return nullptr;
+        }
+        return m_archetypes[record->archetype]->GetComponent(record->row, id);
+    }
+
+    const World::EntityRecord *World::Find(Entity entity) const noexcept
+    {
+        if (entity.index >= m_entities.size() || entity.generation == 0)
+        {
+            return nullptr;
+        }
+        const auto &record = m_entities[entity.index];
+        return record.generation == entity.generation && record.archetype != NoArchetype ? &record : nullptr;
+    }
+
+    uint32_t World::GetArchetype(ComponentMask mask)
+    {
+        const auto found = m_archetype_lookup.find(mask);
+        if (found != m_archetype_lookup.end())
+        {
+            return found->second;
+        }
+
+        const auto index = uint32_t(m_archetypes.size());
+        m_archetypes.push_back(MakeUnique<Archetype>(mask));
+        m_archetype_lookup.insert({mask, index});
+        return index;
+    }
+
+    uint32_t World::GetEdge(uint32_t archetype, ComponentId id, bool add)
+    {
+        // Archetypes are never destroyed, so the edges stay valid.
+        auto &edges = add ? m_archetypes[archetype]->m_add_edges : m_archetypes[archetype]->m_remove_edges;
+        if (edges[id] == Archetype::NoEdge)
+        {
+            const auto mask = m_archetypes[archetype]->GetMask();
+            const auto bit = ComponentMask{1} << id;
+            edges[id] = GetArchetype(add ? mask | bit : mask & ~bit);
+        }
+        return edges[id];
+    }
+
+    void World::MoveEntity(Entity entity, uint32_t archetype)
+    {
+        PROFILER_SCOPE;
+
+        auto &record = m_entities[entity.index];
+        auto &source = *m_archetypes[record.archetype];
+        auto &target = *m_archetypes[archetype];
+
+        const auto row = target.PushRow(entity);
+        target.CopyRow(row, source, record.row);
+        RemoveRow(record.archetype, record.row);
+
+        record.archetype = archetype;
+        record.row = row;
+    }
+
+    // The last row of the archetype is moved into the removed one.
+    void World::RemoveRow(uint32_t archetype, uint32_t row)
+    {
+        const auto moved = m_archetypes[archetype]->RemoveRow(row);
+        if (moved)
+        {
+            m_entities[moved.index].row = row;
+        }
+    }
+
+}
@@ -0,0 +1,181 @@
+#pragma once
+
+namespace Be::Framework::ECS
+{
+
+    // Entities and their components, grouped by archetype. Structural changes (creating
+    // and destroying entities, adding and removing components) move rows between chunks,
+    // they are not thread safe and invalidate component pointers. Queries and component
+    // access can run on several threads at once, systems record structural changes into
+    // a CommandBuffer instead.
+    class World final : public Noncopyable
+    {
+    public:
+        World();
+        ~World();
+
+    public:
+        template <Component... Ts>
+        [[nodiscard]] Entity Create(const Ts &...components)
+        {
+            const auto entity = CreateEntity(ComponentMaskOf<Ts...>());
+            (std::construct_at(static_cast<Ts *>(GetComponent(entity, ComponentIdOf<Ts>())), components), ...);
+            return entity;
+        }
+
+        void Destroy(Entity entity);
+
+        [[nodiscard]] bool IsAlive(Entity entity) const noexcept;
+
+        // Replaces the value when the entity already has the component.
+        template <Component T>
+        void Add(Entity entity, const T &component = {})
+        {
+            std::construct_at(static_cast<T *>(AddComponent(entity, ComponentIdOf<T>())), component);
+        }
+
+        template <Component T>
+        void Remove(Entity entity)
+        {
+            RemoveComponent(entity, ComponentIdOf<T>());
+        }
+
+        template <Component T>
+        [[nodiscard]] bool Has(Entity entity) const
+        {
+            return GetComponent(entity, ComponentIdOf<T>()) != nullptr;
+        }
+
+        // nullptr when the entity has no such component.
+        template <Component T>
+        [[nodiscard]] T *Get(Entity entity) const
+        {
+            return static_cast<T *>(GetComponent(entity, ComponentIdOf<T>()));
+        }
+
+    public:
+        // Type erased versions of the above, the data of new components is left uninitialized.
+        [[nodiscard]] Entity CreateEntity(ComponentMask mask);
+        [[nodiscard]] void *AddComponent(Entity entity, ComponentId id);
+        void RemoveComponent(Entity entity, ComponentId id);
+        [[nodiscard]] void *GetComponent(Entity entity, ComponentId id) const noexcept;
+
+    public:
+        // func(count, entities, columns...) for every chunk of the entities that have all
+        // of the components, one column pointer per component. Const components are
+        // read only.
+        template <Component... Ts, typename F>
+        void ForEachChunk(F &&func) const
+        {
+            const auto mask = ComponentMaskOf<Ts...>();
+            for (const auto &archetype : m_archetypes)
+            {
+                if (!archetype->Matches(mask))
+                {
+                    continue;
+                }
+                for (usize_t chunk = 0; chunk < archetype->GetChunkCount(); chunk++)
+                {
+                    func(archetype->GetChunkSize(chunk), const_cast<const Entity *>(archetype->GetEntities(chunk)), archetype->template GetColumn<Ts>(chunk)...);
+                }
+            }
+        }
+
+        // func(entity, components...) for every entity that has all of the components.
+        template <Component... Ts, typename F>
+        void ForEach(F &&func) const
+        {
+            ForEachChunk<Ts...>([&func](usize_t count, const Entity *entities, Ts *...columns)
+                                {
+                                    for (usize_t i = 0; i < count; i++)
+                                    {
+                                        func(entities[i], columns[i]...);
+                                    } });
+        }
+
+        // Same as ForEachChunk with blocks of chunks run as tasks. run(task_count, func)
+        // has to call func(task_index) for every task and return once all of them are done,
+        // it may run them inline. The blocks only depend on task_count and the chunks.
+        template <Component... Ts, typename RunTasks, typename F>
+        void ForEachChunkParallel(usize_t task_count, RunTasks &&run, F &&func) const
+        {
+            PROFILER_SCOPE;
+
+            constexpr usize_t MIN_BLOCK_SIZE = 4;
+
+            const auto mask = ComponentMaskOf<Ts...>();
+            Array<Pair<const Archetype *, usize_t>> chunks;
+            for (const auto &archetype : m_archetypes)
+            {
+                if (archetype->Matches(mask))
+                {
+                    for (usize_t chunk = 0; chunk < archetype->GetChunkCount(); chunk++)
+                    {
+                        chunks.push_back({archetype.get(), chunk});
+                    }
+                }
+            }
+
+            const auto count = chunks.size();
+            const auto block_size = std::max((count + task_count - 1) / std::max(task_count, usize_t(1)), MIN_BLOCK_SIZE);
+            const auto block_count = (count + block_size - 1) / block_size;
+
+            const auto process = [&](usize_t task)
+            {
+                const auto first = task * block_size;
+                for (auto i = first; i < std::min(first + block_size, count); i++)
+                {
+                    const auto [archetype, chunk] = chunks[i];
+                    func(archetype->GetChunkSize(chunk), const_cast<const Entity *>(archetype->GetEntities(chunk)), archetype->template GetColumn<Ts>(chunk)...);
+                }
+            };
+
+            run(block_count, process);
+        }
+
+    public:
+        // Live entities.
+        [[nodiscard]] forceinline usize_t size() const noexcept
+        {
+            return m_size;
+        }
+
+        [[nodiscard]] forceinline bool empty() const noexcept
+        {
+            return m_size == 0;
+        }
+
+        [[nodiscard]] forceinline usize_t GetArchetypeCount() const noexcept
+        {
+            return m_archetypes.size();
+        }
+
+    private:
+        static constexpr uint32_t NoArchetype = UMax;
+        static constexpr uint32_t NoSlot = UMax;
+
+        // For a live entity the archetype and the row in it, for a free slot row is the
+        // next free slot.
+        struct EntityRecord
+        {
+            uint32_t archetype;
+            uint32_t row;
+            uint32_t generation;
+        };
+
+    private:
+        [[nodiscard]] const EntityRecord *Find(Entity entity) const noexcept;
+        [[nodiscard]] uint32_t GetArchetype(ComponentMask mask);
+        [[nodiscard]] uint32_t GetEdge(uint32_t archetype, ComponentId id, bool add);
+        void MoveEntity(Entity entity, uint32_t archetype);
+        void RemoveRow(uint32_t archetype, uint32_t row);
+
+    private:
+        Array<UniquePtr<Archetype>> m_archetypes;
+        FlatHashMap<ComponentMask, uint32_t> m_archetype_lookup;
+        Array<EntityRecord> m_entities;
+        uint32_t m_free_head{NoSlot};
+        usize_t m_size{0};
+    };
+
+}
@@ -80,13 +80,11 @@ namespace Be::Framework::RHI
     {
         PROFILER_SCOPE;
 
-        Array<vk::RenderingAttachmentInfo> attachment_infos;
+        SmallArray<vk::RenderingAttachmentInfo, MAX_COLOR_ATTACHMENTS> attachment_infos;
         attachment_infos.reserve(desc.color_attachments.size());
-        uint32_t i{0};
         for (const auto &a : desc.color_attachments)
         {
             attachment_infos.emplace_back(a.attachment_info);
-            i++;
         }
 
         vk::RenderingInfo rendering_info{};
@@ -930,7 +928,17 @@ namespace Be::Framework::RHI
 
         if (m_internal_state.flags_set_dirty != 0)
         {
-            Array<RhiWriteBindingDesc> writes;
+            m_scratch_allocator.Reset();
+
+            usize_t write_count{0};
+            ForEachBit(m_internal_state.flags_set_dirty,
+                       [this, &write_count](uint32_t set)
+                       {
+                           write_count += BitCount(m_internal_state.program->GetBindingMask(set));
+                       });
+
+            RhiWriteBindings writes{&m_scratch_resource};
+            writes.reserve(write_count);
 
             ForEachBit(m_internal_state.flags_set_dirty,
                        [this, &writes](uint32_t set)
@@ -943,7 +951,7 @@ namespace Be::Framework::RHI
         }
     }
 
-    void RhiCommandBuffer::FlushDescriptorSet(uint32_t set, Array<RhiWriteBindingDesc> &writes)
+    void RhiCommandBuffer::FlushDescriptorSet(uint32_t set, RhiWriteBindings &writes)
     {
         PROFILER_SCOPE;
 
@@ -123,6 +123,8 @@ namespace Be::Framework::RHI
 
     class RhiCommandBuffer final : public RefCounter, public Noncopyable
     {
+        POOLED_ALLOCATION(RhiCommandBuffer);
+
     public:
         RhiCommandBuffer(RhiDriver &driver, vk::CommandBuffer handle, ERhiQueueType type);
 
@@ -238,11 +240,15 @@ namespace Be::Framework::RHI
         void BeginEvent(const String &name);
         void EndEvent();
 
+    private:
+        // One set fits inline, several dirty sets spill into the scratch memory.
+        using RhiWriteBindings = PmrSmallArray<RhiWriteBindingDesc, MAX_BINDINGS>;
+
     private:
         void SetImageBarrierImpl(const RhiImageBarrier &barrier);
         void FlushBarriers();
         void FlushState();
-        void FlushDescriptorSet(uint32_t set, Array<RhiWriteBindingDesc> &writes);
+        void FlushDescriptorSet(uint32_t set, RhiWriteBindings &writes);
 
     private:
         RhiDriver &m_driver;
@@ -286,6 +292,14 @@ namespace Be::Framework::RHI
             bool flags_set_dirty{0};
         } m_internal_state{};
 
+    private:
+        // Scratch memory for per-flush containers, reset on every FlushState.
+        static constexpr usize_t SCRATCH_MEMORY_SIZE = sizeof(RhiWriteBindingDesc) * MAX_DESCRIPTOR_SETS * MAX_BINDINGS + MaxAlignSize;
+
+        MallocMemoryArena m_scratch_arena{SCRATCH_MEMORY_SIZE, EMemoryTag::eRhi};
+        LinearAllocator m_scratch_allocator{m_scratch_arena};
+        MonotonicMemoryResource m_scratch_resource{m_scratch_allocator};
+
     private:
         bool m_ended{true};
 
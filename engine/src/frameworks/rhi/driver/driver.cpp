@@ -5,9 +5,11 @@ namespace Be::Framework::RHI
 
     RhiDriver::RhiDriver(const RhiDriverCreateInfo &create_info) noexcept
         : m_window{create_info.window},
-          m_device{create_info.device}
+          m_device{create_info.device},
+          m_frame_count{create_info.frame_count}
     {
         PROFILER_SCOPE;
+        MEMORY_TAG_SCOPE(EMemoryTag::eRhi);
 
         if (!m_device)
         {
@@ -40,6 +42,8 @@ namespace Be::Framework::RHI
 
         m_resource_uploader.Init(this);
 
+        m_frame_fence = CreateFence();
+
         LOG_INFO("RhiDriver is created.");
     }
 
@@ -47,6 +51,10 @@ namespace Be::Framework::RHI
     {
         PROFILER_SCOPE;
 
+        // Resources of the frames in flight are deleted below.
+        m_device->WaitIdle();
+        m_frame_fence.Reset();
+
         while (DeleteEnqueuedResources())
         {
         }
@@ -88,6 +96,12 @@ namespace Be::Framework::RHI
     {
         PROFILER_SCOPE;
 
+        m_frame_value++;
+        if (m_frame_value > m_frame_count)
+        {
+            m_frame_fence->Wait(m_frame_value - m_frame_count);
+        }
+
         m_resource_uploader.BeginFrame();
         DeleteEnqueuedResources();
         return m_swapchain->NextImage();
@@ -97,6 +111,11 @@ namespace Be::Framework::RHI
     {
         PROFILER_SCOPE;
 
+        // Ordered after everything submitted to the queue during the frame.
+        auto &queue = GetQueue(ERhiQueueType::eGraphics);
+        queue.AddSignalFence(*m_frame_fence, m_frame_value);
+        queue.Submit();
+
         m_swapchain->Present();
         m_resource_uploader.EndFrame();
     }
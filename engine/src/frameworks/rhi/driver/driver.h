@@ -111,6 +111,23 @@ namespace Be::Framework::RHI
         uint32_t BeginFrame() noexcept;
         void EndFrame() noexcept;
 
+        // Frames are numbered from 1. BeginFrame waits until the GPU has finished the frame
+        // frame_count frames back, so the per-frame resources of GetFrameIndex are free.
+        [[nodiscard]] forceinline uint64_t GetFrameValue() const noexcept
+        {
+            return m_frame_value;
+        }
+
+        [[nodiscard]] forceinline uint32_t GetFrameIndex() const noexcept
+        {
+            return uint32_t(m_frame_value % m_frame_count);
+        }
+
+        [[nodiscard]] forceinline uint32_t GetFrameCount() const noexcept
+        {
+            return m_frame_count;
+        }
+
     public:
         [[nodiscard]] RhiCommandBufferHandle CreateCommandBuffer(vk::CommandPool pool, ERhiQueueType type) noexcept;
         [[nodiscard]] RhiCommandBufferHandle CreateCommandBuffer(ERhiQueueType type) noexcept;
@@ -186,6 +203,12 @@ namespace Be::Framework::RHI
         VmaAllocator m_vma_allocator{VK_NULL_HANDLE};
         UniquePtr<RhiSwapchain> m_swapchain{nullptr};
 
+    private:
+        // Signalled with the frame value on the graphics queue at the end of every frame.
+        RhiFenceHandle m_frame_fence;
+        uint64_t m_frame_value{0};
+        uint32_t m_frame_count;
+
     private:
         Map<ERhiQueueType, RhiQueueHandle> m_command_queues;
 
@@ -71,7 +71,7 @@ namespace Be::Framework::RHI
 
         if (!m_command_lists.empty() || !m_wait_semaphores.empty() || !m_signal_semaphores.empty())
         {
-            Array<vk::CommandBufferSubmitInfo> buffer_submit_infos;
+            SmallArray<vk::CommandBufferSubmitInfo, 16> buffer_submit_infos;
             buffer_submit_infos.reserve(m_command_lists.size());
             for (auto &command_list : m_command_lists)
             {
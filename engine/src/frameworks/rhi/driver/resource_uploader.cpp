@@ -7,7 +7,7 @@ namespace Be::Framework::RHI
     RhiResourceUploader::~RhiResourceUploader() noexcept
     {
         m_free_list.clear();
-        m_wait_callback_list.clear();
+        m_wait_callback_overflow.clear();
         m_wait_transfer_list.clear();
         m_fence.Reset();
     }
@@ -20,7 +20,6 @@ namespace Be::Framework::RHI
         m_fence = m_driver->CreateFence();
 
         m_free_list.reserve(32);
-        m_wait_callback_list.reserve(32);
         m_wait_transfer_list.reserve(32);
     }
 
@@ -138,14 +137,7 @@ namespace Be::Framework::RHI
         if (upload_info.unified_queue)
         {
             m_driver->GetQueue(upload_info.target_cmd->GetQueueType()).AddCommandBuffer(*upload_info.target_cmd);
-            if (upload_info.callback)
-            {
-                m_wait_callback_list.push_back(std::move(upload_info));
-            }
-            else
-            {
-                m_free_list.push_back(std::move(upload_info));
-            }
+            CompleteUpload(std::move(upload_info));
         }
         else
         {
@@ -169,22 +161,20 @@ namespace Be::Framework::RHI
 
         const auto value = m_fence->GetCurrentValue();
 
-        for (auto &u : m_wait_transfer_list)
+        for (usize_t i = 0; i < m_wait_transfer_list.size();)
         {
-            if (u.fence_wait_value <= value)
+            auto &u = m_wait_transfer_list[i];
+            if (u.fence_wait_value > value)
             {
-                m_driver->GetQueue(u.target_cmd->GetQueueType()).AddCommandBuffer(*u.target_cmd);
-
-                m_wait_transfer_list.pop_back();
-                if (u.callback)
-                {
-                    m_wait_callback_list.push_back(std::move(u));
-                }
-                else
-                {
-                    m_free_list.push_back(std::move(u));
-                }
+                i++;
+                continue;
             }
+
+            m_driver->GetQueue(u.target_cmd->GetQueueType()).AddCommandBuffer(*u.target_cmd);
+            CompleteUpload(std::move(u));
+
+            u = std::move(m_wait_transfer_list.back());
+            m_wait_transfer_list.pop_back();
         }
     }
 
@@ -192,15 +182,52 @@ namespace Be::Framework::RHI
     {
         PROFILER_SCOPE;
 
-        EXCLUSIVE_LOCK(m_mutex);
+        // Callbacks run without the lock, it is taken once per batch to recycle the infos.
+        // Bounded by the ring capacity so uploads completing meanwhile wait for the next frame.
+        FixedArray<UploadInfo, 16> completed;
+        for (usize_t total = 0; total < CompletedQueueCapacity;)
+        {
+            const auto count = m_wait_callback_queue.PopBatch(completed);
+            if (count == 0)
+            {
+                break;
+            }
+            total += count;
 
-        for (auto &u : m_wait_callback_list)
+            for (usize_t i = 0; i < count; i++)
+            {
+                completed[i].callback();
+                completed[i].callback = {};
+            }
+
+            EXCLUSIVE_LOCK(m_mutex);
+            for (usize_t i = 0; i < count; i++)
+            {
+                m_free_list.push_back(std::move(completed[i]));
+            }
+        }
+
+        EXCLUSIVE_LOCK(m_mutex);
+        for (auto &u : m_wait_callback_overflow)
         {
             u.callback();
             u.callback = {};
             m_free_list.push_back(std::move(u));
         }
-        m_wait_callback_list.clear();
+        m_wait_callback_overflow.clear();
+    }
+
+    // Called with m_mutex held.
+    void RhiResourceUploader::CompleteUpload(UploadInfo &&upload_info) noexcept
+    {
+        if (!upload_info.callback)
+        {
+            m_free_list.push_back(std::move(upload_info));
+        }
+        else if (!m_wait_callback_queue.TryPush(std::move(upload_info)))
+        {
+            m_wait_callback_overflow.push_back(std::move(upload_info));
+        }
     }
 
     void RhiResourceUploader::AllocateUploadInfo(uint64_t staging_size, UploadInfo &upload_info) noexcept
@@ -44,12 +44,20 @@ namespace Be::Framework::RHI
     private:
         void AllocateUploadInfo(uint64_t staging_size, UploadInfo &upload_info) noexcept;
         void SubmitUpload(UploadInfo &upload_info) noexcept;
+        void CompleteUpload(UploadInfo &&upload_info) noexcept;
+
+    private:
+        static constexpr usize_t CompletedQueueCapacity = 256;
 
     private:
         Array<UploadInfo> m_free_list;
-        Array<UploadInfo> m_wait_callback_list;
         Array<UploadInfo> m_wait_transfer_list;
 
+        // Uploads waiting for their callback. Filled from any thread, drained by EndFrame;
+        // the overflow list (guarded by m_mutex) takes what does not fit into the ring.
+        MpmcRingBuffer<UploadInfo, CompletedQueueCapacity> m_wait_callback_queue;
+        Array<UploadInfo> m_wait_callback_overflow;
+
         RhiFenceHandle m_fence;
         uint64_t m_fence_value{0u};
 
@@ -22,8 +22,8 @@ namespace Be::Framework::RHI
 
     private:
         ERhiResourceState m_resource_state{ERhiResourceState::eUnknown};
-        Map<Pair<uint32_t, uint32_t>, ERhiResourceState> m_subresource_states;
-        Map<ERhiResourceState, usize_t> m_subresource_state_groups;
+        FlatHashMap<Pair<uint32_t, uint32_t>, ERhiResourceState> m_subresource_states;
+        FlatHashMap<ERhiResourceState, usize_t> m_subresource_state_groups;
     };
 
 }
\ No newline at end of file
@@ -17,6 +17,8 @@ namespace Be::Framework::RHI
 
     class RhiBuffer final : public RhiMemoryResource
     {
+        POOLED_ALLOCATION(RhiBuffer);
+
     public:
         RhiBuffer(RhiDriver &driver, const RhiBufferDesc &desc) noexcept;
 
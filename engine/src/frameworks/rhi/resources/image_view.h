@@ -29,6 +29,8 @@ namespace Be::Framework::RHI
 
     class RhiImageView final : public RhiResourceView
     {
+        POOLED_ALLOCATION(RhiImageView);
+
     public:
         RhiImageView(RhiDriver &driver, const RhiImageViewDesc &view_desc) noexcept;
 
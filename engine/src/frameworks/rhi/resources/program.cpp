@@ -3,13 +3,15 @@
 namespace Be::Framework::RHI
 {
 
-    static const Map<vk::ShaderStageFlagBits, uint8_t> SHADER_STAGE_INDECIES{
-        std::make_pair(vk::ShaderStageFlagBits::eVertex, 0),
-        std::make_pair(vk::ShaderStageFlagBits::eFragment, 1),
-        std::make_pair(vk::ShaderStageFlagBits::eCompute, 2),
-        std::make_pair(vk::ShaderStageFlagBits::eTaskEXT, 3),
-        std::make_pair(vk::ShaderStageFlagBits::eMeshEXT, 4),
-    };
+    static constexpr auto SHADER_STAGE_INDECIES = MakeStaticMap<vk::ShaderStageFlagBits, uint8_t>({
+                                                                                                     {vk::ShaderStageFlagBits::eVertex, 0},
+                                                                                                     {vk::ShaderStageFlagBits::eFragment, 1},
+                                                                                                     {vk::ShaderStageFlagBits::eCompute, 2},
+                                                                                                     {vk::ShaderStageFlagBits::eTaskEXT, 3},
+                                                                                                     {vk::ShaderStageFlagBits::eMeshEXT, 4},
+                                                                                                 },
+                                                                                                 UINT8_MAX);
+    STATIC_ASSERT(SHADER_STAGE_INDECIES.size() == RhiProgram::SHADER_STAGES.size());
 
     RhiProgram::RhiProgram(RhiDriver &driver, const Array<RhiShaderHandle> &shaders) noexcept
         : RhiResource{driver},
@@ -94,8 +96,8 @@ namespace Be::Framework::RHI
             vk::DescriptorType bindless_type;
             Map<vk::DescriptorType, uint32_t> descriptor_count;
 
-            Array<vk::DescriptorSetLayoutBinding> vk_bindings;
-            Array<vk::DescriptorBindingFlags> vk_bindings_flags;
+            SmallArray<vk::DescriptorSetLayoutBinding, MAX_BINDINGS> vk_bindings;
+            SmallArray<vk::DescriptorBindingFlags, MAX_BINDINGS> vk_bindings_flags;
 
             ForEachBit(
                 binding_mask,
@@ -163,7 +165,7 @@ namespace Be::Framework::RHI
     {
         PROFILER_SCOPE;
 
-        Array<vk::ShaderCreateInfoEXT> cis;
+        SmallArray<vk::ShaderCreateInfoEXT, SHADER_STAGES.size()> cis;
         cis.reserve(shaders.size());
 
         for (uint32_t i = 0; i < shaders.size(); i++)
@@ -191,7 +193,7 @@ namespace Be::Framework::RHI
             }
         }
 
-        Array<vk::ShaderEXT> shaders_ext;
+        SmallArray<vk::ShaderEXT, SHADER_STAGES.size()> shaders_ext;
         shaders_ext.resize(shaders.size());
 
         VK_VERIFY(m_device.VkHandle().createShadersEXT(static_cast<uint32_t>(cis.size()), cis.data(), nullptr, shaders_ext.data()),
@@ -200,7 +202,8 @@ namespace Be::Framework::RHI
         m_shaders.resize(SHADER_STAGES.size());
         for (uint32_t i = 0; i < cis.size(); i++)
         {
-            const auto index = SHADER_STAGE_INDECIES.at(cis.at(i).stage);
+            const auto index = SHADER_STAGE_INDECIES[cis[i].stage];
+            ASSERT(index < m_shaders.size());
             m_shaders[index] = shaders_ext[i];
         }
     }
@@ -209,14 +212,14 @@ namespace Be::Framework::RHI
     {
         PROFILER_SCOPE;
 
-        WriteBindings({binding});
+        WriteBindings({&binding, 1});
     }
 
-    void RhiProgram::WriteBindings(const Array<RhiWriteBindingDesc> &bindings) const noexcept
+    void RhiProgram::WriteBindings(Span<const RhiWriteBindingDesc> bindings) const noexcept
     {
         PROFILER_SCOPE;
 
-        Array<vk::WriteDescriptorSet> writes;
+        SmallArray<vk::WriteDescriptorSet, MAX_BINDINGS> writes;
         for (const auto &b : bindings)
         {
             const auto &s = b.view->GetWriteDescriptorSet();
@@ -69,9 +69,9 @@ namespace Be::Framework::RHI
         {
             PROFILER_SCOPE;
             
-            ASSERT(m_binding_names.contains(name));
-            const auto &p = m_binding_names.at(name);
-            return m_bindings[p.first][p.second];
+            const auto it = m_binding_names.find(name);
+            ASSERT(it != m_binding_names.end());
+            return m_bindings[it->second.first][it->second.second];
         }
 
         void GetBindingNames(OUT Set<RhiProgramBindingName>& names) const noexcept;
@@ -94,7 +94,7 @@ namespace Be::Framework::RHI
 
     public:
         void WriteBinding(const RhiWriteBindingDesc &binding) const noexcept;
-        void WriteBindings(const Array<RhiWriteBindingDesc> &bindings) const noexcept;
+        void WriteBindings(Span<const RhiWriteBindingDesc> bindings) const noexcept;
 
     public:
         [[nodiscard]] forceinline HashValue Hash() const noexcept
@@ -112,7 +112,7 @@ namespace Be::Framework::RHI
     private:
         RhiProgramBinding m_bindings[MAX_DESCRIPTOR_SETS][MAX_BINDINGS]; // [set, binding]
         uint32_t m_binding_masks[MAX_DESCRIPTOR_SETS];                   // [set]
-        Map<RhiProgramBindingName, Pair<uint32_t, uint32_t>> m_binding_names;
+        FlatHashMap<RhiProgramBindingName, Pair<uint32_t, uint32_t>> m_binding_names;
 
     private:
         vk::PipelineBindPoint m_pipeline_bind_point;
@@ -18,23 +18,20 @@ namespace Be::Framework::RHI
         }
     }
 
+    static constexpr auto IMAGE_FORMAT_ASPECTS = MakeStaticMap<vk::Format, vk::ImageAspectFlags>({
+                                                                                                   {vk::Format::eD32SfloatS8Uint, vk::ImageAspectFlagBits::eDepth | vk::ImageAspectFlagBits::eStencil},
+                                                                                                   {vk::Format::eD24UnormS8Uint, vk::ImageAspectFlagBits::eDepth | vk::ImageAspectFlagBits::eStencil},
+                                                                                                   {vk::Format::eD16UnormS8Uint, vk::ImageAspectFlagBits::eDepth | vk::ImageAspectFlagBits::eStencil},
+                                                                                                   {vk::Format::eD16Unorm, vk::ImageAspectFlagBits::eDepth},
+                                                                                                   {vk::Format::eD32Sfloat, vk::ImageAspectFlagBits::eDepth},
+                                                                                                   {vk::Format::eX8D24UnormPack32, vk::ImageAspectFlagBits::eDepth},
+                                                                                                   {vk::Format::eS8Uint, vk::ImageAspectFlagBits::eStencil},
+                                                                                               },
+                                                                                               vk::ImageAspectFlagBits::eColor);
+
     vk::ImageAspectFlags ImageFormatToImageAspect(vk::Format format) noexcept
     {
-        switch (format)
-        {
-        case vk::Format::eD32SfloatS8Uint:
-        case vk::Format::eD24UnormS8Uint:
-        case vk::Format::eD16UnormS8Uint:
-            return vk::ImageAspectFlagBits::eDepth | vk::ImageAspectFlagBits::eStencil;
-        case vk::Format::eD16Unorm:
-        case vk::Format::eD32Sfloat:
-        case vk::Format::eX8D24UnormPack32:
-            return vk::ImageAspectFlagBits::eDepth;
-        case vk::Format::eS8Uint:
-            return vk::ImageAspectFlagBits::eStencil;
-        default:
-            return vk::ImageAspectFlagBits::eColor;
-        }
+        return IMAGE_FORMAT_ASPECTS[format];
     }
 
     vk::BufferUsageFlags ResourceBindToBufferUsage(ERhiBindFlagBits bind_flags) noexcept
@@ -13,9 +13,15 @@ namespace Be::Framework::Threading
         catch (...)
         {            
         }
-        if (m_parent)
+
+        // release self, the task is finished once all children are done too. A finished
+        // task may be recycled by its pool right away, so this is the last access to it.
+        auto *parent = m_parent;
+        m_children.fetch_sub(1, std::memory_order::release);
+
+        if (parent)
         {
-            m_parent->ChildCompleted();
+            parent->ChildCompleted();
         }
     }
 
@@ -38,7 +38,7 @@ namespace Be::Framework::Threading
     public:
         [[nodiscard]] forceinline bool IsFinished() const noexcept
         {
-            return (m_children.load(std::memory_order::relaxed) == 0);
+            return (m_children.load(std::memory_order::acquire) == 0);
         }
 
         [[nodiscard]] forceinline bool ReadyForExecute() const noexcept
@@ -67,7 +67,7 @@ namespace Be::Framework::Threading
         {
             PROFILER_SCOPE;
             
-            m_children.fetch_sub(1, std::memory_order::relaxed);
+            m_children.fetch_sub(1, std::memory_order::release);
         }
 
     private:
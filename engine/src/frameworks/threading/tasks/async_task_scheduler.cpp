@@ -35,6 +35,8 @@ namespace Be::Framework::Threading
         std::condition_variable wait_for_job_cv{};
 
         AtomicFlag running;
+
+        AsyncTaskSchedulerDesc desc{};
     }
 
     namespace ThreadState
@@ -50,16 +52,29 @@ namespace Be::Framework::Threading
         FixedArray<AsyncTaskConcurrentQueue, 32> parents_queues;
         FixedArray<AsyncTaskConcurrentQueue, 32> children_queues;
 
+        struct ThreadMemory
+        {
+            UniquePtr<VirtualMemoryArena> arena{nullptr};
+            UniquePtr<FrameRingAllocator> frame_allocator{nullptr};
+        };
+
+        // created by the owning thread, so the pages are first touched on its node
+        FixedArray<ThreadMemory, 32> memory;
+
         AsyncTask *AllocateTask() noexcept
         {
             PROFILER_SCOPE;
 
-            if (task_pool_index >= MAX_TASKS_COUNT) [[unlikely]]
-            {
-                FATAL("Too much AsyncTask created");
-            }
             const auto index = task_pool_index++;
             auto job_ptr = &task_pool[index & (MAX_TASKS_COUNT - 1u)]; // Ring buffer, no need to dealocate job
+
+            // A slot is reused once the ring wraps, its previous task has to be finished by then.
+            if (index >= MAX_TASKS_COUNT && !job_ptr->IsFinished()) [[unlikely]]
+            {
+                FATAL("Too many AsyncTasks in flight");
+            }
+            std::destroy_at(job_ptr);
+
             return job_ptr;
         }
 
@@ -111,7 +126,13 @@ namespace Be::Framework::Threading
 
     void AsyncTaskScheduler::Create(uint32_t thread_count) noexcept
     {
-        SchedulerState::thread_count = thread_count;
+        Create(AsyncTaskSchedulerDesc{.thread_count = thread_count});
+    }
+
+    void AsyncTaskScheduler::Create(const AsyncTaskSchedulerDesc &desc) noexcept
+    {
+        SchedulerState::desc = desc;
+        SchedulerState::thread_count = desc.thread_count;
         if (SchedulerState::thread_count == 0)
         {
             SchedulerState::thread_count = ThreadUtils::MaxThreadCount();
@@ -135,14 +156,25 @@ namespace Be::Framework::Threading
     {
         Stop();
 
+        for (auto &m : ThreadState::memory)
+        {
+            m.frame_allocator.reset();
+            m.arena.reset();
+        }
+
         LOG_INFO("AsyncTaskScheduler is destroyed.");
     }
 
     void AsyncTaskScheduler::Start() noexcept
     {
+        MEMORY_TAG_SCOPE(EMemoryTag::eThreading);
+
         ThreadUtils::ResetThreadIndecies();
 
         SchedulerState::main_thread_index = ThreadUtils::GetCurrentThreadIndex();
+        ThreadState::thread_index = SchedulerState::main_thread_index;
+        CreateThreadMemory();
+
         SchedulerState::thread_start_counter = SchedulerState::thread_count - 1;
         SchedulerState::thread_stop_counter = SchedulerState::thread_count - 1;
         SchedulerState::running.test_and_set();
@@ -187,6 +219,7 @@ namespace Be::Framework::Threading
     {
         ThreadState::thread_index = ThreadUtils::GetCurrentThreadIndex();
         SetAffinity(ThreadState::thread_index);
+        CreateThreadMemory();
 
         std::unique_lock mutex_lock{ThreadState::mutex};
         SchedulerState::thread_start_counter--;
@@ -211,14 +244,68 @@ namespace Be::Framework::Threading
 
         LOG_INFO("Thread #{} destroyed.", ThreadState::thread_index);
 
+        // Counters still batched by the thread are lost once it exits.
+        MemoryTracker::FlushThread();
+
         SchedulerState::thread_stop_counter--;
     }
 
+    void AsyncTaskScheduler::CreateThreadMemory() noexcept
+    {
+        PROFILER_SCOPE;
+        MEMORY_TAG_SCOPE(EMemoryTag::eThreading);
+
+        const auto &desc = SchedulerState::desc;
+        auto &memory = ThreadState::memory[ThreadState::thread_index];
+
+        auto numa_node = Platform::AnyNumaNode;
+        if (desc.numa_local_memory && Platform::GetNumaNodeCount() > 1)
+        {
+            numa_node = Platform::GetCurrentNumaNode();
+            if (!Platform::SetThreadNumaNode(numa_node))
+            {
+                LOG_WARN("Thread #{}: failed to set NUMA memory policy.", ThreadState::thread_index);
+            }
+        }
+
+        if (desc.thread_frame_memory_size == 0 || memory.frame_allocator)
+        {
+            return;
+        }
+
+        memory.arena = MakeUnique<VirtualMemoryArena>(desc.thread_frame_memory_size * desc.thread_frame_count, EMemoryTag::eThreading, numa_node);
+        memory.frame_allocator = MakeUnique<FrameRingAllocator>(*memory.arena, desc.thread_frame_count);
+    }
+
+    FrameRingAllocator *AsyncTaskScheduler::GetThreadFrameAllocator() noexcept
+    {
+        return ThreadState::memory[ThreadState::thread_index].frame_allocator.get();
+    }
+
+    void AsyncTaskScheduler::BeginFrame(uint64_t frame_value, uint64_t completed_frame_value) noexcept
+    {
+        PROFILER_SCOPE;
+
+        for (auto &m : ThreadState::memory)
+        {
+            if (m.frame_allocator)
+            {
+                m.frame_allocator->RetireFrames(completed_frame_value);
+                m.frame_allocator->BeginFrame(frame_value);
+            }
+        }
+    }
+
     AsyncTask *AsyncTaskScheduler::AllocateTask() noexcept
     {
         return ThreadState::AllocateTask();
     }
 
+    bool AsyncTaskScheduler::IsRunning() noexcept
+    {
+        return SchedulerState::running.test();
+    }
+
     void AsyncTaskScheduler::Schedule(AsyncTask *task, EThreadType thread_type) noexcept
     {
         PROFILER_SCOPE;
@@ -268,7 +355,7 @@ namespace Be::Framework::Threading
         // Wake any threads that might be sleeping
         SchedulerState::wait_for_job_cv.notify_all();
 
-        while (task->IsFinished())
+        while (!task->IsFinished())
         {
             if (!ExecuteTask()) // no task executed
             {
@@ -292,7 +379,7 @@ namespace Be::Framework::Threading
 
         const auto start_time = std::chrono::high_resolution_clock::now();
 
-        while (task->IsFinished())
+        while (!task->IsFinished())
         {
             if (!ExecuteTask()) // no task executed
             {
@@ -10,9 +10,22 @@ namespace Be::Framework::Threading
         ePerformance
     };
 
+    struct AsyncTaskSchedulerDesc
+    {
+        uint32_t thread_count{0};
+
+        // Each thread gets its own frame allocator when the size is not zero.
+        usize_t thread_frame_memory_size{0};
+        uint32_t thread_frame_count{2};
+
+        // Binds threads and their frame memory to the NUMA node they run on.
+        bool numa_local_memory{true};
+    };
+
     class AsyncTaskScheduler final : public Noninstanceable
     {
     public:
+        static void Create(const AsyncTaskSchedulerDesc &desc) noexcept;
         static void Create(uint32_t thread_count = 0) noexcept;
         static void Destroy() noexcept;
 
@@ -20,12 +33,21 @@ namespace Be::Framework::Threading
         static void Start() noexcept;
         static void Stop() noexcept;
 
+        [[nodiscard]] static bool IsRunning() noexcept;
+
     public:
         [[nodiscard]] static AsyncTask *CreateTask(const AsyncTaskFunction &task_func = AsyncTask::EmptyFunction, AsyncTask *parent_task = nullptr) noexcept;
 
     public:
         static void Schedule(AsyncTask *task, EThreadType thread_type = EThreadType::ePerformance) noexcept;
 
+    public:
+        // Frame allocator of the calling scheduler thread, nullptr if disabled.
+        [[nodiscard]] static FrameRingAllocator *GetThreadFrameAllocator() noexcept;
+
+        // Advances the frame allocators of all threads. Must be called while no tasks are running.
+        static void BeginFrame(uint64_t frame_value, uint64_t completed_frame_value) noexcept;
+
     public:
         static void Wait(AsyncTask *task) noexcept;
 
@@ -34,6 +56,7 @@ namespace Be::Framework::Threading
 
     private:
         static void RunThread() noexcept;
+        static void CreateThreadMemory() noexcept;
         static bool ExecuteTask() noexcept;
 
     private:
@@ -35,4 +35,24 @@ namespace Be::Framework::Threading
         return root_task;
     }
 
-}
\ No newline at end of file
+    // Runs func(task_index) for every task and returns once all of them are done,
+    // the calling thread executes tasks while it waits.
+    template <typename F>
+    void ParallelInvoke(usize_t task_count, const F &func, EThreadType thread_type = EThreadType::ePerformance) noexcept
+    {
+        PROFILER_SCOPE;
+
+        auto root_task = AsyncTaskScheduler::CreateTask();
+        for (usize_t i = 0; i < task_count; i++)
+        {
+            auto task = AsyncTaskScheduler::CreateTask([&func, i]
+                                                       { func(i); },
+                                                       root_task);
+            AsyncTaskScheduler::Schedule(task, thread_type);
+        }
+
+        AsyncTaskScheduler::Schedule(root_task, thread_type);
+        AsyncTaskScheduler::Wait(root_task);
+    }
+
+}
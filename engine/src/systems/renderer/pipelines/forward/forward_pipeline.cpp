@@ -15,17 +15,26 @@ namespace Be::System::Renderer::Pipelines
 
     void ForwardPipeline::CreateRenderQueue(const ForwardPipelineDesc &desc) noexcept
     {
-        m_render_queue_mem_arena = MakeUnique<MallocMemoryArena>(desc.render_queue_memory_size);
-        m_render_queue_allocator = MakeUnique<LinearAllocatorWaitFree>(*m_render_queue_mem_arena);
+        m_render_queue_mem_arena = MakeUnique<MallocMemoryArena>(desc.render_queue_memory_size * desc.frame_count, EMemoryTag::eRenderer);
+        m_render_queue_allocator = MakeUnique<FrameRingAllocator>(*m_render_queue_mem_arena, desc.frame_count);
 
         Array<RenderGroupHandle> groups{OPAQUE_GROUP, TRANSPARENT_GROUP};
 
-        m_render_queue = MakeUnique<RenderQueue>(m_driver, *m_render_queue_allocator, groups);
+        m_render_queue = MakeUnique<RenderQueue>(m_driver, *m_render_queue_allocator, groups, desc.frame_count, desc.instance_buffer_size);
     }
 
     void ForwardPipeline::BeginFrame() noexcept
     {
         PROFILER_SCOPE;
+
+        // RhiDriver::BeginFrame waited for the frame submitted frame_count frames ago.
+        m_frame_value = m_driver.GetFrameValue();
+        const auto frame_count = m_render_queue_allocator->GetFrameCount();
+        if (m_frame_value >= frame_count)
+        {
+            m_render_queue_allocator->RetireFrames(m_frame_value - frame_count);
+        }
+        m_render_queue_allocator->BeginFrame(m_frame_value);
     }
 
     void ForwardPipeline::EndFrame() noexcept
@@ -5,7 +5,9 @@ namespace Be::System::Renderer::Pipelines
     struct ForwardPipelineDesc
     {
         RhiDriver &rhi_driver;
-        usize_t render_queue_memory_size{1'000'000};
+        usize_t render_queue_memory_size{1'000'000}; // per frame
+        usize_t instance_buffer_size{4'000'000};     // per frame
+        uint32_t frame_count{2};
     };
 
     class ForwardPipeline final : public Noncopyable
@@ -30,8 +32,11 @@ namespace Be::System::Renderer::Pipelines
 
     private:
         UniquePtr<MallocMemoryArena> m_render_queue_mem_arena{nullptr};
-        UniquePtr<MemoryAllocator> m_render_queue_allocator{nullptr};
+        UniquePtr<FrameRingAllocator> m_render_queue_allocator{nullptr};
         UniquePtr<RenderQueue> m_render_queue{nullptr};
+
+    private:
+        uint64_t m_frame_value{0};
     };
 
 }
\ No newline at end of file
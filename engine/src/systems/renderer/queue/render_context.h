@@ -7,12 +7,14 @@ namespace Be::System::Renderer
     {
     public:
         forceinline void SetCamera(const Matrix4x4 &projection, const Matrix4x4 &view,
-                                   const Vector3 &position, const Vector3 &direction)
+                                   const Vector3 &position, const Vector3 &direction, bool inf_reversed_z = false)
         {
             m_projection_matrix = projection;
             m_view_matrix = view;
             m_camera_position = position;
             m_camera_direction = direction;
+            m_view_projection_matrix = view * projection;
+            m_frustum = Frustum::FromMatrix(m_view_projection_matrix, inf_reversed_z);
         }
 
         [[nodiscard]] forceinline const Matrix4x4 &GetProjectionMatrix() const
@@ -25,6 +27,11 @@ namespace Be::System::Renderer
             return m_view_matrix;
         }
 
+        [[nodiscard]] forceinline const Matrix4x4 &GetViewProjectionMatrix() const
+        {
+            return m_view_projection_matrix;
+        }
+
         [[nodiscard]] forceinline const Vector3 &GetCameraPosition() const
         {
             return m_camera_position;
@@ -35,11 +42,18 @@ namespace Be::System::Renderer
             return m_camera_direction;
         }
 
+        [[nodiscard]] forceinline const Frustum &GetFrustum() const
+        {
+            return m_frustum;
+        }
+
     private:
         Matrix4x4 m_projection_matrix;
         Matrix4x4 m_view_matrix;
+        Matrix4x4 m_view_projection_matrix;
         Vector3 m_camera_position;
         Vector3 m_camera_direction;
+        Frustum m_frustum;
     };
 
 }
\ No newline at end of file
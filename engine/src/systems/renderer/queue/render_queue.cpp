@@ -3,24 +3,38 @@
 namespace Be::System::Renderer
 {
 
-    RenderQueue::RenderQueue(RhiDriver &rhi_driver, MemoryAllocator &allocator, const Array<RenderGroupHandle> &groups)
+    RenderQueue::RenderQueue(RhiDriver &rhi_driver, MemoryAllocator &allocator, const Array<RenderGroupHandle> &groups,
+                             uint32_t frame_count, usize_t instance_buffer_size)
         : m_rhi_driver{rhi_driver},
-          m_render_data_allocator{allocator}
+          m_render_data_allocator{allocator},
+          m_render_data_resource{allocator},
+          m_render_groups{&m_render_data_resource},
+          m_groups{groups},
+          m_instance_buffer_size{instance_buffer_size}
     {
+        VERIFY(frame_count >= m_rhi_driver.GetFrameCount(), "Render queue has {} instance buffers for {} frames in flight.",
+               frame_count, m_rhi_driver.GetFrameCount());
+
+        m_instance_buffers.resize(frame_count);
+        for (uint32_t i = 0; i < frame_count; i++)
+        {
+            CreateInstanceBuffer(i);
+        }
+
         auto thread_count = ThreadUtils::MaxThreadCount();
-        m_thread_contexts.resize(thread_count);
+        m_thread_contexts.reserve(thread_count);
 
-        for (auto &ctx : m_thread_contexts)
+        for (uint32_t i = 0; i < thread_count; i++)
         {
-            for (const auto &g : groups)
-            {
-                ctx[g].clear();
-            }
+            m_thread_contexts.emplace_back(&m_render_data_resource);
         }
+
+        ResetFrameContainers();
     }
 
     RenderQueue::~RenderQueue()
     {
+        ResetFrameContainers();
     }
 
     void RenderQueue::BeginFrame(const RenderContext &context)
@@ -29,14 +43,22 @@ namespace Be::System::Renderer
 
         m_context = context;
 
-        for (auto &groups : m_thread_contexts)
+        // The previous frame asked for more than its buffer when it dropped batches.
+        m_instance_buffer_size = std::max(m_instance_buffer_size, m_instance_packer.GetRequestedSize());
+
+        // The driver waited for the frame that used this buffer last.
+        m_frame_index = uint32_t(m_rhi_driver.GetFrameValue() % m_instance_buffers.size());
+        if (m_instance_buffers[m_frame_index].size < m_instance_buffer_size)
         {
-            for (auto &[name, pool] : groups)
-            {
-                pool.clear();
-            }
+            CreateInstanceBuffer(m_frame_index);
         }
-        m_render_data_allocator.Reset();
+
+        const auto &buffer = m_instance_buffers[m_frame_index];
+        m_instance_packer.Reset(buffer.data, buffer.size);
+
+        m_occlusion_buffer.Begin(context.GetViewProjectionMatrix());
+
+        ResetFrameContainers();
     }
 
     void RenderQueue::Render(const RenderGroupHandle &group, RhiCommandBuffer &cmd)
@@ -46,32 +68,396 @@ namespace Be::System::Renderer
         auto &render_data = m_render_groups[group];
         render_data.clear();
 
-        for (auto &groups : m_thread_contexts)
+        usize_t count{0};
+        for (const auto &groups : m_thread_contexts)
+        {
+            count += groups.at(group).size();
+        }
+
+        // Keys are sorted with the indices of their items, the 40-byte items themselves
+        // are moved once, in sorted order.
+        PmrArray<uint64_t> keys{count, &m_render_data_resource};
+        PmrArray<uint64_t> temp_keys{count, &m_render_data_resource};
+        PmrArray<uint32_t> indices{count, &m_render_data_resource};
+        PmrArray<uint32_t> temp_indices{count, &m_render_data_resource};
+
+        RenderDataPool items{&m_render_data_resource};
+        items.reserve(count);
+        for (const auto &groups : m_thread_contexts)
+        {
+            for (const auto &rd : groups.at(group))
+            {
+                keys[items.size()] = rd.sorting_key;
+                indices[items.size()] = uint32_t(items.size());
+                items.push_back(rd);
+            }
+        }
+
+        if (count >= PARALLEL_SORT_MIN_COUNT && Framework::Threading::AsyncTaskScheduler::IsRunning())
+        {
+            RadixSortParallel(keys, indices, temp_keys, temp_indices, ThreadUtils::MaxThreadCount(),
+                              [](usize_t task_count, const auto &func)
+                              { Framework::Threading::ParallelInvoke(task_count, func); });
+        }
+        else
+        {
+            RadixSort(keys, indices, temp_keys, temp_indices);
+        }
+
+        {
+            EXCLUSIVE_LOCK(m_retained_mutex);
+
+            UpdateRetained(group);
+
+            // Both lists are sorted, retained items go first among equal keys.
+            const auto it = m_retained_groups.find(group);
+            const auto retained = it != m_retained_groups.end() ? it->second.GetSorted() : Span<const RetainedOrder::Entry>{};
+
+            render_data.reserve(count + retained.size());
+            usize_t r{0};
+            for (usize_t i = 0; i < count; i++)
+            {
+                for (; r < retained.size() && retained[r].sorting_key <= keys[i]; r++)
+                {
+                    render_data.push_back(m_retained_items[retained[r].handle].item);
+                }
+                render_data.push_back(items[indices[i]]);
+            }
+            for (; r < retained.size(); r++)
+            {
+                render_data.push_back(m_retained_items[retained[r].handle].item);
+            }
+        }
+
+        const auto &instances = m_instance_buffers[m_frame_index].view;
+        for (usize_t first = 0; first < render_data.size();)
+        {
+            const auto &rd = render_data[first];
+            auto last = first + 1;
+            for (; last < render_data.size() && render_data[last].item_hash == rd.item_hash; last++)
+            {
+            }
+
+            const auto instance_count = uint32_t(last - first);
+            const auto first_instance = WriteInstances({&render_data[first], instance_count});
+            first = last;
+
+            if (first_instance == InstancePacker::INVALID_INDEX)
+            {
+                continue;
+            }
+
+            rd.function(cmd, RenderBatch{&rd, instances, first_instance, instance_count});
+        }
+    }
+
+    uint32_t RenderQueue::WriteInstances(Span<const RenderableItemData> items)
+    {
+        const auto stride = usize_t(items.front().data_size);
+        const auto first = m_instance_packer.Reserve(stride, items.size());
+        if (first == InstancePacker::INVALID_INDEX || stride == 0)
+        {
+            return first;
+        }
+
+        auto *dst = m_instance_packer.GetPayload(stride, first);
+        for (const auto &item : items)
+        {
+            ASSERT(item.data_size == stride);
+            std::memcpy(dst, item.data, stride);
+            dst += stride;
+        }
+
+        return first;
+    }
+
+    RenderQueueStats RenderQueue::GetStats() const noexcept
+    {
+        return m_instance_packer.GetStats();
+    }
+
+    void RenderQueue::CreateInstanceBuffer(uint32_t index)
+    {
+        PROFILER_SCOPE;
+
+        RhiBufferDesc buffer_desc{
+            .bind_flag = ERhiBindFlag::eShaderResource,
+            .size = m_instance_buffer_size,
+            .mem_usage = ERhiResourceUsage::eUpload,
+            .debug_name = std::format("RenderQueue instances {}", index),
+        };
+        auto buffer = m_rhi_driver.CreateBuffer(buffer_desc);
+
+        RhiBufferViewDesc view_desc{
+            .buffer = buffer,
+            .view_type = vk::DescriptorType::eStorageBuffer,
+            .offset = 0,
+            .size = m_instance_buffer_size,
+        };
+        m_instance_buffers[index] = {m_rhi_driver.CreateBufferView(view_desc), static_cast<byte_t *>(buffer->Map()), m_instance_buffer_size};
+    }
+
+    Span<const uint32_t> RenderQueue::Cull(const CullingBounds &bounds)
+    {
+        PROFILER_SCOPE;
+
+        const auto count = bounds.size();
+        if (count == 0)
+        {
+            return {};
+        }
+
+        auto *visible = static_cast<uint32_t *>(m_render_data_allocator.Alloc(count * sizeof(uint32_t), alignof(uint32_t)));
+        const auto &frustum = m_context.GetFrustum();
+
+        usize_t visible_count;
+        if (count >= PARALLEL_CULL_MIN_COUNT && Framework::Threading::AsyncTaskScheduler::IsRunning())
+        {
+            visible_count = FrustumCullParallel(frustum, bounds, Span<uint32_t>{visible, count}, ThreadUtils::MaxThreadCount(),
+                                                [](usize_t task_count, const auto &func)
+                                                { Framework::Threading::ParallelInvoke(task_count, func); });
+        }
+        else
+        {
+            visible_count = FrustumCull(frustum, bounds, 0, count, visible);
+        }
+
+        return {visible, visible_count};
+    }
+
+    Span<const uint32_t> RenderQueue::Cull(const Bvh &bvh)
+    {
+        PROFILER_SCOPE;
+
+        if (bvh.empty())
+        {
+            return {};
+        }
+
+        auto *visible = static_cast<uint32_t *>(m_render_data_allocator.Alloc(bvh.size() * sizeof(uint32_t), alignof(uint32_t)));
+        return {visible, bvh.Cull(m_context.GetFrustum(), visible)};
+    }
+
+    Span<const uint32_t> RenderQueue::CullMeshlets(const Mesh &mesh, uint32_t instance)
+    {
+        PROFILER_SCOPE;
+
+        using namespace SubMeshInstanceColumn;
+
+        const auto &instances = mesh.GetInstances();
+        const auto submesh = instances.GetColumn<eMesh>()[instance];
+        const auto &transform = instances.GetColumn<eTransform>()[instance];
+
+        const auto first = mesh.GetFirstMeshlet(submesh);
+        const auto count = mesh.GetSubMeshes()[submesh].meshlets_count;
+        if (count == 0)
+        {
+            return {};
+        }
+
+        // The meshlets are tested in the mesh space.
+        const auto frustum = m_context.GetFrustum().GetTransformed(transform);
+        const Float3 camera{(Math::Inverse(transform) * Vector4{m_context.GetCameraPosition(), 1.0}).xyz};
+
+        auto *visible = static_cast<uint32_t *>(m_render_data_allocator.Alloc(count * sizeof(uint32_t), alignof(uint32_t)));
+        const auto visible_count = MeshletCull(frustum, camera, mesh.GetMeshletCullingBounds(), first, first + count, visible);
+        for (usize_t i = 0; i < visible_count; i++)
+        {
+            visible[i] -= first;
+        }
+
+        return {visible, visible_count};
+    }
+
+    void RenderQueue::AddOccluder(const Mesh &mesh, uint32_t instance)
+    {
+        PROFILER_SCOPE;
+
+        using namespace SubMeshInstanceColumn;
+
+        if (!mesh.HasOccluders())
+        {
+            return;
+        }
+
+        const auto &instances = mesh.GetInstances();
+        const auto submesh = instances.GetColumn<eMesh>()[instance];
+
+        // Instance transforms take column vectors, as in BBox::GetTransformed.
+        m_occlusion_buffer.AddOccluder(mesh.GetOccluderPositions(submesh), mesh.GetOccluderIndices(submesh),
+                                       Math::Transpose(instances.GetColumn<eTransform>()[instance]) * m_context.GetViewProjectionMatrix());
+    }
+
+    void RenderQueue::RasterizeOccluders()
+    {
+        PROFILER_SCOPE;
+
+        if (Framework::Threading::AsyncTaskScheduler::IsRunning())
+        {
+            m_occlusion_buffer.RasterizeParallel([](usize_t task_count, const auto &func)
+                                                 { Framework::Threading::ParallelInvoke(task_count, func); });
+        }
+        else
+        {
+            m_occlusion_buffer.Rasterize();
+        }
+    }
+
+    Span<const uint32_t> RenderQueue::CullOccluded(Span<const BBox> bounds, Span<const uint32_t> candidates)
+    {
+        PROFILER_SCOPE;
+
+        const auto count = candidates.size();
+        if (count == 0)
+        {
+            return {};
+        }
+
+        auto *visible = static_cast<uint32_t *>(m_render_data_allocator.Alloc(count * sizeof(uint32_t), alignof(uint32_t)));
+
+        usize_t visible_count;
+        if (count >= PARALLEL_CULL_MIN_COUNT && Framework::Threading::AsyncTaskScheduler::IsRunning())
+        {
+            visible_count = m_occlusion_buffer.CullParallel(bounds, candidates, Span<uint32_t>{visible, count}, ThreadUtils::MaxThreadCount(),
+                                                            [](usize_t task_count, const auto &func)
+                                                            { Framework::Threading::ParallelInvoke(task_count, func); });
+        }
+        else
+        {
+            visible_count = m_occlusion_buffer.Cull(bounds, candidates, visible);
+        }
+
+        return {visible, visible_count};
+    }
+
+    Pair<RetainedRenderItemHandle, void *> RenderQueue::AllocateRetained(const RenderGroupHandle &group, HashValue item_hash, uint64_t instance_sorting_key,
+                                                                         RenderFunction render_func, usize_t size, usize_t alignment)
+    {
+        PROFILER_SCOPE;
+
+        EXCLUSIVE_LOCK(m_retained_mutex);
+
+        RetainedRenderItem record{};
+        record.item.function = render_func;
+        record.item.data = m_retained_data_resource.allocate(size, alignment);
+        record.item.item_hash = item_hash;
+        record.item.sorting_key = instance_sorting_key;
+        record.item.data_size = uint32_t(size);
+        record.group = group;
+        record.data_alignment = uint32_t(alignment);
+        record.queued = true;
+
+        const auto handle = m_retained_items.Insert(record);
+        m_retained_groups[group].Queue(handle);
+
+        return {handle, const_cast<void *>(record.item.data)};
+    }
+
+    void RenderQueue::RemoveRetained(RetainedRenderItemHandle handle)
+    {
+        PROFILER_SCOPE;
+
+        EXCLUSIVE_LOCK(m_retained_mutex);
+
+        const auto *record = m_retained_items.Get(handle);
+        if (!record)
+        {
+            return;
+        }
+
+        // Queued so that the next merge drops its entry.
+        m_retained_groups[record->group].Queue(handle);
+        m_retained_data_resource.deallocate(const_cast<void *>(record->item.data), record->item.data_size, record->data_alignment);
+        m_retained_items.Erase(handle);
+    }
+
+    void RenderQueue::SetRetainedSortingKey(RetainedRenderItemHandle handle, uint64_t instance_sorting_key)
+    {
+        PROFILER_SCOPE;
+
+        EXCLUSIVE_LOCK(m_retained_mutex);
+
+        auto *record = m_retained_items.Get(handle);
+        if (!record || record->item.sorting_key == instance_sorting_key)
+        {
+            return;
+        }
+
+        record->item.sorting_key = instance_sorting_key;
+        record->version++;
+        if (!record->queued)
         {
-            const auto &g = groups.at(group);
-            render_data.insert(render_data.end(), g.begin(), g.end());
+            record->queued = true;
+            m_retained_groups[record->group].Queue(handle);
         }
+    }
+
+    void RenderQueue::UpdateRetained(const RenderGroupHandle &group)
+    {
+        PROFILER_SCOPE;
 
-        std::sort(render_data.begin(), render_data.end(),
-                  [](const auto &a, const auto &b)
-                  { return a.sorting_key < b.sorting_key; });
+        const auto it = m_retained_groups.find(group);
+        if (it == m_retained_groups.end())
+        {
+            return;
+        }
 
-        for (uint32_t i = 0; i < render_data.size(); i++)
+        // An item re-keyed more than once is queued once, removed items are gone.
+        const auto collect = [this](RetainedRenderItemHandle handle, RetainedOrder::Entry &entry)
         {
-            const auto &rd = render_data[i];
-            uint32_t instance_count{1};
-            i++;
-            for (; i < render_data.size() && render_data[i].item_hash == rd.item_hash; i++)
+            auto *record = m_retained_items.Get(handle);
+            if (!record || !record->queued)
             {
-                instance_count++;
+                return false;
+            }
+            record->queued = false;
+
+            entry.sorting_key = record->item.sorting_key;
+            entry.version = record->version;
+            return true;
+        };
+
+        const auto is_current = [this](const RetainedOrder::Entry &entry)
+        {
+            const auto *record = m_retained_items.Get(entry.handle);
+            return record && record->version == entry.version;
+        };
+
+        it->second.Update(collect, is_current, &m_render_data_resource);
+    }
+
+    void RenderQueue::ResetFrameContainers()
+    {
+        PROFILER_SCOPE;
+
+        // The frame allocator owns the memory of the previous containers and may have
+        // recycled it already, so they are overwritten instead of being destroyed.
+        for (auto &groups : m_thread_contexts)
+        {
+            std::construct_at(&groups, &m_render_data_resource);
+            groups.reserve(m_groups.size());
+            for (const auto &g : m_groups)
+            {
+                groups[g];
             }
-            rd.function(cmd, &rd, instance_count);
         }
+        std::construct_at(&m_render_groups, &m_render_data_resource);
     }
 
     void RenderQueue::EndFrame()
     {
         PROFILER_SCOPE;
+
+        const auto stats = GetStats();
+        PROFILER_PLOT("Render items", int64_t(stats.item_count));
+        PROFILER_PLOT("Render batches", int64_t(stats.batch_count));
+        PROFILER_PLOT("Instancing ratio", double(stats.GetInstancingRatio()));
+
+        if (stats.dropped_count != 0)
+        {
+            LOG_WARN("Render queue instance buffer of {} bytes is full, {} items are not drawn this frame.",
+                     m_instance_buffers[m_frame_index].size, stats.dropped_count);
+        }
     }
 
 }
\ No newline at end of file
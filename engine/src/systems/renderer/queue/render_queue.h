@@ -4,7 +4,7 @@ namespace Be::System::Renderer
 {
 
     using RenderGroupHandle = NamedHandle<RenderQueue, 64, BE_OPTIMIZE_IDS>;
-    using RenderFunction = void (*)(RhiCommandBuffer &, const RenderableItemData *, uint32_t);
+    using RenderFunction = void (*)(RhiCommandBuffer &, const RenderBatch &);
 
     template <typename T>
     concept RenderableItem = requires(T t, RenderQueue &q, const RenderContext &c, const Matrix4x4 &m) { t.EnqueueToRenderQueue(q, c, m); };
@@ -15,19 +15,77 @@ namespace Be::System::Renderer
         const void *data;
         HashValue item_hash;
         uint64_t sorting_key; // Lower sorting keys will appear earlier.
+        uint32_t data_size;
     };
 
+    // Consecutive items with the same hash are drawn as one batch. Their data is packed
+    // into the frame instance buffer: the payload of instance i is element
+    // first_instance + i of the buffer, so one instanced draw with first_instance as
+    // its first instance covers the whole batch.
+    struct RenderBatch
+    {
+        const RenderableItemData *item; // The first item of the batch.
+        const RhiBufferViewHandle &instances;
+        uint32_t first_instance;
+        uint32_t instance_count;
+    };
+
+    using RenderQueueStats = InstancePackingStats;
+
+    // Item kept by the queue across frames, see RenderQueue::AddRetained.
+    struct RetainedRenderItem
+    {
+        RenderableItemData item;
+        RenderGroupHandle group;
+        uint32_t data_alignment; // The data is freed with the size and alignment it was allocated with.
+        uint32_t version; // Bumped when the sorting key changes, older entries are stale.
+        bool queued;
+    };
+
+    using RetainedRenderItemHandle = SlotHandle<RetainedRenderItem>;
+
     class RenderQueue final : public Noncopyable
     {
     public:
-        RenderQueue(RhiDriver &rhi_driver, MemoryAllocator &allocator, const Array<RenderGroupHandle> &groups);
+        RenderQueue(RhiDriver &rhi_driver, MemoryAllocator &allocator, const Array<RenderGroupHandle> &groups,
+                    uint32_t frame_count, usize_t instance_buffer_size);
         ~RenderQueue();
 
     public:
+        // Called after RhiDriver::BeginFrame, the instance buffers follow the driver frames.
         void BeginFrame(const RenderContext &context);
         void Render(const RenderGroupHandle &group, RhiCommandBuffer &cmd);
         void EndFrame();
 
+    public:
+        // Totals of the current frame.
+        [[nodiscard]] RenderQueueStats GetStats() const noexcept;
+
+    public:
+        // Indices of the bounds visible from the camera of the frame, in ascending order.
+        // The list lives in the frame memory, renderable items push the instances it
+        // lists from EnqueueToRenderQueue.
+        [[nodiscard]] Span<const uint32_t> Cull(const CullingBounds &bounds);
+
+        // Same through a hierarchy, whole subtrees are accepted or rejected at once. The
+        // indices come in no particular order.
+        [[nodiscard]] Span<const uint32_t> Cull(const Bvh &bvh);
+
+        // Meshlets of an instance that intersect the frustum and may face the camera, as
+        // indices into the meshlets of its submesh: the compacted list and its size for an
+        // indirect mesh tasks draw. The list lives in the frame memory.
+        [[nodiscard]] Span<const uint32_t> CullMeshlets(const Mesh &mesh, uint32_t instance);
+
+        // Occluders of the frame are drawn into a small depth buffer on the CPU: the
+        // simplified triangles of the nearby instances are added from one thread, then
+        // rasterized once, then the frustum culling results are tested against them.
+        void AddOccluder(const Mesh &mesh, uint32_t instance);
+        void RasterizeOccluders();
+
+        // The candidates whose bounds are not hidden by the occluders, in the candidate
+        // order. The list lives in the frame memory.
+        [[nodiscard]] Span<const uint32_t> CullOccluded(Span<const BBox> bounds, Span<const uint32_t> candidates);
+
     public:
         forceinline void Push(const RenderableItem auto &item, const Matrix4x4 &model_matrix)
         {
@@ -46,10 +104,50 @@ namespace Be::System::Renderer
             rd.data = m_render_data_allocator.Alloc(sizeof(T), alignof(T));
             rd.item_hash = HashOf(renderable_item_key) + HashOf(render_func);
             rd.sorting_key = instance_sorting_key;
+            rd.data_size = sizeof(T);
 
             return rd.data;
         }
 
+    public:
+        // Retained items stay queued until removed. Their order is kept between frames,
+        // Render only sorts the items whose sorting key changed and merges them back, so
+        // a static scene costs no sorting at all. The data is written in place through
+        // GetRetainedData. Retained items are changed between frames, not during Render.
+        template <typename T>
+        RetainedRenderItemHandle AddRetained(const RenderGroupHandle &group, uint64_t renderable_item_key, uint64_t instance_sorting_key,
+                                             RenderFunction render_func, const T &data)
+        {
+            PROFILER_SCOPE;
+
+            STATIC_ASSERT(std::is_trivially_copyable_v<T>, "Retained render data is copied and never destroyed.");
+
+            const auto [handle, mem] = AllocateRetained(group, HashOf(renderable_item_key) + HashOf(render_func), instance_sorting_key,
+                                                        render_func, sizeof(T), alignof(T));
+            std::construct_at(static_cast<T *>(mem), data);
+            return handle;
+        }
+
+        void RemoveRetained(RetainedRenderItemHandle handle);
+        void SetRetainedSortingKey(RetainedRenderItemHandle handle, uint64_t instance_sorting_key);
+
+        template <typename T>
+        [[nodiscard]] T *GetRetainedData(RetainedRenderItemHandle handle)
+        {
+            EXCLUSIVE_LOCK(m_retained_mutex);
+
+            auto *record = m_retained_items.Get(handle);
+            ASSERT(!record || record->item.data_size == sizeof(T));
+            return record ? static_cast<T *>(const_cast<void *>(record->item.data)) : nullptr;
+        }
+
+    private:
+        Pair<RetainedRenderItemHandle, void *> AllocateRetained(const RenderGroupHandle &group, HashValue item_hash, uint64_t instance_sorting_key,
+                                                                 RenderFunction render_func, usize_t size, usize_t alignment);
+        void UpdateRetained(const RenderGroupHandle &group);
+        [[nodiscard]] uint32_t WriteInstances(Span<const RenderableItemData> items);
+        void CreateInstanceBuffer(uint32_t index);
+
     private:
         RhiDriver &m_rhi_driver;
 
@@ -57,16 +155,57 @@ namespace Be::System::Renderer
         RenderContext m_context;
 
     private:
-        using RenderDataPool = Array<RenderableItemData>;
-        using RenderGroups = Map<RenderGroupHandle, RenderDataPool>;
+        void ResetFrameContainers();
+
+    private:
+        Map<uint64_t, void *> m_allocated_renderable_item_data;
+        MemoryAllocator &m_render_data_allocator;
+        MonotonicMemoryResource m_render_data_resource;
+
+    private:
+        // Smaller queues are sorted and culled on the calling thread.
+        static constexpr usize_t PARALLEL_SORT_MIN_COUNT = 64 * 1024;
+        static constexpr usize_t PARALLEL_CULL_MIN_COUNT = 32 * 1024;
+
+        static constexpr uint32_t OCCLUSION_BUFFER_WIDTH = 256;
+        static constexpr uint32_t OCCLUSION_BUFFER_HEIGHT = 128;
+
+    private:
+        // Per-frame containers live in the frame memory and are rebuilt in BeginFrame.
+        using RenderDataPool = PmrArray<RenderableItemData>;
+        using RenderGroups = PmrFlatHashMap<RenderGroupHandle, RenderDataPool>;
         using ThreadContexts = Array<RenderGroups>;
 
         ThreadContexts m_thread_contexts{};
-        RenderGroups m_render_groups{};
+        RenderGroups m_render_groups;
+        Array<RenderGroupHandle> m_groups;
 
     private:
-        Map<uint64_t, void *> m_allocated_renderable_item_data;
-        MemoryAllocator &m_render_data_allocator;
+        // Removed and re-keyed items are queued, their old entries are dropped by the next update.
+        using RetainedOrder = IncrementalSort<RetainedRenderItemHandle>;
+
+        struct InstanceBuffer
+        {
+            RhiBufferViewHandle view;
+            byte_t *data;
+            usize_t size;
+        };
+
+        // One buffer per frame in flight, filled from the start every frame. Batches that
+        // don't fit are dropped, the buffer of the frame grows to the size the frame asked
+        // for when it is used again.
+        Array<InstanceBuffer> m_instance_buffers;
+        usize_t m_instance_buffer_size{0};
+        uint32_t m_frame_index{0};
+        InstancePacker m_instance_packer;
+
+        OcclusionBuffer m_occlusion_buffer{OCCLUSION_BUFFER_WIDTH, OCCLUSION_BUFFER_HEIGHT};
+
+    private:
+        Mutex m_retained_mutex;
+        SlotMap<RetainedRenderItem> m_retained_items;
+        FlatHashMap<RenderGroupHandle, RetainedOrder> m_retained_groups;
+        std::pmr::unsynchronized_pool_resource m_retained_data_resource;
     };
 
 }
@@ -0,0 +1,23 @@
+#include "systems/renderer/renderer.h"
+
+namespace Be::System::Renderer
+{
+
+    void AddRenderSystem(Framework::ECS::SystemScheduler &scheduler, RenderQueue &queue)
+    {
+        using namespace Framework::ECS;
+
+        const auto push = [&queue](const SystemContext &context)
+        {
+            context.ForEachChunk<const Renderable, const WorldTransform>([&queue](usize_t count, const Entity *, const Renderable *renderables, const WorldTransform *worlds)
+                                                                         {
+                                                                             for (usize_t i = 0; i < count; i++)
+                                                                             {
+                                                                                 renderables[i].push(renderables[i].item, queue, Matrix4x4{worlds[i].matrix});
+                                                                             } });
+        };
+
+        scheduler.Add("RenderQueuePush", SystemAccess::Of<RenderQueue, const Renderable, const WorldTransform>(), push);
+    }
+
+}
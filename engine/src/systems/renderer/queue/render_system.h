@@ -0,0 +1,27 @@
+#pragma once
+
+namespace Be::System::Renderer
+{
+
+    // Renderable item of an entity, type erased so that entities with different items
+    // share an archetype. The item is not owned and has to outlive the entity.
+    struct Renderable
+    {
+        const void *item;
+        void (*push)(const void *item, RenderQueue &queue, const Matrix4x4 &model_matrix);
+
+        template <RenderableItem T>
+        [[nodiscard]] static Renderable Of(const T &item) noexcept
+        {
+            return {&item, [](const void *item, RenderQueue &queue, const Matrix4x4 &model_matrix)
+                    { queue.Push(*static_cast<const T *>(item), model_matrix); }};
+        }
+    };
+
+    // Pushes the item of every entity with a Renderable and a WorldTransform into the
+    // queue, chunks of entities are pushed from several threads. Added after the transform
+    // systems it sees the world matrices of the current update. The scheduler runs
+    // between RenderQueue::BeginFrame and Render.
+    void AddRenderSystem(Framework::ECS::SystemScheduler &scheduler, RenderQueue &queue);
+
+}
@@ -22,4 +22,32 @@ namespace Be::System::Renderer
     {
     }
 
+    uint32_t Renderer::BeginFrame() noexcept
+    {
+        PROFILER_SCOPE;
+
+        const auto image = m_driver->BeginFrame();
+        ReleaseUnusedResources();
+        return image;
+    }
+
+    void Renderer::EndFrame() noexcept
+    {
+        PROFILER_SCOPE;
+
+        m_driver->EndFrame();
+    }
+
+    void Renderer::ReleaseUnusedResources() noexcept
+    {
+        PROFILER_SCOPE;
+
+        const auto meshes = m_mesh_manager->ReleaseUnused();
+        const auto textures = m_texture_manager->ReleaseUnused();
+        if (meshes != 0 || textures != 0)
+        {
+            LOG_INFO("Released {} unused meshes and {} unused textures.", meshes, textures);
+        }
+    }
+
 }
\ No newline at end of file
@@ -3,12 +3,14 @@
 #include "base/base.h"
 
 #include "frameworks/threading/threading.h"
+#include "frameworks/ecs/ecs.h"
 #include "frameworks/rhi/rhi.h"
 
 #include "systems/renderer/renderer_types.h"
 #include "systems/renderer/shader_interop/shader_interop.h"
 #include "systems/renderer/queue/render_context.h"
 #include "systems/renderer/queue/render_queue.h"
+#include "systems/renderer/queue/render_system.h"
 #include "systems/renderer/resources/texture/texture.h"
 #include "systems/renderer/resources/material/material.h"
 #include "systems/renderer/resources/mesh/mesh.h"
@@ -40,6 +42,18 @@ namespace Be::System::Renderer
             return *m_model_manager;
         }
 
+    public:
+        // Frame boundary: BeginFrame waits for the driver frame, then releases the
+        // resources no one holds a reference to, and returns the swapchain image.
+        uint32_t BeginFrame() noexcept;
+        void EndFrame() noexcept;
+
+    public:
+        // Destroys the loaded textures and meshes whose only reference is the manager's.
+        // Run by BeginFrame, call it directly to release them right away, for example
+        // after a level is unloaded.
+        void ReleaseUnusedResources() noexcept;
+
     private:
         Window &m_window;
 
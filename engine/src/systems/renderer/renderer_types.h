@@ -10,6 +10,7 @@ namespace Be::System::Renderer
   class RenderQueue;
   class RenderContext;
   struct RenderableItemData;
+  struct RenderBatch;
 
   class Material;
 
@@ -49,7 +49,7 @@ namespace Be::System::Renderer
         m_rhi_program->GetBindingNames(binding_names);
     }
 
-    void Material::SetProperty(uint32_t index, const TextureHandle &value) noexcept
+    void Material::SetProperty(uint32_t index, const Texture &value) noexcept
     {
         PROFILER_SCOPE;
 
@@ -58,10 +58,9 @@ namespace Be::System::Renderer
         auto &p = m_inner_properties[index];
         ASSERT(p.type == EMaterialProperyType::eTex2d || p.type == EMaterialProperyType::eTex3d);
 
-        *((RhiBindlessIndex *)(m_data.data() + p.offset)) = value->GetShaderView()->GetDescriptorIndex();
+        *((RhiBindlessIndex *)(m_data.data() + p.offset)) = value.GetShaderView()->GetDescriptorIndex();
 
-        p.texture = value;
-        p.image_view.Reset();
+        p.image_view = value.GetShaderView();
     }
 
     void Material::SetProperty(uint32_t index, const RhiImageViewHandle &value) noexcept
@@ -75,7 +74,6 @@ namespace Be::System::Renderer
 
         *((RhiBindlessIndex *)(m_data.data() + p.offset)) = value->GetDescriptorIndex();
 
-        p.texture.Reset();
         p.image_view = value;
     }
 
@@ -90,7 +88,6 @@ namespace Be::System::Renderer
 
         *((RhiBindlessIndex *)(m_data.data() + p.offset)) = value;
 
-        p.texture.Reset();
         p.image_view.Reset();
     }
 
@@ -45,7 +45,6 @@ namespace Be::System::Renderer
             EMaterialProperyType type;
             uint32_t offset;
 
-            TextureHandle texture;
             RhiImageViewHandle image_view;
         };
 
@@ -57,7 +56,9 @@ namespace Be::System::Renderer
         void SetProgram(const RhiProgramHandle &prog) noexcept;
 
     public:
-        void SetProperty(uint32_t index, const TextureHandle &value) noexcept;
+        // Keeps the shader view of the texture, not the texture: the owner of the material
+        // holds the texture reference.
+        void SetProperty(uint32_t index, const Texture &value) noexcept;
         void SetProperty(uint32_t index, const RhiImageViewHandle &value) noexcept;
         void SetProperty(uint32_t index, RhiBindlessIndex value) noexcept;
         void SetProperty(uint32_t index, float value) noexcept;
@@ -13,6 +13,12 @@ namespace Be::System::Renderer
              eBoneIndex = MESH_HAS_BONE_INDEX,
              eBoneWeights = MESH_HAS_BONE_WEIGHTS);
 
+    // .bemesh files start with the magic and the format version. Version 2 has the 48
+    // byte MeshletBounds and the occluder section after the geometry, files without a
+    // header are older and have to be converted again.
+    inline constexpr uint32_t MESH_FILE_MAGIC = 0x4853'4D42; // "BMSH"
+    inline constexpr uint32_t MESH_FILE_VERSION = 2;
+
     struct SubMeshBufferView
     {
         uint32_t offset{0};
@@ -41,12 +47,36 @@ namespace Be::System::Renderer
         BBox bbox{};
     };
 
+    // Instance record as stored in the mesh file.
     struct SubMeshInstance
     {
         uint32_t mesh{MaxValue};
         Matrix4x4 transform{};
     };
 
+    // Simplified triangles of a submesh for the CPU occlusion buffer, the indices are
+    // local to its vertices. Empty for submeshes that do not occlude.
+    struct SubMeshOccluder
+    {
+        uint32_t first_vertex{0};
+        uint32_t vertex_count{0};
+        uint32_t first_index{0};
+        uint32_t index_count{0};
+    };
+
+    // Instances in memory: submesh index, transform and world space bounds in separate columns.
+    using SubMeshInstances = SoAArray<uint32_t, Matrix4x4, BBox>;
+
+    namespace SubMeshInstanceColumn
+    {
+        enum : usize_t
+        {
+            eMesh,
+            eTransform,
+            eBounds,
+        };
+    }
+
     /*
     Geometry buffer structure (continuously repeated for each submesh):
        - Positions: UInt2(Rgba16Snorm)
@@ -58,20 +88,102 @@ namespace Be::System::Renderer
        - Meshlets vertices: uint32_t
        - Meshlets triangles: ShaderInterop::MeshletTriangle
        - Meshlets bounds: ShaderInterop::MeshletBounds
+    Occluders follow the geometry buffer in the file and stay in memory:
+       - Vertices count, indices count: uint32_t
+       - Occluder per submesh: SubMeshOccluder
+       - Positions: Float3
+       - Indices: uint32_t
     */
-    class Mesh final : public RefCounter
+    // Owned by the MeshManager and referenced by MeshHandle.
+    class Mesh final
     {
+    public:
+        explicit Mesh(String key) noexcept
+            : m_key{std::move(key)}
+        {
+        }
+
+    public:
+        [[nodiscard]] forceinline const String &GetKey() const noexcept
+        {
+            return m_key;
+        }
+
+        [[nodiscard]] forceinline const Array<SubMesh> &GetSubMeshes() const noexcept
+        {
+            return m_submeshes;
+        }
+
+        [[nodiscard]] forceinline const SubMeshInstances &GetInstances() const noexcept
+        {
+            return m_instances;
+        }
+
+        // World space bounds of the instances in the culling layout, in the instance order.
+        [[nodiscard]] forceinline const CullingBounds &GetCullingBounds() const noexcept
+        {
+            return m_culling_bounds;
+        }
+
+        // Hierarchy over the same bounds for meshes with many instances.
+        [[nodiscard]] forceinline const Bvh &GetInstanceBvh() const noexcept
+        {
+            return m_instance_bvh;
+        }
+
+        // Bounds of the meshlets of all submeshes for CPU culling, in the mesh space. The
+        // meshlets of a submesh start at its first meshlet.
+        [[nodiscard]] forceinline const MeshletCullingBounds &GetMeshletCullingBounds() const noexcept
+        {
+            return m_meshlet_culling_bounds;
+        }
+
+        [[nodiscard]] forceinline uint32_t GetFirstMeshlet(uint32_t submesh) const noexcept
+        {
+            return m_first_meshlets[submesh];
+        }
+
+        [[nodiscard]] forceinline bool HasOccluders() const noexcept
+        {
+            return !m_occluders.empty();
+        }
+
+        [[nodiscard]] forceinline Span<const Float3> GetOccluderPositions(uint32_t submesh) const noexcept
+        {
+            const auto &occluder = m_occluders[submesh];
+            return Span<const Float3>{m_occluder_positions}.subspan(occluder.first_vertex, occluder.vertex_count);
+        }
+
+        [[nodiscard]] forceinline Span<const uint32_t> GetOccluderIndices(uint32_t submesh) const noexcept
+        {
+            const auto &occluder = m_occluders[submesh];
+            return Span<const uint32_t>{m_occluder_indices}.subspan(occluder.first_index, occluder.index_count);
+        }
+
+    private:
+        String m_key;
+
     private:
         RhiBufferViewHandle m_geometry;
 
     private:
         Array<SubMesh> m_submeshes{};
-        Array<SubMeshInstance> m_instances{};
+        SubMeshInstances m_instances{};
+        CullingBounds m_culling_bounds{};
+        Bvh m_instance_bvh{};
+
+        MeshletCullingBounds m_meshlet_culling_bounds{};
+        Array<uint32_t> m_first_meshlets{};
+
+        Array<SubMeshOccluder> m_occluders{};
+        Array<Float3> m_occluder_positions{};
+        Array<uint32_t> m_occluder_indices{};
 
         friend class MeshManager;
     };
 
-    DEFINE_RENDERER_HANDLE(Mesh);
+    // Slot index and generation of a mesh in the MeshManager.
+    using MeshHandle = SlotHandle<Mesh>;
 
 }
 
@@ -11,6 +11,18 @@ namespace Be::System::Renderer
     MeshHandle MeshManager::Load(const String &key, InputStream &stream, EMeshManagerFlag flags) noexcept
     {
         PROFILER_SCOPE;
+        MEMORY_TAG_SCOPE(EMemoryTag::eAssets);
+
+        if (const auto mesh = FindMesh(key); mesh)
+        {
+            return mesh;
+        }
+
+        uint32_t magic{0};
+        uint32_t version{0};
+        stream >> magic >> version;
+        VERIFY(magic == MESH_FILE_MAGIC && version == MESH_FILE_VERSION,
+               "Mesh {} is not a version {} .bemesh file, convert it again with gltfconv.", key, MESH_FILE_VERSION);
 
         uint32_t submeshes_count{0};
         uint32_t instances_count{0};
@@ -18,18 +30,59 @@ namespace Be::System::Renderer
 
         stream >> submeshes_count >> instances_count >> geometry_size;
 
-        auto mesh = MakeRefCounter<Mesh>();
+        Mesh mesh{key};
 
-        mesh->m_submeshes.resize(submeshes_count);
-        stream.Read(mesh->m_submeshes.data(), submeshes_count * sizeof(SubMesh));
+        mesh.m_submeshes.resize(submeshes_count);
+        stream.Read(mesh.m_submeshes.data(), submeshes_count * sizeof(SubMesh));
 
-        mesh->m_instances.resize(instances_count);
-        stream.Read(mesh->m_instances.data(), instances_count * sizeof(SubMeshInstance));
+        Array<SubMeshInstance> instances(instances_count);
+        stream.Read(instances.data(), instances_count * sizeof(SubMeshInstance));
+
+        mesh.m_instances.reserve(instances_count);
+        mesh.m_culling_bounds.reserve(instances_count);
+        for (const auto &instance : instances)
+        {
+            ASSERT(instance.mesh < submeshes_count);
+            const auto &submesh = mesh.m_submeshes[instance.mesh];
+            const auto bounds = submesh.bbox.GetTransformed(instance.transform);
+            mesh.m_instances.push_back(instance.mesh, instance.transform, bounds);
+            PushCullingBounds(mesh.m_culling_bounds, bounds);
+        }
+        mesh.m_instance_bvh.Build(mesh.m_instances.GetColumn<SubMeshInstanceColumn::eBounds>());
 
         ByteArray geometry{};
         geometry.resize(geometry_size);
         stream.Read(geometry.data(), geometry_size);
 
+        mesh.m_first_meshlets.reserve(submeshes_count);
+        for (const auto &submesh : mesh.m_submeshes)
+        {
+            mesh.m_first_meshlets.push_back(uint32_t(mesh.m_meshlet_culling_bounds.size()));
+
+            VERIFY(usize_t(submesh.meshlet_bounds_location) + usize_t(submesh.meshlets_count) * sizeof(ShaderInterop::MeshletBounds) <= geometry_size,
+                   "Meshlet bounds of mesh {} are outside of its geometry.", key);
+
+            const auto *meshlet_bounds = reinterpret_cast<const ShaderInterop::MeshletBounds *>(geometry.data() + submesh.meshlet_bounds_location);
+            for (uint32_t i = 0; i < submesh.meshlets_count; i++)
+            {
+                const auto &bounds = meshlet_bounds[i];
+                PushMeshletCullingBounds(mesh.m_meshlet_culling_bounds, bounds.center, bounds.radius, bounds.cone_axis, bounds.cone_cutoff);
+            }
+        }
+
+        uint32_t occluder_vertices_count{0};
+        uint32_t occluder_indices_count{0};
+        stream >> occluder_vertices_count >> occluder_indices_count;
+
+        mesh.m_occluders.resize(submeshes_count);
+        stream.Read(mesh.m_occluders.data(), submeshes_count * sizeof(SubMeshOccluder));
+
+        mesh.m_occluder_positions.resize(occluder_vertices_count);
+        stream.Read(mesh.m_occluder_positions.data(), occluder_vertices_count * sizeof(Float3));
+
+        mesh.m_occluder_indices.resize(occluder_indices_count);
+        stream.Read(mesh.m_occluder_indices.data(), occluder_indices_count * sizeof(uint32_t));
+
         RhiBufferDesc buffer_desc{
             .bind_flag = ERhiBindFlag::eUnorderedAccess | ERhiBindFlag::eCopyDest,
             .size = geometry_size,
@@ -42,15 +95,23 @@ namespace Be::System::Renderer
             .offset = 0,
             .size = geometry_size,
         };
-        mesh->m_geometry = m_driver.CreateBufferView(view_desc);
+        mesh.m_geometry = m_driver.CreateBufferView(view_desc);
 
-        return mesh;
+        const auto handle = m_meshes.Emplace(std::move(mesh));
+        m_mesh_ids.emplace(key, handle);
+
+        return handle;
     }
 
     MeshHandle MeshManager::Load(const String &key, const Path &path, EMeshManagerFlag flags) noexcept
     {
         PROFILER_SCOPE;
 
+        if (const auto mesh = FindMesh(key); mesh)
+        {
+            return mesh;
+        }
+
         std::ifstream file{path, std::ios::in | std::ios::binary};
         VERIFY(file, "Failed to open mesh file: {}", path.string());
 
@@ -58,4 +119,43 @@ namespace Be::System::Renderer
         return Load(key, stream, flags);
     }
 
+    void MeshManager::Unload(MeshHandle mesh) noexcept
+    {
+        PROFILER_SCOPE;
+
+        const auto *loaded = m_meshes.Get(mesh);
+        if (loaded && FindMesh(loaded->GetKey()) == mesh)
+        {
+            m_mesh_ids.erase(loaded->GetKey());
+            m_meshes.Release(mesh);
+        }
+    }
+
+    usize_t MeshManager::ReleaseUnused() noexcept
+    {
+        PROFILER_SCOPE;
+
+        // Erasing moves the last mesh into the hole, so walk the dense array backwards.
+        // Unloaded meshes have no key entry, only their holders release them.
+        usize_t released{0};
+        for (auto i = m_meshes.size(); i-- > 0;)
+        {
+            const auto mesh = m_meshes.GetHandle(i);
+            const auto &key = m_meshes.GetValues()[i].GetKey();
+            if (m_meshes.GetRefCount(mesh) == 1 && FindMesh(key) == mesh)
+            {
+                m_mesh_ids.erase(key);
+                m_meshes.Release(mesh);
+                released++;
+            }
+        }
+        return released;
+    }
+
+    MeshHandle MeshManager::FindMesh(StringView key) const noexcept
+    {
+        const auto it = m_mesh_ids.find(key);
+        return it != m_mesh_ids.end() ? it->second : MeshHandle{};
+    }
+
 }
\ No newline at end of file
@@ -5,17 +5,60 @@ namespace Be::System::Renderer
 
     BIT_ENUM(EMeshManagerFlag, uint8_t, eNone = 0);
 
+    // Meshes live in the manager and are referenced by MeshHandle, copying a handle
+    // doesn't count. Holders that need a mesh to stay loaded take a reference with
+    // AddRef and drop it with Release, the manager holds one of its own until the mesh
+    // is unloaded.
     class MeshManager final : public Noncopyable
     {
     public:
         MeshManager(RhiDriver &driver) noexcept;
 
     public:
+        // A key that is already loaded returns the cached mesh, the stream is not read.
         [[nodiscard]] MeshHandle Load(const String &key, InputStream &stream, EMeshManagerFlag flags = EMeshManagerFlag::eNone) noexcept;
         [[nodiscard]] MeshHandle Load(const String &key, const Path &path, EMeshManagerFlag flags = EMeshManagerFlag::eNone) noexcept;
 
+        // Drops the manager reference and forgets the key, the mesh lives on while other
+        // references exist.
+        void Unload(MeshHandle mesh) noexcept;
+
+        forceinline void AddRef(MeshHandle mesh) noexcept
+        {
+            m_meshes.AddRef(mesh);
+        }
+
+        // The mesh is destroyed with the last reference.
+        forceinline void Release(MeshHandle mesh) noexcept
+        {
+            m_meshes.Release(mesh);
+        }
+
+        // Destroys the loaded meshes no one else holds a reference to and returns how
+        // many were released. Called between frames, the mesh is destroyed right away.
+        usize_t ReleaseUnused() noexcept;
+
+    public:
+        [[nodiscard]] MeshHandle FindMesh(StringView key) const noexcept;
+
+        // Null for a mesh that was destroyed.
+        [[nodiscard]] forceinline const Mesh *GetMesh(MeshHandle mesh) const noexcept
+        {
+            return m_meshes.Get(mesh);
+        }
+
+        // Dense view of the meshes for residency and streaming passes.
+        [[nodiscard]] forceinline Span<const Mesh> GetMeshes() const noexcept
+        {
+            return m_meshes.GetValues();
+        }
+
+    private:
+        RhiDriver &m_driver;
+
     private:
-        RhiDriver &m_driver;        
+        SlotMap<Mesh, true> m_meshes;
+        FlatHashMap<String, MeshHandle, StringHash, std::equal_to<>> m_mesh_ids;
     };
 
 }
\ No newline at end of file
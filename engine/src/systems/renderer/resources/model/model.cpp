@@ -2,4 +2,25 @@
 
 namespace Be::System::Renderer
 {
+
+    Model::Model(TextureManager &texture_manager, MeshManager &mesh_manager) noexcept
+        : m_texture_manager{texture_manager},
+          m_mesh_manager{mesh_manager}
+    {
+    }
+
+    Model::~Model() noexcept
+    {
+        PROFILER_SCOPE;
+
+        for (const auto texture : m_textures)
+        {
+            m_texture_manager.Release(texture);
+        }
+        if (m_mesh)
+        {
+            m_mesh_manager.Release(m_mesh);
+        }
+    }
+
 }
\ No newline at end of file
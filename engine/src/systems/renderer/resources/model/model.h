@@ -8,8 +8,19 @@ namespace Be::System::Renderer
     using VertexColorType = uint32_t;
     using VertexUVType = uint32_t;
 
+    // Holds a reference to its mesh and textures while it lives.
     class Model final : public RefCounter
     {
+        POOLED_ALLOCATION(Model);
+
+    public:
+        Model(TextureManager &texture_manager, MeshManager &mesh_manager) noexcept;
+        ~Model() noexcept;
+
+    private:
+        TextureManager &m_texture_manager;
+        MeshManager &m_mesh_manager;
+
     private:
         MeshHandle m_mesh;
         Array<TextureHandle> m_textures;
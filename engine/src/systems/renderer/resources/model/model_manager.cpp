@@ -13,6 +13,7 @@ namespace Be::System::Renderer
     ModelHandle ModelManager::Load(const String &key, InputStream &stream, EModelManagerFlag flags) noexcept
     {
         PROFILER_SCOPE;
+        MEMORY_TAG_SCOPE(EMemoryTag::eAssets);
 
         AssetName mesh_name{};
         uint32_t textures_count{0};
@@ -21,7 +22,7 @@ namespace Be::System::Renderer
 
         stream >> textures_count >> materials_count >> mesh_materials_count;
 
-        auto model = MakeRefCounter<Model>();
+        auto model = MakeRefCounter<Model>(m_texture_manager, m_mesh_manager);
 
         Array<AssetName> textures_names;
         textures_names.resize(textures_count);
@@ -31,7 +32,9 @@ namespace Be::System::Renderer
         for (uint32_t i = 0; i < textures_count; i++)
         {
             auto t = textures_names.at(i).c_str();
-            model->m_textures.push_back(m_texture_manager.Load(t, t));
+            const auto texture = m_texture_manager.Load(t, t);
+            m_texture_manager.AddRef(texture);
+            model->m_textures.push_back(texture);
         }
 
         Array<MaterialBlueprint> material_blueprints;
@@ -3,12 +3,21 @@
 namespace Be::System::Renderer
 {
     
-    class Texture final : public RefCounter
+    // Owned by the TextureManager and referenced by TextureHandle.
+    class Texture final
     {
     public:
-        Texture() noexcept = default;
+        explicit Texture(String key) noexcept
+            : m_key{std::move(key)}
+        {
+        }
 
     public:
+        [[nodiscard]] forceinline const String &GetKey() const noexcept
+        {
+            return m_key;
+        }
+
         [[nodiscard]] forceinline const RhiImageHandle &GetImage() const noexcept
         {
             return m_image;
@@ -33,18 +42,19 @@ namespace Be::System::Renderer
     private:
         void SetImage(const RhiImageHandle &image) noexcept;
 
+    private:
+        String m_key;
+
     private:
         RhiImageHandle m_image;
         RhiImageViewHandle m_image_srv;
         RhiSamplerHandle m_sampler;
 
-    private:
-        Array<RhiSubresourceData> m_data{};
-
         friend class TextureManager;
     };
 
-    DEFINE_RENDERER_HANDLE(Texture);
+    // Slot index and generation of a texture in the TextureManager.
+    using TextureHandle = SlotHandle<Texture>;
 }
 
 #include "systems/renderer/resources/texture/texture_manager.h"
\ No newline at end of file
@@ -123,6 +123,12 @@ namespace Be::System::Renderer
     TextureHandle TextureManager::Load(const String &key, InputStream &stream, ETextureManagerFlag flags) noexcept
     {
         PROFILER_SCOPE;
+        MEMORY_TAG_SCOPE(EMemoryTag::eAssets);
+
+        if (const auto texture = FindTexture(key); texture)
+        {
+            return texture;
+        }
 
         const Path path{key};
 
@@ -154,16 +160,15 @@ namespace Be::System::Renderer
         desc.height = ktx->baseHeight;
         desc.mip_levels = ktx->numLevels;
 
-        auto texture = MakeRefCounter<Texture>();
-        texture->SetImage(m_dummy_image);
-        texture->m_data.reserve(desc.mip_levels);
+        Array<RhiSubresourceData> data;
+        data.reserve(desc.mip_levels);
 
         auto level_width = desc.width;
         auto level_height = desc.height;
 
         for (uint32_t level = 0; level < desc.mip_levels; ++level)
         {
-            auto &subres_data = texture->m_data.emplace_back();
+            auto &subres_data = data.emplace_back();
 
             ktx_size_t offset;
             result = ktxTexture_GetImageOffset((ktxTexture *)ktx, level, 0, 0, &offset);
@@ -178,12 +183,20 @@ namespace Be::System::Renderer
             level_height >>= 1;
         }
 
+        const auto texture = m_textures.Emplace(key);
+        m_textures[texture].SetImage(m_dummy_image);
+        m_texture_ids.emplace(key, texture);
+
+        // The texture may be destroyed before the upload completes, the generation check
+        // keeps the image off a texture that took over its slot.
         auto image = m_driver.CreateImage(desc);
-        m_driver.UploadImage(*image, texture->m_data, ERhiResourceStateEnum::eShaderResource,
-                             [texture, ktx, image]()
+        m_driver.UploadImage(*image, data, ERhiResourceStateEnum::eShaderResource,
+                             [this, texture, ktx, image]()
                              {
-                                 texture->SetImage(image);
-                                 texture->m_data.clear();
+                                 if (auto *loaded = m_textures.Get(texture))
+                                 {
+                                     loaded->SetImage(image);
+                                 }
                                  ktxTexture_Destroy((ktxTexture *)ktx);
                              });
 
@@ -194,6 +207,11 @@ namespace Be::System::Renderer
     {
         PROFILER_SCOPE;
 
+        if (const auto texture = FindTexture(key); texture)
+        {
+            return texture;
+        }
+
         std::ifstream file{path, std::ios::in | std::ios::binary};
         VERIFY(file, "Failed to open texture file: {}", path.string());
 
@@ -201,6 +219,46 @@ namespace Be::System::Renderer
         return Load(key, stream, flags);
     }
 
+    void TextureManager::Unload(TextureHandle texture) noexcept
+    {
+        PROFILER_SCOPE;
+
+        const auto *loaded = m_textures.Get(texture);
+        if (loaded && FindTexture(loaded->GetKey()) == texture)
+        {
+            m_texture_ids.erase(loaded->GetKey());
+            m_textures.Release(texture);
+        }
+    }
+
+    usize_t TextureManager::ReleaseUnused() noexcept
+    {
+        PROFILER_SCOPE;
+
+        // Erasing moves the last texture into the hole, so walk the dense array backwards.
+        // Unloaded textures and the dummy one have no key entry, only their holders
+        // release them.
+        usize_t released{0};
+        for (auto i = m_textures.size(); i-- > 0;)
+        {
+            const auto texture = m_textures.GetHandle(i);
+            const auto &key = m_textures.GetValues()[i].GetKey();
+            if (m_textures.GetRefCount(texture) == 1 && FindTexture(key) == texture)
+            {
+                m_texture_ids.erase(key);
+                m_textures.Release(texture);
+                released++;
+            }
+        }
+        return released;
+    }
+
+    TextureHandle TextureManager::FindTexture(StringView key) const noexcept
+    {
+        const auto it = m_texture_ids.find(key);
+        return it != m_texture_ids.end() ? it->second : TextureHandle{};
+    }
+
     void TextureManager::CreateDummyTextures() noexcept
     {
         RhiImageDesc tex_desc{
@@ -225,8 +283,8 @@ namespace Be::System::Renderer
         subres.level = 0;
 
         m_dummy_image = m_driver.CreateImage(tex_desc);
-        m_dummy_texture = MakeRefCounter<Texture>();
-        m_dummy_texture->SetImage(m_dummy_image);
+        m_dummy_texture = m_textures.Emplace(tex_desc.debug_name);
+        m_textures[m_dummy_texture].SetImage(m_dummy_image);
     }
 
 }
\ No newline at end of file
@@ -5,21 +5,64 @@ namespace Be::System::Renderer
 
     BIT_ENUM(ETextureManagerFlag, uint8_t, eNone = 0);
 
+    // Textures live in the manager and are referenced by TextureHandle, copying a handle
+    // doesn't count. Holders that need a texture to stay loaded take a reference with
+    // AddRef and drop it with Release, the manager holds one of its own until the
+    // texture is unloaded.
     class TextureManager final : public Noncopyable
     {
     public:
         TextureManager(RhiDriver &driver) noexcept;
 
     public:
+        // A key that is already loaded returns the cached texture, the stream is not read.
         [[nodiscard]] TextureHandle Load(const String &key, InputStream &stream, ETextureManagerFlag flags = ETextureManagerFlag::eNone) noexcept;
         [[nodiscard]] TextureHandle Load(const String &key, const Path &path, ETextureManagerFlag flags = ETextureManagerFlag::eNone) noexcept;
 
+        // Drops the manager reference and forgets the key, the texture lives on while
+        // other references exist.
+        void Unload(TextureHandle texture) noexcept;
+
+        forceinline void AddRef(TextureHandle texture) noexcept
+        {
+            m_textures.AddRef(texture);
+        }
+
+        // The texture is destroyed with the last reference.
+        forceinline void Release(TextureHandle texture) noexcept
+        {
+            m_textures.Release(texture);
+        }
+
+        // Destroys the loaded textures no one else holds a reference to and returns how
+        // many were released. Called between frames, the texture is destroyed right away.
+        usize_t ReleaseUnused() noexcept;
+
+    public:
+        [[nodiscard]] TextureHandle FindTexture(StringView key) const noexcept;
+
+        // Null for a texture that was destroyed.
+        [[nodiscard]] forceinline const Texture *GetTexture(TextureHandle texture) const noexcept
+        {
+            return m_textures.Get(texture);
+        }
+
+        // Dense view of the textures for residency and streaming passes.
+        [[nodiscard]] forceinline Span<const Texture> GetTextures() const noexcept
+        {
+            return m_textures.GetValues();
+        }
+
     private:
         void CreateDummyTextures() noexcept;
 
     private:
         RhiDriver &m_driver;
 
+    private:
+        SlotMap<Texture, true> m_textures;
+        FlatHashMap<String, TextureHandle, StringHash, std::equal_to<>> m_texture_ids;
+
     private:
         TextureHandle m_dummy_texture;
         RhiImageHandle m_dummy_image;
@@ -58,10 +58,16 @@ struct MeshletTriangle
 #define MeshletTriangle uint32_t
 #endif
 
+// Box and bounding sphere share the center. The triangles of the meshlet face away from
+// the camera when dot(center - camera, cone_axis) >= cone_cutoff * length(center - camera) + radius.
 struct MeshletBounds
 {
 	vec3 center;
+	float radius;
 	vec3 extents;
+	float cone_cutoff;
+	vec3 cone_axis;
+	float pad;
 };
 
 #ifdef __cplusplus
@@ -2,11 +2,25 @@
 
 extern void UnitTest_Mallocs();
 extern void UnitTest_Allocators();
+extern void UnitTest_Containers();
+extern void UnitTest_Algorithms();
+extern void UnitTest_Hash();
+extern void UnitTest_MemoryTracker();
+extern void UnitTest_RefCounter();
+extern void UnitTest_NameTable();
+extern void UnitTest_Logger();
 
 int main()
 {
     UnitTest_Mallocs();
     UnitTest_Allocators();
+    UnitTest_Containers();
+    UnitTest_Algorithms();
+    UnitTest_Hash();
+    UnitTest_MemoryTracker();
+    UnitTest_RefCounter();
+    UnitTest_NameTable();
+    UnitTest_Logger();
     
     return 0;
 }
\ No newline at end of file
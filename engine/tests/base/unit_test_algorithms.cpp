@@ -0,0 +1,945 @@
+#include "unit_tests_common.h"
+
+namespace
+{
+    using namespace Be;
+
+    // Render queue style keys: a few high bits of group and material, depth below.
+    [[nodiscard]] Array<uint64_t> MakeSortKeys(usize_t count, uint64_t seed)
+    {
+        Array<uint64_t> keys(count);
+        std::mt19937_64 rng{seed};
+        for (auto &key : keys)
+        {
+            key = (rng() & 0xFF00'0000'FFFF'FFFFull);
+        }
+        return keys;
+    }
+
+    void RadixSort_Test(usize_t count)
+    {
+        for (const auto size : {usize_t(0), usize_t(1), usize_t(100), count})
+        {
+            auto keys = MakeSortKeys(size, size);
+
+            // Every key appears twice to check the order of equal keys.
+            keys.insert(keys.end(), keys.begin(), keys.end());
+
+            Array<uint32_t> values(keys.size());
+            std::iota(values.begin(), values.end(), 0u);
+
+            Array<Pair<uint64_t, uint32_t>> expected(keys.size());
+            for (usize_t i = 0; i < keys.size(); i++)
+            {
+                expected[i] = {keys[i], values[i]};
+            }
+            std::stable_sort(expected.begin(), expected.end(),
+                             [](const auto &a, const auto &b)
+                             { return a.first < b.first; });
+
+            Array<uint64_t> temp_keys(keys.size());
+            Array<uint32_t> temp_values(keys.size());
+            RadixSort(keys, values, temp_keys, temp_values);
+
+            for (usize_t i = 0; i < keys.size(); i++)
+            {
+                TEST(keys[i] == expected[i].first && values[i] == expected[i].second, "Wrong sort order");
+            }
+        }
+
+        // All keys equal: every pass is skipped.
+        Array<uint64_t> keys(count, 42);
+        Array<uint32_t> values(count);
+        std::iota(values.begin(), values.end(), 0u);
+        Array<uint64_t> temp_keys(count);
+        Array<uint32_t> temp_values(count);
+        RadixSort(keys, values, temp_keys, temp_values);
+        TEST(std::is_sorted(values.begin(), values.end()), "Uniform keys must keep their order");
+    }
+
+    // Sorting the render queue: std::sort of 32-byte items against radix sort of keys
+    // with indices plus one gather of the items.
+    void RadixSort_Benchmark(usize_t count)
+    {
+        struct Item
+        {
+            void *function;
+            const void *data;
+            uint64_t hash;
+            uint64_t sorting_key;
+        };
+
+        const auto keys = MakeSortKeys(count, 1);
+        Array<Item> items(count);
+        for (usize_t i = 0; i < count; i++)
+        {
+            items[i].sorting_key = keys[i];
+        }
+
+        auto std_items = items;
+        const auto std_begins = Clock::now();
+        std::sort(std_items.begin(), std_items.end(),
+                  [](const auto &a, const auto &b)
+                  { return a.sorting_key < b.sorting_key; });
+        const auto std_ends = Clock::now();
+
+        Array<uint64_t> sort_keys(count), temp_keys(count);
+        Array<uint32_t> indices(count), temp_indices(count);
+        Array<Item> radix_items(count);
+
+        const auto radix_begins = Clock::now();
+        for (usize_t i = 0; i < count; i++)
+        {
+            sort_keys[i] = items[i].sorting_key;
+            indices[i] = uint32_t(i);
+        }
+        RadixSort(sort_keys, indices, temp_keys, temp_indices);
+        for (usize_t i = 0; i < count; i++)
+        {
+            radix_items[i] = items[indices[i]];
+        }
+        const auto radix_ends = Clock::now();
+
+        for (usize_t i = 0; i < count; i++)
+        {
+            TEST(radix_items[i].sorting_key == std_items[i].sorting_key, "Wrong result");
+        }
+
+        LOG_INFO("Sort {} items avg time:\tstd::sort {}, radix {}", count,
+                 (std_ends - std_begins).count() / int64_t(count), (radix_ends - radix_begins).count() / int64_t(count));
+    }
+
+    // Boxes scattered around a camera at the origin looking along +z.
+    [[nodiscard]] Array<BBox> MakeCullingBoxes(usize_t count, uint64_t seed)
+    {
+        std::mt19937_64 rng{seed};
+        std::uniform_real_distribution<double> position{-100.0, 100.0};
+        std::uniform_real_distribution<double> size{0.1, 2.0};
+
+        Array<BBox> boxes(count);
+        for (auto &box : boxes)
+        {
+            const Vector3 center{position(rng), position(rng), position(rng)};
+            const Vector3 extent{size(rng), size(rng), size(rng)};
+            box = BBox{center - extent, center + extent};
+        }
+        return boxes;
+    }
+
+    [[nodiscard]] Frustum MakeCullingFrustum()
+    {
+        return Frustum::FromMatrix(Math::Perspective(Math::Radians(90.0), 1.0, 0.1, 100.0), false);
+    }
+
+    // Bookkeeping of the retained render queue items: the order is kept between frames
+    // and only the changed items are sorted and merged back.
+    void IncrementalSort_Test(usize_t count)
+    {
+        struct Item
+        {
+            uint64_t sorting_key;
+            uint64_t sequence; // When the item was queued, orders the entries of equal keys.
+            uint32_t version;
+            bool queued;
+        };
+
+        using Handle = SlotHandle<Item>;
+
+        SlotMap<Item> items;
+        IncrementalSort<Handle> order;
+        Array<Handle> handles;
+        uint64_t sequence{0};
+        std::mt19937_64 rng{count};
+
+        const auto add = [&](uint64_t key)
+        {
+            const auto handle = items.Emplace(Item{key, sequence++, 0, true});
+            order.Queue(handle);
+            handles.push_back(handle);
+        };
+        const auto set_key = [&](Handle handle, uint64_t key)
+        {
+            auto &item = items[handle];
+            item.sorting_key = key;
+            item.version++;
+            if (!item.queued)
+            {
+                item.queued = true;
+                item.sequence = sequence++;
+                order.Queue(handle);
+            }
+        };
+        const auto remove = [&](usize_t index)
+        {
+            items.Erase(handles[index]);
+            order.Queue(handles[index]);
+            handles[index] = handles.back();
+            handles.pop_back();
+        };
+
+        const auto collect = [&items](Handle handle, IncrementalSort<Handle>::Entry &entry)
+        {
+            auto *item = items.Get(handle);
+            if (!item || !item->queued)
+            {
+                return false;
+            }
+            item->queued = false;
+            entry.sorting_key = item->sorting_key;
+            entry.version = item->version;
+            return true;
+        };
+        const auto is_current = [&items](const IncrementalSort<Handle>::Entry &entry)
+        {
+            const auto *item = items.Get(entry.handle);
+            return item && item->version == entry.version;
+        };
+
+        // Every live item once, by key and then by the time it was queued.
+        const auto check = [&]
+        {
+            const auto sorted = order.GetSorted();
+            TEST(sorted.size() == items.size(), "Stale entries are kept");
+            for (usize_t i = 0; i < sorted.size(); i++)
+            {
+                TEST(is_current(sorted[i]), "Stale entry is kept");
+                TEST(sorted[i].sorting_key == items[sorted[i].handle].sorting_key, "Entry has an old key");
+                if (i > 0)
+                {
+                    const auto &a = items[sorted[i - 1].handle];
+                    const auto &b = items[sorted[i].handle];
+                    TEST(a.sorting_key < b.sorting_key || (a.sorting_key == b.sorting_key && a.sequence < b.sequence), "Wrong merge order");
+                }
+            }
+        };
+
+        // Few distinct keys, so that kept and queued entries often share them.
+        for (usize_t i = 0; i < count; i++)
+        {
+            add(rng() % 64);
+        }
+        TEST(order.Update(collect, is_current), "Queued items are not sorted");
+        check();
+
+        const auto *sorted = order.GetSorted().data();
+        TEST(!order.Update(collect, is_current) && order.GetSorted().data() == sorted, "Unchanged order is sorted again");
+
+        for (usize_t frame = 0; frame < 4; frame++)
+        {
+            for (usize_t i = 0; i < count / 20; i++)
+            {
+                // Some items are re-keyed twice before the update.
+                set_key(handles[rng() % handles.size()], rng() % 64);
+            }
+            for (usize_t i = 0; i < count / 50; i++)
+            {
+                remove(rng() % handles.size());
+            }
+            for (usize_t i = 0; i < count / 100; i++)
+            {
+                add(rng() % 64);
+            }
+
+            TEST(order.Update(collect, is_current), "Changed items are not merged");
+            check();
+        }
+
+        // A removed item is dropped even when nothing else changed.
+        remove(0);
+        TEST(order.Update(collect, is_current), "Removed item is not dropped");
+        check();
+    }
+
+    // Packing the instance payloads of the render queue batches.
+    void InstancePacker_Test()
+    {
+        struct Batch
+        {
+            usize_t stride;
+            usize_t count;
+            uint32_t expected_first;
+        };
+
+        // A batch starts at the first multiple of its stride after the end of the previous one.
+        const Batch batches[] = {{12, 3, 0}, {16, 5, 3}, {48, 2, 3}, {0, 4, 0}, {12, 1, 20}};
+
+        Array<byte_t> memory(1024);
+        InstancePacker packer;
+        packer.Reset(memory.data(), memory.size());
+
+        Array<uint32_t> firsts;
+        for (usize_t b = 0; b < std::size(batches); b++)
+        {
+            const auto &batch = batches[b];
+            const auto first = packer.Reserve(batch.stride, batch.count);
+            TEST(first == batch.expected_first, "Batch doesn't start at a multiple of its stride");
+            firsts.push_back(first);
+
+            std::memset(packer.GetPayload(batch.stride, first), int(b + 1), batch.stride * batch.count);
+        }
+
+        // No batch overwrote another one.
+        for (usize_t b = 0; b < std::size(batches); b++)
+        {
+            const auto &batch = batches[b];
+            const auto *payload = packer.GetPayload(batch.stride, firsts[b]);
+            TEST(std::all_of(payload, payload + batch.stride * batch.count, [b](byte_t value)
+                             { return value == byte_t(b + 1); }),
+                 "Batches overlap");
+        }
+
+        auto stats = packer.GetStats();
+        TEST(stats.item_count == 15 && stats.batch_count == 5 && stats.instance_bytes == 224 && stats.dropped_count == 0, "Wrong stats");
+        TEST(stats.GetInstancingRatio() == 3.0f, "Wrong instancing ratio");
+
+        // A batch that doesn't fit is dropped and reported, the next frame can grow.
+        TEST(packer.Reserve(64, 100) == InstancePacker::INVALID_INDEX, "Overflowing batch is packed");
+        stats = packer.GetStats();
+        TEST(stats.dropped_count == 100 && stats.item_count == 15 && stats.batch_count == 5, "Dropped batch is counted as drawn");
+        // The 252 bytes of the packed batches plus the dropped one.
+        TEST(packer.GetRequestedSize() >= 252 + 64 * 100, "Requested size doesn't cover the dropped batch");
+        TEST(packer.Reserve(4, 1) != InstancePacker::INVALID_INDEX, "Batch that fits is dropped after an overflow");
+
+        packer.Reset(memory.data(), memory.size());
+        stats = packer.GetStats();
+        TEST(stats.item_count == 0 && stats.dropped_count == 0 && stats.GetInstancingRatio() == 0.0f && packer.GetRequestedSize() == 0, "Reset keeps the stats");
+    }
+
+    void FrustumCull_Test(usize_t count)
+    {
+        const auto frustum = MakeCullingFrustum();
+
+        CullingBounds near_bounds;
+        PushCullingBounds(near_bounds, BBox{Vector3{-1.0, -1.0, 9.0}, Vector3{1.0, 1.0, 11.0}});
+        PushCullingBounds(near_bounds, BBox{Vector3{-1.0, -1.0, -11.0}, Vector3{1.0, 1.0, -9.0}});
+        PushCullingBounds(near_bounds, BBox{Vector3{49.0, -1.0, 9.0}, Vector3{51.0, 1.0, 11.0}});
+        PushCullingBounds(near_bounds, BBox{Vector3{9.0, -1.0, 9.0}, Vector3{11.0, 1.0, 11.0}});
+        uint32_t near_visible[4];
+        TEST(FrustumCull(frustum, near_bounds, 0, 4, near_visible) == 2 && near_visible[0] == 0 && near_visible[1] == 3, "Wrong visibility");
+
+        const auto boxes = MakeCullingBoxes(count, 1);
+        CullingBounds bounds;
+        for (const auto &box : boxes)
+        {
+            PushCullingBounds(bounds, box);
+        }
+
+        Array<uint32_t> visible(count);
+        const auto visible_count = FrustumCull(frustum, bounds, 0, count, visible.data());
+        TEST(visible_count > 0 && visible_count < count, "Nothing culled");
+        TEST(std::is_sorted(visible.begin(), visible.begin() + visible_count), "Indices must keep the order");
+
+        // SIMD groups and the scalar path agree, whatever the range alignment.
+        Array<uint8_t> is_visible(count, 0);
+        for (usize_t i = 0; i < visible_count; i++)
+        {
+            is_visible[visible[i]] = 1;
+        }
+        uint32_t single;
+        for (usize_t i = 0; i < count; i++)
+        {
+            TEST(FrustumCull(frustum, bounds, i, i + 1, &single) == is_visible[i], "SIMD and scalar results differ");
+            TEST(!frustum.Intersects(boxes[i]) || is_visible[i], "Culling must be conservative");
+        }
+
+        const auto offset_count = FrustumCull(frustum, bounds, 3, count - 5, visible.data());
+        for (usize_t i = 0; i < offset_count; i++)
+        {
+            TEST(is_visible[visible[i]], "Wrong result for an unaligned range");
+        }
+        TEST(offset_count == usize_t(std::count(is_visible.begin() + 3, is_visible.end() - 5, 1)), "Wrong count for an unaligned range");
+    }
+
+    void FrustumCull_Benchmark(usize_t count)
+    {
+        const auto frustum = MakeCullingFrustum();
+        const auto boxes = MakeCullingBoxes(count, count);
+
+        CullingBounds bounds;
+        for (const auto &box : boxes)
+        {
+            PushCullingBounds(bounds, box);
+        }
+
+        Array<uint32_t> scalar_visible;
+        scalar_visible.reserve(count);
+        const auto scalar_begins = Clock::now();
+        for (usize_t i = 0; i < count; i++)
+        {
+            if (frustum.Intersects(boxes[i]))
+            {
+                scalar_visible.push_back(uint32_t(i));
+            }
+        }
+        const auto scalar_ends = Clock::now();
+
+        Array<uint32_t> visible(count);
+        const auto simd_begins = Clock::now();
+        const auto visible_count = FrustumCull(frustum, bounds, 0, count, visible.data());
+        const auto simd_ends = Clock::now();
+
+        TEST(visible_count >= scalar_visible.size(), "Culling must be conservative");
+
+        LOG_INFO("Frustum cull {} boxes avg time:\tscalar {}, simd {}, visible {}", count,
+                 (scalar_ends - scalar_begins).count() / int64_t(count), (simd_ends - simd_begins).count() / int64_t(count), visible_count);
+    }
+
+    [[nodiscard]] bool Overlaps(const BBox &a, const BBox &b, double margin)
+    {
+        return a.min.x <= b.max.x + margin && a.max.x >= b.min.x - margin &&
+               a.min.y <= b.max.y + margin && a.max.y >= b.min.y - margin &&
+               a.min.z <= b.max.z + margin && a.max.z >= b.min.z - margin;
+    }
+
+    [[nodiscard]] BBox Grown(const BBox &box, double margin)
+    {
+        return BBox{box.min - Vector3{margin}, box.max + Vector3{margin}};
+    }
+
+    [[nodiscard]] double RayDistance(const BBox &box, const Vector3 &origin, const Vector3 &direction)
+    {
+        double entry{0.0}, exit{std::numeric_limits<double>::infinity()};
+        for (uint8_t axis = 0; axis < 3; axis++)
+        {
+            const auto t0 = (box.min[axis] - origin[axis]) / direction[axis];
+            const auto t1 = (box.max[axis] - origin[axis]) / direction[axis];
+            entry = std::max(entry, std::min(t0, t1));
+            exit = std::min(exit, std::max(t0, t1));
+        }
+        return entry <= exit ? entry : std::numeric_limits<double>::infinity();
+    }
+
+    // Everything the exact test finds and nothing beyond a small margin.
+    void Bvh_CheckQueries(const Bvh &bvh, const Array<BBox> &boxes, std::mt19937_64 &rng)
+    {
+        constexpr double MARGIN = 1e-3;
+        constexpr usize_t QUERIES = 50;
+
+        const auto frustum = MakeCullingFrustum();
+        Array<uint32_t> visible(boxes.size());
+        const auto visible_count = bvh.Cull(frustum, visible.data());
+
+        Array<uint8_t> is_visible(boxes.size(), 0);
+        for (usize_t i = 0; i < visible_count; i++)
+        {
+            TEST(!is_visible[visible[i]], "Box culled twice");
+            is_visible[visible[i]] = 1;
+        }
+        for (usize_t i = 0; i < boxes.size(); i++)
+        {
+            TEST(!frustum.Intersects(boxes[i]) || is_visible[i], "Culling must be conservative");
+            TEST(!is_visible[i] || frustum.Intersects(Grown(boxes[i], MARGIN)), "Invisible box not culled");
+        }
+
+        std::uniform_real_distribution<double> position{-100.0, 100.0};
+        std::uniform_real_distribution<double> size{1.0, 20.0};
+        for (usize_t query = 0; query < QUERIES; query++)
+        {
+            const Vector3 center{position(rng), position(rng), position(rng)};
+            const BBox query_box{center - Vector3{size(rng)}, center + Vector3{size(rng)}};
+
+            Array<uint8_t> found(boxes.size(), 0);
+            bvh.Overlap(query_box, [&](uint32_t i)
+                        { found[i]++; });
+            for (usize_t i = 0; i < boxes.size(); i++)
+            {
+                TEST(found[i] <= 1, "Box found twice");
+                TEST(!Overlaps(boxes[i], query_box, 0.0) || found[i], "Overlapping box not found");
+                TEST(!found[i] || Overlaps(boxes[i], query_box, MARGIN), "Wrong overlapping box");
+            }
+
+            const Vector3 origin{position(rng), position(rng), position(rng)};
+            const auto direction = Vector3{position(rng), position(rng), position(rng)} - origin;
+
+            auto expected = std::numeric_limits<double>::infinity();
+            for (const auto &box : boxes)
+            {
+                expected = std::min(expected, RayDistance(box, origin, direction));
+            }
+
+            auto nearest = std::numeric_limits<double>::infinity();
+            bvh.Raycast(origin, direction, 1.0f, [&](uint32_t i, float &max_distance)
+                        {
+                            const auto distance = RayDistance(boxes[i], origin, direction);
+                            if (distance < nearest)
+                            {
+                                nearest = distance;
+                                max_distance = float(distance);
+                            } });
+            TEST((expected > 1.0 && nearest > 1.0) || std::abs(nearest - expected) < MARGIN, "Wrong nearest hit");
+        }
+    }
+
+    void Bvh_Test(usize_t count)
+    {
+        std::mt19937_64 rng{count};
+
+        for (const auto size : {usize_t(0), usize_t(1), usize_t(3), usize_t(100), count})
+        {
+            auto boxes = MakeCullingBoxes(size, size);
+
+            Bvh bvh;
+            bvh.Build(boxes);
+            TEST(bvh.size() == size, "Wrong BVH size");
+            Bvh_CheckQueries(bvh, boxes, rng);
+
+            std::uniform_real_distribution<double> offset{-5.0, 5.0};
+            for (auto &box : boxes)
+            {
+                const Vector3 move{offset(rng), offset(rng), offset(rng)};
+                box = BBox{box.min + move, box.max + move};
+            }
+            bvh.Refit(boxes);
+            Bvh_CheckQueries(bvh, boxes, rng);
+        }
+
+        // Boxes at one place still make a tree of bounded depth.
+        const Array<BBox> same(count, BBox{Vector3{1.0}, Vector3{2.0}});
+        Bvh bvh;
+        bvh.Build(same);
+        Bvh_CheckQueries(bvh, same, rng);
+    }
+
+    void Bvh_Benchmark(usize_t count)
+    {
+        const auto frustum = MakeCullingFrustum();
+        const auto boxes = MakeCullingBoxes(count, count);
+
+        CullingBounds bounds;
+        for (const auto &box : boxes)
+        {
+            PushCullingBounds(bounds, box);
+        }
+
+        Array<uint32_t> visible(count);
+        const auto flat_begins = Clock::now();
+        const auto flat_count = FrustumCull(frustum, bounds, 0, count, visible.data());
+        const auto flat_ends = Clock::now();
+
+        Bvh bvh;
+        const auto build_begins = Clock::now();
+        bvh.Build(boxes);
+        const auto build_ends = Clock::now();
+
+        const auto refit_begins = Clock::now();
+        bvh.Refit(boxes);
+        const auto refit_ends = Clock::now();
+
+        const auto cull_begins = Clock::now();
+        const auto bvh_count = bvh.Cull(frustum, visible.data());
+        const auto cull_ends = Clock::now();
+
+        TEST(bvh_count > 0 && bvh_count <= flat_count + count / 1000, "Wrong visible count");
+
+        LOG_INFO("BVH {} boxes avg time:\tbuild {}, refit {}, flat cull {}, bvh cull {}", count,
+                 (build_ends - build_begins).count() / int64_t(count), (refit_ends - refit_begins).count() / int64_t(count),
+                 (flat_ends - flat_begins).count() / int64_t(count), (cull_ends - cull_begins).count() / int64_t(count));
+
+        // Small queries touch a few nodes instead of every box.
+        constexpr usize_t QUERIES = 1000;
+        std::mt19937_64 rng{count};
+        std::uniform_real_distribution<double> position{-100.0, 100.0};
+
+        usize_t found{0};
+        const auto overlap_begins = Clock::now();
+        for (usize_t query = 0; query < QUERIES; query++)
+        {
+            const Vector3 center{position(rng), position(rng), position(rng)};
+            bvh.Overlap(BBox{center - Vector3{2.0}, center + Vector3{2.0}}, [&](uint32_t)
+                        { found++; });
+        }
+        const auto overlap_ends = Clock::now();
+
+        usize_t hits{0};
+        const auto ray_begins = Clock::now();
+        for (usize_t query = 0; query < QUERIES; query++)
+        {
+            const Vector3 origin{position(rng), position(rng), position(rng)};
+            const auto direction = Vector3{position(rng), position(rng), position(rng)} - origin;
+            bvh.Raycast(origin, direction, 1.0f, [&](uint32_t i, float &max_distance)
+                        {
+                            hits++;
+                            max_distance = std::min(max_distance, float(RayDistance(boxes[i], origin, direction))); });
+        }
+        const auto ray_ends = Clock::now();
+
+        LOG_INFO("BVH {} boxes avg query time:\toverlap {}, raycast {}, found {}, hits {}", count,
+                 (overlap_ends - overlap_begins).count() / int64_t(QUERIES), (ray_ends - ray_begins).count() / int64_t(QUERIES), found, hits);
+    }
+
+    // Closed box as an occluder, twelve triangles.
+    void AddBoxOccluder(OcclusionBuffer &buffer, const BBox &box, const Matrix4x4 &view_projection)
+    {
+        Array<Float3> positions;
+        for (uint32_t corner = 0; corner < 8; corner++)
+        {
+            positions.emplace_back(float((corner & 1) ? box.max.x : box.min.x), float((corner & 2) ? box.max.y : box.min.y),
+                                   float((corner & 4) ? box.max.z : box.min.z));
+        }
+        const Array<uint32_t> indices{0, 1, 3, 0, 3, 2, 4, 5, 7, 4, 7, 6, 0, 1, 5, 0, 5, 4,
+                                      2, 3, 7, 2, 7, 6, 0, 2, 6, 0, 6, 4, 1, 3, 7, 1, 7, 5};
+        buffer.AddOccluder(positions, indices, view_projection);
+    }
+
+    void OcclusionBuffer_Test()
+    {
+        const auto view_projection = Math::Perspective(Math::Radians(90.0), 1.0, 0.1, 100.0);
+        const auto box = [](double x0, double y0, double z0, double x1, double y1, double z1)
+        { return BBox{Vector3{x0, y0, z0}, Vector3{x1, y1, z1}}; };
+
+        OcclusionBuffer buffer{256, 256};
+        buffer.Begin(view_projection);
+
+        // A wall facing the camera.
+        const Array<Float3> wall{{-5.0f, -5.0f, 10.0f}, {5.0f, -5.0f, 10.0f}, {5.0f, 5.0f, 10.0f}, {-5.0f, 5.0f, 10.0f}};
+        const Array<uint32_t> wall_indices{0, 1, 2, 0, 2, 3};
+        buffer.AddOccluder(wall, wall_indices, view_projection);
+        buffer.Rasterize();
+
+        TEST(std::abs(buffer.GetDepth(128, 128) - 0.1f) < 1e-4f && buffer.GetDepth(10, 10) == 0.0f, "Wrong occluder depth");
+
+        TEST(!buffer.IsVisible(box(-2, -2, 20, 2, 2, 22)), "Box behind the wall must be hidden");
+        TEST(!buffer.IsVisible(box(-9, -9, 19, 9, 9, 21)), "Box behind the wall must be hidden");
+        TEST(buffer.IsVisible(box(-1, -1, 5, 1, 1, 6)), "Box in front of the wall must be visible");
+        TEST(buffer.IsVisible(box(8, -1, 20, 12, 1, 22)), "Box partly beside the wall must be visible");
+        TEST(buffer.IsVisible(box(14, -1, 20, 16, 1, 22)), "Box beside the wall must be visible");
+        TEST(buffer.IsVisible(box(-1, -1, -1, 1, 1, 20)), "Box crossing the near plane must be visible");
+        TEST(buffer.IsVisible(box(-1, -1, -20, 1, 1, -18)), "Box behind the camera is left to frustum culling");
+
+        // A floor crossing the near plane is clipped, what is below it is hidden.
+        buffer.Begin(view_projection);
+        const Array<Float3> floor{{-50.0f, -2.0f, -10.0f}, {50.0f, -2.0f, -10.0f}, {50.0f, -2.0f, 30.0f}, {-50.0f, -2.0f, 30.0f}};
+        buffer.AddOccluder(floor, wall_indices, view_projection);
+        buffer.Rasterize();
+
+        TEST(!buffer.IsVisible(box(-1, -6, 19, 1, -4, 21)), "Box below the floor must be hidden");
+        TEST(buffer.IsVisible(box(-1, -1, 19, 1, 1, 21)), "Box above the floor must be visible");
+
+        const Array<BBox> bounds{box(-1, -6, 19, 1, -4, 21), box(-1, -1, 19, 1, 1, 21), box(3, -9, 10, 4, -8, 11)};
+        const Array<uint32_t> candidates{2, 1, 0};
+        uint32_t visible[3];
+        TEST(buffer.Cull(bounds, candidates, visible) == 1 && visible[0] == 1, "Wrong culling result");
+    }
+
+    void OcclusionBuffer_Benchmark(usize_t count)
+    {
+        const auto view_projection = Math::Perspective(Math::Radians(90.0), 1.0, 0.1, 1000.0);
+
+        // A street of buildings in front of the camera, the boxes are spread behind them.
+        OcclusionBuffer buffer{256, 128};
+        buffer.Begin(view_projection);
+
+        const auto rasterize_begins = Clock::now();
+        for (int i = -8; i < 8; i++)
+        {
+            AddBoxOccluder(buffer, BBox{Vector3{i * 12.0, -10.0, 30.0}, Vector3{i * 12.0 + 10.0, 20.0, 40.0}}, view_projection);
+        }
+        buffer.Rasterize();
+        const auto rasterize_ends = Clock::now();
+
+        std::mt19937_64 rng{count};
+        std::uniform_real_distribution<double> position{-200.0, 200.0};
+        std::uniform_real_distribution<double> depth{50.0, 400.0};
+        Array<BBox> bounds(count);
+        for (auto &box : bounds)
+        {
+            const Vector3 center{position(rng), position(rng) * 0.1, depth(rng)};
+            box = BBox{center - Vector3{1.0}, center + Vector3{1.0}};
+        }
+
+        Array<uint32_t> candidates(count), visible(count);
+        std::iota(candidates.begin(), candidates.end(), 0u);
+
+        const auto cull_begins = Clock::now();
+        const auto visible_count = buffer.Cull(bounds, candidates, visible.data());
+        const auto cull_ends = Clock::now();
+
+        TEST(visible_count > 0 && visible_count < count, "Nothing occluded");
+
+        LOG_INFO("Occlusion cull {} boxes:\t{} triangles rasterize time {}, avg test time {}, visible {}", count, buffer.GetTriangleCount(),
+                 (rasterize_ends - rasterize_begins).count(), (cull_ends - cull_begins).count() / int64_t(count), visible_count);
+    }
+
+    // Meshlets scattered like the culling boxes, with random normal cones.
+    [[nodiscard]] MeshletCullingBounds MakeMeshletBounds(usize_t count, uint64_t seed)
+    {
+        std::mt19937_64 rng{seed};
+        std::uniform_real_distribution<float> position{-100.0f, 100.0f};
+        std::uniform_real_distribution<float> radius{0.1f, 2.0f};
+        std::uniform_real_distribution<float> cutoff{-0.2f, 1.0f};
+        std::normal_distribution<float> axis{};
+
+        MeshletCullingBounds bounds;
+        for (usize_t i = 0; i < count; i++)
+        {
+            const Float3 center{position(rng), position(rng), position(rng)};
+            const auto cone_axis = Math::Normalize(Float3{axis(rng), axis(rng), axis(rng)});
+            PushMeshletCullingBounds(bounds, center, radius(rng), cone_axis, cutoff(rng));
+        }
+        return bounds;
+    }
+
+    void MeshletCull_Test(usize_t count)
+    {
+        const auto frustum = MakeCullingFrustum();
+        const Float3 camera{0.0f};
+
+        // Facing the camera, facing away, facing away without a cone, out of the frustum,
+        // partly in the frustum. The same meshlets at half size in a mesh scaled twice.
+        MeshletCullingBounds near_bounds, scaled_bounds;
+        const auto push = [&](const Float3 &center, const Float3 &cone_axis, float cone_cutoff)
+        {
+            PushMeshletCullingBounds(near_bounds, center, 1.0f, cone_axis, cone_cutoff);
+            PushMeshletCullingBounds(scaled_bounds, center * 0.5f, 0.5f, cone_axis, cone_cutoff);
+        };
+        push(Float3{0.0f, 0.0f, 10.0f}, Float3{0.0f, 0.0f, -1.0f}, 0.5f);
+        push(Float3{0.0f, 0.0f, 10.0f}, Float3{0.0f, 0.0f, 1.0f}, 0.5f);
+        push(Float3{0.0f, 0.0f, 10.0f}, Float3{0.0f, 0.0f, 1.0f}, 1.0f);
+        push(Float3{50.0f, 0.0f, 10.0f}, Float3{0.0f, 0.0f, -1.0f}, 0.5f);
+        push(Float3{10.5f, 0.0f, 10.0f}, Float3{0.0f, 0.0f, -1.0f}, 0.5f);
+
+        uint32_t near_visible[5];
+        TEST(MeshletCull(frustum, camera, near_bounds, 0, 5, near_visible) == 3 && near_visible[0] == 0 && near_visible[1] == 2 && near_visible[2] == 4,
+             "Wrong visibility");
+
+        const auto scaled_frustum = frustum.GetTransformed(Math::Scale(Vector4{2.0, 2.0, 2.0, 1.0}));
+        TEST(MeshletCull(scaled_frustum, camera, scaled_bounds, 0, 5, near_visible) == 3 && near_visible[0] == 0 && near_visible[1] == 2 && near_visible[2] == 4,
+             "Wrong visibility in the mesh space");
+
+        const auto bounds = MakeMeshletBounds(count, 1);
+        Array<uint32_t> visible(count);
+        const auto visible_count = MeshletCull(frustum, camera, bounds, 0, count, visible.data());
+        TEST(visible_count > 0 && visible_count < count, "Nothing culled");
+        TEST(std::is_sorted(visible.begin(), visible.begin() + visible_count), "Indices must keep the order");
+
+        // SIMD groups and the scalar path agree, whatever the range alignment.
+        Array<uint8_t> is_visible(count, 0);
+        for (usize_t i = 0; i < visible_count; i++)
+        {
+            is_visible[visible[i]] = 1;
+        }
+        uint32_t single;
+        for (usize_t i = 0; i < count; i++)
+        {
+            TEST(MeshletCull(frustum, camera, bounds, i, i + 1, &single) == is_visible[i], "SIMD and scalar results differ");
+        }
+
+        const auto offset_count = MeshletCull(frustum, camera, bounds, 3, count - 5, visible.data());
+        TEST(offset_count == usize_t(std::count(is_visible.begin() + 3, is_visible.end() - 5, 1)), "Wrong count for an unaligned range");
+    }
+
+    void MeshletCull_Benchmark(usize_t count)
+    {
+        const auto frustum = MakeCullingFrustum();
+        const auto bounds = MakeMeshletBounds(count, count);
+
+        // The same spheres without cones give the frustum only result.
+        using namespace MeshletCullingBoundsColumn;
+        MeshletCullingBounds spheres;
+        for (usize_t i = 0; i < count; i++)
+        {
+            PushMeshletCullingBounds(spheres, Float3{bounds.GetColumn<eCenterX>()[i], bounds.GetColumn<eCenterY>()[i], bounds.GetColumn<eCenterZ>()[i]},
+                                     bounds.GetColumn<eRadius>()[i], Float3{0.0f, 0.0f, 1.0f}, 1.0f);
+        }
+
+        Array<uint32_t> visible(count);
+        const auto frustum_count = MeshletCull(frustum, Float3{0.0f}, spheres, 0, count, visible.data());
+
+        const auto cull_begins = Clock::now();
+        const auto visible_count = MeshletCull(frustum, Float3{0.0f}, bounds, 0, count, visible.data());
+        const auto cull_ends = Clock::now();
+
+        TEST(visible_count <= frustum_count, "Cones must only remove meshlets");
+
+        LOG_INFO("Meshlet cull {} meshlets avg time:\t{}, in frustum {}, visible {}", count,
+                 (cull_ends - cull_begins).count() / int64_t(count), frustum_count, visible_count);
+    }
+
+    // T * R * S with column vectors in double precision, the rotation from Quaternion::ToMatrix.
+    [[nodiscard]] Matrix4x4 MakeLocalMatrix(const Float3 &position, const Quatf &rotation, const Float3 &scale)
+    {
+        const auto r = rotation.ToMatrix();
+
+        Matrix4x4 local;
+        for (uint8_t row = 0; row < 3; row++)
+        {
+            for (uint8_t col = 0; col < 3; col++)
+            {
+                local.data[row][col] = double(r.data[col][row]) * double(scale[col]);
+            }
+            local.data[row][3] = double(position[row]);
+        }
+        return local;
+    }
+
+    [[nodiscard]] bool IsNear(const Float4x4 &lhs, const Matrix4x4 &rhs, double tolerance)
+    {
+        for (usize_t row = 0; row < 4; row++)
+        {
+            for (usize_t col = 0; col < 4; col++)
+            {
+                if (std::abs(double(lhs.data[row][col]) - rhs.data[row][col]) > tolerance * std::max(1.0, std::abs(rhs.data[row][col])))
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    // Random forest: the first nodes are roots, every other node has a random earlier parent.
+    void MakeTransformHierarchy(TransformHierarchy &hierarchy, Array<TransformHandle> &nodes, Array<uint32_t> &parents, usize_t count, uint64_t seed)
+    {
+        constexpr usize_t ROOTS = 1000;
+
+        std::mt19937_64 rng{seed};
+        std::uniform_real_distribution<float> position{-10.0f, 10.0f};
+        std::uniform_real_distribution<float> angle{-3.0f, 3.0f};
+        std::uniform_real_distribution<float> scale{0.5f, 1.5f};
+
+        nodes.reserve(count);
+        parents.reserve(count);
+        for (usize_t i = 0; i < count; i++)
+        {
+            const auto parent = i < ROOTS ? UMax : uint32_t(rng() % i);
+            nodes.push_back(hierarchy.Create(parent == UMax ? TransformHandle{} : nodes[parent]));
+            parents.push_back(parent);
+            hierarchy.SetLocal(nodes.back(), Float3{position(rng), position(rng), position(rng)},
+                               Quatf{Math::Normalize(Float3{position(rng), position(rng), position(rng)}), angle(rng)}, Float3{scale(rng)});
+        }
+    }
+
+    void TransformHierarchy_Test(usize_t count)
+    {
+        TransformHierarchy hierarchy;
+
+        // A translated root, a rotated child and a translated grandchild.
+        const auto root = hierarchy.Create();
+        const auto child = hierarchy.Create(root);
+        const auto grandchild = hierarchy.Create(child);
+        hierarchy.SetPosition(root, Float3{10.0f, 0.0f, 0.0f});
+        hierarchy.SetLocal(child, Float3{0.0f, 5.0f, 0.0f}, Quatf{Float3{0.0f, 0.0f, 1.0f}, float(Math::Radians(90.0))}, Float3{1.0f});
+        hierarchy.SetPosition(grandchild, Float3{1.0f, 0.0f, 0.0f});
+        hierarchy.Update();
+
+        const auto translation = [&](TransformHandle node)
+        {
+            const auto &world = hierarchy.GetWorld(node);
+            return Vector3{world.data[0][3], world.data[1][3], world.data[2][3]};
+        };
+        TEST(hierarchy.GetLevelCount() == 3, "Wrong level count");
+        TEST(Math::Length(translation(grandchild) - Vector3{10.0, 6.0, 0.0}) < 1e-5, "Wrong world transform");
+
+        // Only the changed subtree is recomputed.
+        hierarchy.SetPosition(child, Float3{0.0f, 4.0f, 0.0f});
+        hierarchy.Update();
+        TEST(!hierarchy.IsWorldChanged(root) && hierarchy.IsWorldChanged(child) && hierarchy.IsWorldChanged(grandchild), "Wrong dirty propagation");
+        TEST(Math::Length(translation(grandchild) - Vector3{10.0, 5.0, 0.0}) < 1e-5, "Wrong world transform");
+
+        hierarchy.Update();
+        TEST(!hierarchy.IsWorldChanged(child) && !hierarchy.IsWorldChanged(grandchild), "Nothing changed");
+
+        // Reparenting keeps the local transform, destroying takes the subtree.
+        hierarchy.SetParent(grandchild, root);
+        const auto leaf = hierarchy.Create(child);
+        hierarchy.Destroy(child);
+        hierarchy.Update();
+        TEST(Math::Length(translation(grandchild) - Vector3{11.0, 0.0, 0.0}) < 1e-5, "Wrong world transform after reparenting");
+        TEST(!hierarchy.Contains(child) && !hierarchy.Contains(leaf) && hierarchy.Contains(grandchild) && hierarchy.size() == 2, "Wrong destroyed subtree");
+        TEST(hierarchy.GetLevelCount() == 2, "Wrong level count");
+
+        // Random forest against matrices composed in double precision.
+        TransformHierarchy forest;
+        Array<TransformHandle> nodes;
+        Array<uint32_t> parents;
+        MakeTransformHierarchy(forest, nodes, parents, count, 1);
+        forest.Update();
+
+        Array<Matrix4x4> reference(count);
+        for (usize_t i = 0; i < count; i++)
+        {
+            const auto local = MakeLocalMatrix(forest.GetPosition(nodes[i]), forest.GetRotation(nodes[i]), forest.GetScale(nodes[i]));
+            reference[i] = parents[i] == UMax ? local : reference[parents[i]] * local;
+            TEST(IsNear(forest.GetWorld(nodes[i]), reference[i], 1e-3), "World transform differs from the reference");
+        }
+    }
+
+    void TransformHierarchy_Benchmark(usize_t count)
+    {
+        constexpr usize_t FRAMES = 10;
+
+        TransformHierarchy hierarchy;
+        Array<TransformHandle> nodes;
+        Array<uint32_t> parents;
+        MakeTransformHierarchy(hierarchy, nodes, parents, count, count);
+
+        const auto full_begins = Clock::now();
+        hierarchy.Update();
+        const auto full_ends = Clock::now();
+
+        // 5% of the nodes move every frame.
+        std::mt19937_64 rng{count};
+        std::uniform_real_distribution<float> position{-10.0f, 10.0f};
+        Clock::duration update_time{};
+        for (usize_t frame = 0; frame < FRAMES; frame++)
+        {
+            for (usize_t i = 0; i < count / 20; i++)
+            {
+                hierarchy.SetPosition(nodes[rng() % count], Float3{position(rng), position(rng), position(rng)});
+            }
+
+            const auto update_begins = Clock::now();
+            hierarchy.Update();
+            update_time += Clock::now() - update_begins;
+        }
+
+        LOG_INFO("Transform hierarchy {} nodes:\t{} levels, first update with reordering {}, 5% dirty update {}", count, hierarchy.GetLevelCount(),
+                 (full_ends - full_begins).count(), update_time.count() / int64_t(FRAMES));
+    }
+}
+
+extern void UnitTest_Algorithms()
+{
+    RadixSort_Test(100'000);
+
+    for (const auto count : {10'000, 100'000, 1'000'000})
+    {
+        RadixSort_Benchmark(count);
+    }
+
+    IncrementalSort_Test(10'000);
+    InstancePacker_Test();
+
+    FrustumCull_Test(100'000);
+
+    for (const auto count : {100'000, 1'000'000})
+    {
+        FrustumCull_Benchmark(count);
+    }
+
+    Bvh_Test(10'000);
+
+    for (const auto count : {100'000, 1'000'000})
+    {
+        Bvh_Benchmark(count);
+    }
+
+    OcclusionBuffer_Test();
+
+    for (const auto count : {100'000, 1'000'000})
+    {
+        OcclusionBuffer_Benchmark(count);
+    }
+
+    MeshletCull_Test(100'000);
+
+    for (const auto count : {100'000, 1'000'000})
+    {
+        MeshletCull_Benchmark(count);
+    }
+
+    TransformHierarchy_Test(10'000);
+    TransformHierarchy_Benchmark(1'000'000);
+
+    TEST_PASSED();
+}
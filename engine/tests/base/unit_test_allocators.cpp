@@ -15,7 +15,7 @@ namespace
         for (usize_t i = 0; i < count; i++)
         {
             auto ptr = allocator.Alloc(size);
-            allocator.Free(nullptr);
+            allocator.Reset();
         }
         const auto ends = Clock::now();
 
@@ -23,6 +23,122 @@ namespace
 
         LOG_INFO("Linear avg time:\t\t{}", duration.count() / count);
     }
+
+    void FrameRingAllocator_Test(usize_t count)
+    {
+        constexpr uint32_t frame_count = 3;
+        constexpr usize_t frame_size = 4096;
+        MallocMemoryArena arena{frame_size * frame_count};
+        FrameRingAllocator allocator{arena, frame_count};
+
+        Array<byte_t *> frame_ptrs(frame_count, nullptr);
+        for (uint64_t frame = 0; frame < 2 * frame_count; frame++)
+        {
+            if (frame >= frame_count)
+            {
+                TEST(!allocator.IsFrameRetired(frame - frame_count), "Frame must stay alive until retired");
+                allocator.RetireFrames(frame - frame_count);
+            }
+            allocator.BeginFrame(frame);
+
+            auto ptr = static_cast<byte_t *>(allocator.Alloc(64, 16));
+            TEST(AlignUp(ptr, 16) == ptr, "Wrong alignment");
+
+            const auto slot = frame % frame_count;
+            if (frame >= frame_count)
+            {
+                TEST(frame_ptrs[slot] == ptr, "Retired frame memory must be reused");
+            }
+            frame_ptrs[slot] = ptr;
+        }
+
+        auto spilled = allocator.Alloc(2 * frame_size);
+        TEST(spilled != nullptr, "Overflow allocation failed");
+        allocator.RetireFrames(2 * frame_count);
+        allocator.BeginFrame(2 * frame_count);
+        allocator.RetireFrames(2 * frame_count);
+        TEST(allocator.GetStats().overflow_frames == 1, "Overflow is not reported");
+        TEST(allocator.GetStats().peak_frame_overflow >= 2 * frame_size, "Overflow peak is not reported");
+
+        const auto begins = Clock::now();
+        for (usize_t i = 0; i < count; i++)
+        {
+            const auto frame = 2 * frame_count + 1 + i;
+            allocator.RetireFrames(frame - frame_count);
+            allocator.BeginFrame(frame);
+            auto ptr = allocator.Alloc(frame_size / 2);
+        }
+        const auto ends = Clock::now();
+
+        const auto duration = ends - begins;
+
+        LOG_INFO("Frame ring avg time:\t\t{}", duration.count() / count);
+        LOG_INFO("Frame ring peak usage:\t\t{} of {}", allocator.GetStats().peak_frame_used, allocator.GetStats().frame_capacity);
+    }
+
+    void StackAllocator_Test(usize_t count)
+    {
+        MallocMemoryArena arena{4096};
+        StackAllocator allocator{arena};
+
+        auto a = allocator.Alloc(100, 16);
+        TEST(AlignUp(a, 16) == a, "Wrong alignment");
+        const auto used = allocator.GetUsedSize();
+        {
+            auto scope = allocator.Scope();
+            auto b = allocator.Alloc(200);
+            auto c = allocator.Alloc(300, 64);
+            TEST(AlignUp(c, 64) == c, "Wrong alignment");
+            allocator.Free(c);
+            allocator.Free(b);
+            TEST(allocator.GetUsedSize() == used, "LIFO free must restore the previous offset");
+            auto d = allocator.Alloc(1000);
+        }
+        TEST(allocator.GetUsedSize() == used, "Scope must rewind the allocator");
+        allocator.Free(a);
+        TEST(allocator.GetUsedSize() == 0, "Allocator must be empty");
+
+        const auto begins = Clock::now();
+        for (usize_t i = 0; i < count; i++)
+        {
+            auto scope = allocator.Scope();
+            auto ptr0 = allocator.Alloc(64);
+            auto ptr1 = allocator.Alloc(128, 16);
+            allocator.Free(ptr1);
+        }
+        const auto ends = Clock::now();
+
+        const auto duration = ends - begins;
+
+        LOG_INFO("Stack avg time:\t\t{}", duration.count() / count);
+    }
+
+    void MemoryResource_Test()
+    {
+        MallocMemoryArena arena{4096};
+        LinearAllocator allocator{arena};
+        MonotonicMemoryResource resource{allocator};
+
+        auto begin = static_cast<byte_t *>(arena.Begin());
+        auto end = static_cast<byte_t *>(arena.End());
+
+        PmrArray<uint32_t> array{&resource};
+        for (uint32_t i = 0; i < 100; i++)
+        {
+            array.push_back(i);
+        }
+        const auto array_ptr = reinterpret_cast<byte_t *>(array.data());
+        TEST(array_ptr >= begin && array_ptr < end, "Array is not allocated in the arena");
+
+        PmrMap<uint32_t, PmrArray<uint32_t>> map{&resource};
+        map[1].push_back(1);
+        const auto item_ptr = reinterpret_cast<byte_t *>(map[1].data());
+        TEST(item_ptr >= begin && item_ptr < end, "Nested container does not use the map resource");
+
+        PmrString str{"a string long enough to skip the small string buffer", &resource};
+        const auto str_ptr = reinterpret_cast<const byte_t *>(str.data());
+        TEST(str_ptr >= begin && str_ptr < end, "String is not allocated in the arena");
+    }
 }
 
 extern void UnitTest_Allocators()
@@ -31,6 +147,9 @@ extern void UnitTest_Allocators()
     constexpr auto SIZE = 1'000'000;
 
     LinearAllocator_Test(COUNT);
+    FrameRingAllocator_Test(COUNT);
+    StackAllocator_Test(COUNT);
+    MemoryResource_Test();
 
     TEST_PASSED();
 }
\ No newline at end of file
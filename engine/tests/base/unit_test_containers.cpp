@@ -0,0 +1,728 @@
+#include "unit_tests_common.h"
+
+namespace
+{
+    using namespace Be;
+
+    void VirtualMemoryContainer_Test(usize_t count)
+    {
+        VirtualMemoryContainer<uint64_t> container{count};
+        TEST(container.empty() && container.GetCommittedSize() == 0, "Memory must not be committed up front");
+
+        container.push_back(0);
+        const auto first = &container[0];
+
+        const auto begins = Clock::now();
+        for (usize_t i = 1; i < count / 2; i++)
+        {
+            container.push_back(i);
+        }
+        const auto ends = Clock::now();
+
+        Array<uint64_t> tail;
+        for (usize_t i = container.size(); i < count; i++)
+        {
+            tail.push_back(i);
+        }
+        container.append(tail);
+
+        TEST(container.size() == count, "Wrong size");
+        TEST(first == &container[0], "Elements must not be relocated");
+        for (usize_t i = 0; i < count; i++)
+        {
+            TEST(container[i] == i, "Wrong value");
+        }
+
+        const auto committed = container.GetCommittedSize();
+        container.resize(count / 4);
+        container.shrink_to_fit();
+        TEST(container.GetCommittedSize() < committed, "Pages must be decommitted");
+        TEST(container.back() == count / 4 - 1, "Wrong value after shrink");
+
+        container.push_back(42);
+        TEST(container.back() == 42, "Wrong value after regrow");
+
+        const auto duration = ends - begins;
+
+        LOG_INFO("Virtual container push_back avg time:\t{}", duration.count() / (count / 2));
+    }
+
+    void FlatHashMap_Test(usize_t count)
+    {
+        FlatHashMap<uint64_t, uint64_t> map;
+        Map<uint64_t, uint64_t> reference;
+
+        std::mt19937_64 rng{42};
+        for (usize_t i = 0; i < count; i++)
+        {
+            const auto key = rng() % (count / 2);
+            switch (rng() % 4)
+            {
+            case 0:
+                TEST(map.erase(key) == reference.erase(key), "Wrong erase result");
+                break;
+            case 1:
+                map.insert_or_assign(key, i);
+                reference.insert_or_assign(key, i);
+                break;
+            default:
+                map[key] += i;
+                reference[key] += i;
+                break;
+            }
+        }
+
+        TEST(map.size() == reference.size(), "Wrong size");
+        for (const auto &[key, value] : reference)
+        {
+            const auto it = map.find(key);
+            TEST(it != map.end() && it->second == value, "Wrong value");
+        }
+
+        usize_t visited{0};
+        for (auto it = map.begin(); it != map.end();)
+        {
+            TEST(reference.contains(it->first), "Unknown key");
+            it = (it->first & 1) ? map.erase(it) : ++it;
+            visited++;
+        }
+        TEST(visited == reference.size(), "Iteration must visit every element once");
+        for (const auto &[key, value] : map)
+        {
+            TEST((key & 1) == 0, "Erased while iterating");
+        }
+
+        auto copy = map;
+        auto moved = std::move(map);
+        TEST(map.empty() && copy.size() == moved.size(), "Wrong copy or move");
+
+        moved.clear();
+        TEST(moved.empty() && moved.capacity() != 0 && !moved.contains(0), "Clear must keep storage");
+
+        FlatHashSet<String, StringHash, std::equal_to<>> names{"albedo", "normal", "roughness"};
+        TEST(names.contains(StringView{"normal"}) && !names.contains(StringView{"metallic"}), "Heterogeneous lookup failed");
+
+        MallocMemoryArena arena{64 << 10};
+        LinearAllocator allocator{arena};
+        MonotonicMemoryResource resource{allocator};
+        PmrFlatHashMap<uint32_t, PmrArray<uint32_t>> groups{&resource};
+        groups[7].push_back(1);
+        TEST(groups.at(7).get_allocator().resource() == &resource, "Allocator must propagate to values");
+    }
+
+    struct Resource
+    {
+        uint64_t payload[8]{};
+    };
+
+    struct RefCountedResource final : RefCounter
+    {
+        uint64_t payload[8]{};
+    };
+
+    void SlotMap_Test(usize_t count)
+    {
+        SlotMap<Resource> map;
+
+        Array<SlotHandle<Resource>> handles;
+        for (usize_t i = 0; i < count; i++)
+        {
+            handles.push_back(map.Emplace(Resource{{i}}));
+        }
+
+        for (usize_t i = 0; i < count; i += 2)
+        {
+            TEST(map.Erase(handles[i]), "Erase failed");
+        }
+        TEST(map.size() == count / 2, "Wrong size");
+        TEST(!map.Erase(handles[0]) && map.Get(handles[0]) == nullptr, "Stale handle must be rejected");
+
+        const auto reused = map.Emplace(Resource{{42}});
+        TEST(reused.index == handles[count - 2].index && reused != handles[count - 2], "Slot must be reused with a new generation");
+        TEST(map.Get(handles[count - 2]) == nullptr && map[reused].payload[0] == 42, "Stale handle resolved to a new value");
+
+        for (usize_t i = 1; i < count; i += 2)
+        {
+            TEST(map[handles[i]].payload[0] == i, "Wrong value after erase");
+        }
+
+        usize_t visited{0};
+        map.ForEach([&](SlotHandle<Resource> handle, Resource &value)
+                    {
+                        TEST(&map[handle] == &value, "Wrong dense handle");
+                        visited++; });
+        TEST(visited == map.size(), "Bulk iteration must visit every value");
+
+        map.clear();
+        TEST(map.empty() && map.Get(reused) == nullptr, "Clear must invalidate handles");
+
+        SlotMap<Resource, true> shared;
+        const auto handle = shared.Emplace();
+        shared.AddRef(handle);
+        TEST(!shared.Release(handle) && shared.Release(handle) && !shared.Contains(handle), "Last release must erase the value");
+    }
+
+    // Copy and dereference of a handle per access, as render code does with resource handles.
+    void SlotMap_Benchmark(usize_t count)
+    {
+        SlotMap<Resource> map{count};
+        Array<SlotHandle<Resource>> handles;
+        Array<RefCountPtr<RefCountedResource>> pointers;
+        for (usize_t i = 0; i < count; i++)
+        {
+            handles.push_back(map.Emplace());
+            pointers.push_back(MakeRefCounter<RefCountedResource>());
+        }
+
+        const auto slot_begins = Clock::now();
+        for (usize_t i = 0; i < count; i++)
+        {
+            const auto handle = handles[(i * 7919) % count];
+            map[handle].payload[0]++;
+        }
+        const auto slot_ends = Clock::now();
+
+        const auto ptr_begins = Clock::now();
+        for (usize_t i = 0; i < count; i++)
+        {
+            const auto ptr = pointers[(i * 7919) % count];
+            ptr->payload[0]++;
+        }
+        const auto ptr_ends = Clock::now();
+
+        const auto bulk_begins = Clock::now();
+        for (auto &value : map)
+        {
+            value.payload[1]++;
+        }
+        const auto bulk_ends = Clock::now();
+
+        LOG_INFO("Handle access avg time:\tslot map {}, ref count ptr {}, bulk {}",
+                 (slot_ends - slot_begins).count() / count, (ptr_ends - ptr_begins).count() / count, (bulk_ends - bulk_begins).count() / count);
+    }
+
+    void SoAArray_Test(usize_t count)
+    {
+        SoAArray<uint32_t, String, float> array;
+        for (usize_t i = 0; i < count; i++)
+        {
+            array.push_back(uint32_t(i), std::to_string(i), float(i));
+        }
+        TEST(array.size() == count, "Wrong size");
+
+        const auto ids = array.GetColumn<0>();
+        const auto values = array.GetColumn<2>();
+        TEST(IsAligned(ids.data(), BE_CACHE_LINE) && IsAligned(values.data(), BE_CACHE_LINE), "Columns must be aligned");
+
+        array.erase_swap(0);
+        TEST(array.size() == count - 1 && array.Get<0>(0) == count - 1 && array.Get<1>(0) == std::to_string(count - 1), "Wrong erase");
+
+        for (auto [id, value] : array.Zip<0, 2>())
+        {
+            TEST(float(id) == value, "Zipped columns out of sync");
+            value = -1.0f;
+        }
+        for (const auto &[id, name, value] : std::as_const(array))
+        {
+            TEST(value == -1.0f && name == std::to_string(id), "Wrong zipped values");
+        }
+
+        auto moved = std::move(array);
+        moved.resize(2);
+        TEST(array.empty() && moved.size() == 2 && moved.Get<1>(1) == "1", "Wrong move or resize");
+    }
+
+    // A culling style kernel that reads only the bounds of fat instance records.
+    void SoAArray_Benchmark(usize_t count)
+    {
+        struct Instance
+        {
+            uint32_t mesh;
+            Matrix4x4 transform;
+            BBox bounds;
+        };
+
+        Array<Instance> aos(count);
+        SoAArray<uint32_t, Matrix4x4, BBox> soa{count};
+        for (usize_t i = 0; i < count; i++)
+        {
+            aos[i].bounds.min.x = double(i & 1);
+            soa.push_back(uint32_t(i), Matrix4x4{}, aos[i].bounds);
+        }
+
+        usize_t aos_visible{0};
+        const auto aos_begins = Clock::now();
+        for (const auto &instance : aos)
+        {
+            aos_visible += instance.bounds.min.x > 0.0 ? 1 : 0;
+        }
+        const auto aos_ends = Clock::now();
+
+        usize_t soa_visible{0};
+        const auto soa_begins = Clock::now();
+        for (const auto &bounds : soa.GetColumn<2>())
+        {
+            soa_visible += bounds.min.x > 0.0 ? 1 : 0;
+        }
+        const auto soa_ends = Clock::now();
+
+        TEST(aos_visible == soa_visible, "Wrong result");
+        LOG_INFO("Bounds scan avg time:\taos {}, soa {}", (aos_ends - aos_begins).count() / count, (soa_ends - soa_begins).count() / count);
+    }
+
+    void RingBuffer_Test(usize_t count)
+    {
+        SpscRingBuffer<String, 8> spsc;
+        for (usize_t i = 0; i < 8; i++)
+        {
+            TEST(spsc.TryPush(std::to_string(i)), "Push failed");
+        }
+        auto extra = String{"extra"};
+        TEST(!spsc.TryPush(std::move(extra)) && extra == "extra", "Push to a full ring");
+
+        FixedArray<String, 5> batch;
+        TEST(spsc.PopBatch(batch) == 5 && batch[4] == "4", "Wrong batch pop");
+        TEST(spsc.PushBatch(batch) == 5 && spsc.Size() == 8, "Wrong batch push");
+
+        String value;
+        TEST(spsc.TryPop(value) && value == "5", "Wrong order");
+
+        // Producers tag values with their index, consumers check per producer order and the total.
+        constexpr usize_t THREADS = 4;
+        MpmcRingBuffer<uint64_t, 1024> mpmc;
+        Atomic<uint64_t> sum{0};
+        Atomic<usize_t> popped{0};
+        Atomic<bool> ordered{true};
+
+        Array<std::thread> threads;
+        for (usize_t t = 0; t < THREADS; t++)
+        {
+            threads.emplace_back([&, t]
+                                 {
+                                     for (uint64_t i = 0; i < count; i++)
+                                     {
+                                         while (!mpmc.TryPush((i << 8) | t))
+                                         {
+                                             std::this_thread::yield();
+                                         }
+                                     } });
+            threads.emplace_back([&]
+                                 {
+                                     FixedArray<uint64_t, THREADS> last{};
+                                     uint64_t value;
+                                     while (popped.load() < count * THREADS)
+                                     {
+                                         if (!mpmc.TryPop(value))
+                                         {
+                                             std::this_thread::yield();
+                                             continue;
+                                         }
+                                         const auto producer = value & 0xFF;
+                                         if (value < last[producer])
+                                         {
+                                             ordered = false;
+                                         }
+                                         last[producer] = value;
+                                         sum += value >> 8;
+                                         popped++;
+                                     } });
+        }
+        for (auto &thread : threads)
+        {
+            thread.join();
+        }
+
+        TEST(ordered && popped == count * THREADS && sum == THREADS * count * (count - 1) / 2 && mpmc.Empty(), "Wrong concurrent push/pop");
+    }
+
+    // Producer/consumer hand-off of small items, the pattern of completion and event queues.
+    template <typename Q, bool BATCH>
+    [[nodiscard]] int64_t RingBuffer_Benchmark(Q &queue, usize_t count)
+    {
+        const auto begins = Clock::now();
+        std::thread producer{[&]
+                             {
+                                 FixedArray<uint64_t, 32> batch;
+                                 for (uint64_t i = 0; i < count;)
+                                 {
+                                     usize_t pushed{0};
+                                     if constexpr (BATCH)
+                                     {
+                                         const auto size = std::min<usize_t>(batch.size(), count - i);
+                                         for (usize_t j = 0; j < size; j++)
+                                         {
+                                             batch[j] = i + j;
+                                         }
+                                         pushed = queue.PushBatch({batch.data(), size});
+                                     }
+                                     else
+                                     {
+                                         pushed = queue.TryPush(i) ? 1 : 0;
+                                     }
+
+                                     if (pushed == 0)
+                                     {
+                                         std::this_thread::yield();
+                                     }
+                                     i += pushed;
+                                 } }};
+
+        uint64_t sum{0};
+        FixedArray<uint64_t, 32> batch;
+        for (usize_t i = 0; i < count;)
+        {
+            usize_t popped{0};
+            if constexpr (BATCH)
+            {
+                popped = queue.PopBatch(batch);
+            }
+            else
+            {
+                popped = queue.TryPop(batch[0]) ? 1 : 0;
+            }
+
+            if (popped == 0)
+            {
+                std::this_thread::yield();
+            }
+            for (usize_t j = 0; j < popped; j++)
+            {
+                sum += batch[j];
+            }
+            i += popped;
+        }
+        producer.join();
+        const auto ends = Clock::now();
+
+        TEST(sum == count * (count - 1) / 2, "Wrong hand-off");
+        return (ends - begins).count() / int64_t(count);
+    }
+
+    void RingBuffer_Benchmark(usize_t count)
+    {
+        // Mutex guarded queue, the baseline the rings replace.
+        struct LockedQueue
+        {
+            Mutex mutex;
+            Queue<uint64_t> values;
+
+            bool TryPush(uint64_t value)
+            {
+                EXCLUSIVE_LOCK(mutex);
+                values.push_back(value);
+                return true;
+            }
+
+            bool TryPop(uint64_t &value)
+            {
+                EXCLUSIVE_LOCK(mutex);
+                if (values.empty())
+                {
+                    return false;
+                }
+                value = values.front();
+                values.pop_front();
+                return true;
+            }
+        };
+
+        auto spsc = MakeUnique<SpscRingBuffer<uint64_t, 1024>>();
+        auto mpmc = MakeUnique<MpmcRingBuffer<uint64_t, 1024>>();
+        LockedQueue locked;
+
+        const auto spsc_time = RingBuffer_Benchmark<SpscRingBuffer<uint64_t, 1024>, false>(*spsc, count);
+        const auto spsc_batch_time = RingBuffer_Benchmark<SpscRingBuffer<uint64_t, 1024>, true>(*spsc, count);
+        const auto mpmc_time = RingBuffer_Benchmark<MpmcRingBuffer<uint64_t, 1024>, false>(*mpmc, count);
+        const auto locked_time = RingBuffer_Benchmark<LockedQueue, false>(locked, count);
+        LOG_INFO("Queue hand-off avg time:	spsc {}, spsc batch {}, mpmc {}, mutex {}", spsc_time, spsc_batch_time, mpmc_time, locked_time);
+    }
+
+    void SmallArray_Test(usize_t count)
+    {
+        SmallArray<String, 4> array;
+        for (usize_t i = 0; i < 4; i++)
+        {
+            array.push_back(std::to_string(i));
+        }
+        TEST(array.IsInline() && array.size() == 4, "Inline capacity is not used");
+
+        array.emplace_back("4");
+        TEST(!array.IsInline() && array.size() == 5 && array[0] == "0" && array.back() == "4", "Wrong spill");
+
+        array.erase(array.begin() + 1);
+        TEST(array.size() == 4 && array[1] == "2", "Wrong erase");
+
+        auto copy = array;
+        auto moved = std::move(array);
+        TEST(array.empty() && copy.size() == 4 && moved.size() == 4 && moved[3] == "4", "Wrong copy or move");
+
+        SmallArray<String, 4> small{"a", "b"};
+        moved = std::move(small);
+        TEST(moved.size() == 2 && moved[1] == "b" && small.empty(), "Wrong move of inline storage");
+
+        // Spills go to the given resource.
+        byte_t buffer[4096];
+        std::pmr::monotonic_buffer_resource resource{buffer, sizeof(buffer), std::pmr::null_memory_resource()};
+        PmrSmallArray<uint32_t, 8> pmr{&resource};
+        pmr.resize(64, 7u);
+        TEST(!pmr.IsInline() && pmr.data() >= reinterpret_cast<uint32_t *>(buffer) &&
+                 pmr.data() < reinterpret_cast<uint32_t *>(buffer + sizeof(buffer)),
+             "Spill bypassed the allocator");
+
+        SmallArray<uint64_t, 16> values;
+        for (usize_t i = 0; i < count; i++)
+        {
+            values.push_back(i);
+        }
+        TEST(values.size() == count && std::accumulate(values.begin(), values.end(), uint64_t{0}) == count * (count - 1) / 2, "Wrong values");
+    }
+
+    // Short lived arrays of a few elements, as built per draw or per submit.
+    void SmallArray_Benchmark(usize_t count)
+    {
+        const auto build = [count]<typename A>()
+        {
+            uint64_t sum{0};
+            const auto begins = Clock::now();
+            for (usize_t i = 0; i < count; i++)
+            {
+                A array;
+                array.reserve(4);
+                for (uint64_t j = 0; j < 4; j++)
+                {
+                    array.push_back(i + j);
+                }
+                sum += array.back();
+            }
+            const auto ends = Clock::now();
+            TEST(sum != 0, "Wrong sum");
+            return (ends - begins).count() / int64_t(count);
+        };
+
+        const auto small_time = build.template operator()<SmallArray<uint64_t, 8>>();
+        const auto array_time = build.template operator()<Array<uint64_t>>();
+        LOG_INFO("Transient array avg time:	small {}, array {}", small_time, array_time);
+    }
+
+    enum class ETestFormat : uint32_t
+    {
+        eUndefined = 0,
+        eR8Unorm = 9,
+        eR16Uint = 74,
+        eR32Uint = 98,
+        eD16Unorm = 124,
+        eD32Sfloat = 126,
+        eS8Uint = 127,
+        eD24UnormS8Uint = 129,
+        eD32SfloatS8Uint = 130,
+        eG8B8G8R8Unorm = 1000156000,
+        eA4R4G4B4Unorm = 1000340000,
+    };
+
+    constexpr auto TEST_FORMAT_SIZES = MakeStaticMap<ETestFormat, uint32_t>({
+                                                                               {ETestFormat::eR8Unorm, 1},
+                                                                               {ETestFormat::eR16Uint, 2},
+                                                                               {ETestFormat::eR32Uint, 4},
+                                                                               {ETestFormat::eD16Unorm, 2},
+                                                                               {ETestFormat::eD32Sfloat, 4},
+                                                                               {ETestFormat::eS8Uint, 1},
+                                                                               {ETestFormat::eD24UnormS8Uint, 4},
+                                                                               {ETestFormat::eD32SfloatS8Uint, 8},
+                                                                               {ETestFormat::eG8B8G8R8Unorm, 4},
+                                                                               {ETestFormat::eA4R4G4B4Unorm, 2},
+                                                                           },
+                                                                           UINT32_MAX);
+
+    [[nodiscard]] constexpr FixedArray<Pair<uint32_t, uint32_t>, 1000> MakeStaticMapItems()
+    {
+        FixedArray<Pair<uint32_t, uint32_t>, 1000> items{};
+        for (uint32_t i = 0; i < items.size(); i++)
+        {
+            items[i] = {i * 2654435761u, i};
+        }
+        return items;
+    }
+
+    void StaticMap_Test()
+    {
+        STATIC_ASSERT(TEST_FORMAT_SIZES[ETestFormat::eD32SfloatS8Uint] == 8 && TEST_FORMAT_SIZES[ETestFormat::eUndefined] == UINT32_MAX);
+        STATIC_ASSERT(TEST_FORMAT_SIZES.contains(ETestFormat::eA4R4G4B4Unorm) && !TEST_FORMAT_SIZES.contains(ETestFormat::eUndefined));
+
+        TEST(TEST_FORMAT_SIZES.size() == 10 && *TEST_FORMAT_SIZES.find(ETestFormat::eG8B8G8R8Unorm) == 4, "Wrong lookup");
+        for (uint32_t value = 0; value < 200; value++)
+        {
+            const auto format = ETestFormat(value);
+            TEST(TEST_FORMAT_SIZES.contains(format) == (TEST_FORMAT_SIZES[format] != UINT32_MAX), "Wrong missing keys");
+        }
+
+        // Single key: the table still has a free slot.
+        constexpr auto single = MakeStaticMap<uint8_t, bool>({{uint8_t(7), true}});
+        STATIC_ASSERT(single[7] && !single[0] && single.find(0) == nullptr);
+
+        static constexpr auto large = MakeStaticMap(MakeStaticMapItems(), UINT32_MAX);
+        STATIC_ASSERT(large.TableSize == 1024);
+        for (uint32_t i = 0; i < 1000; i++)
+        {
+            TEST(large[i * 2654435761u] == i && !large.contains(i * 2654435761u + 1), "Wrong large map");
+        }
+    }
+
+    // Small static tables looked up by a runtime key: perfect hash against the
+    // switch and the maps it replaces.
+    void StaticMap_Benchmark(usize_t count)
+    {
+        const FixedArray<ETestFormat, 8> keys{ETestFormat::eR16Uint, ETestFormat::eD32Sfloat, ETestFormat::eUndefined, ETestFormat::eG8B8G8R8Unorm,
+                                              ETestFormat::eR32Uint, ETestFormat::eD24UnormS8Uint, ETestFormat::eR8Unorm, ETestFormat::eA4R4G4B4Unorm};
+
+        const auto lookup = [&](auto &&get)
+        {
+            uint64_t sum{0};
+            const auto begins = Clock::now();
+            for (usize_t i = 0; i < count; i++)
+            {
+                sum += get(keys[(i * 7) & 7]);
+            }
+            const auto ends = Clock::now();
+            TEST(sum != 0, "Wrong sum");
+            return (ends - begins).count() / int64_t(count);
+        };
+
+        Map<ETestFormat, uint32_t> node;
+        FlatHashMap<ETestFormat, uint32_t> flat;
+        for (const auto key : keys)
+        {
+            node[key] = TEST_FORMAT_SIZES[key];
+            flat[key] = TEST_FORMAT_SIZES[key];
+        }
+
+        const auto static_time = lookup([](ETestFormat f)
+                                        { return TEST_FORMAT_SIZES[f]; });
+        const auto switch_time = lookup([](ETestFormat f) -> uint32_t
+                                        {
+                                            switch (f)
+                                            {
+                                            case ETestFormat::eR8Unorm:
+                                            case ETestFormat::eS8Uint:
+                                                return 1;
+                                            case ETestFormat::eR16Uint:
+                                            case ETestFormat::eD16Unorm:
+                                            case ETestFormat::eA4R4G4B4Unorm:
+                                                return 2;
+                                            case ETestFormat::eR32Uint:
+                                            case ETestFormat::eD32Sfloat:
+                                            case ETestFormat::eD24UnormS8Uint:
+                                            case ETestFormat::eG8B8G8R8Unorm:
+                                                return 4;
+                                            case ETestFormat::eD32SfloatS8Uint:
+                                                return 8;
+                                            default:
+                                                return UINT32_MAX;
+                                            } });
+        const auto flat_time = lookup([&](ETestFormat f)
+                                      { return flat.find(f)->second; });
+        const auto node_time = lookup([&](ETestFormat f)
+                                      { return node.find(f)->second; });
+        LOG_INFO("Static table lookup avg time:\tstatic {}, switch {}, flat {}, std {}", static_time, switch_time, flat_time, node_time);
+    }
+
+    // Lookup patterns of the engine hot paths: a handful of render groups hit per
+    // renderable, a few dozen program bindings and per-subresource states.
+    template <typename M, typename K>
+    [[nodiscard]] int64_t MapLookup_Benchmark(const Array<K> &keys, usize_t lookups)
+    {
+        M map;
+        for (const auto &key : keys)
+        {
+            map[key] = 1;
+        }
+
+        uint64_t sum{0};
+        const auto begins = Clock::now();
+        for (usize_t i = 0; i < lookups; i++)
+        {
+            sum += map.find(keys[(i * 7) % keys.size()])->second;
+        }
+        const auto ends = Clock::now();
+        TEST(sum == lookups, "Wrong lookups");
+
+        return (ends - begins).count() / int64_t(lookups);
+    }
+
+    template <typename K>
+    void MapLookup_Test(const char *name, const Array<K> &keys, usize_t lookups)
+    {
+        const auto flat = MapLookup_Benchmark<FlatHashMap<K, uint64_t>>(keys, lookups);
+        const auto node = MapLookup_Benchmark<Map<K, uint64_t>>(keys, lookups);
+        LOG_INFO("{} lookup avg time:\tflat {}, std {}", name, flat, node);
+    }
+
+    void MapInsert_Test(usize_t count)
+    {
+        const auto insert = [count]<typename M>(M &map)
+        {
+            const auto begins = Clock::now();
+            for (usize_t i = 0; i < count; i++)
+            {
+                map[i * 2654435761u] = i;
+            }
+            return (Clock::now() - begins).count() / int64_t(count);
+        };
+
+        FlatHashMap<uint64_t, uint64_t> flat;
+        Map<uint64_t, uint64_t> node;
+        const auto flat_time = insert(flat);
+        const auto node_time = insert(node);
+        LOG_INFO("Map insert avg time:\tflat {}, std {}", flat_time, node_time);
+    }
+}
+
+extern void UnitTest_Containers()
+{
+    constexpr auto COUNT = 1'000'000;
+
+    VirtualMemoryContainer_Test(COUNT);
+    FlatHashMap_Test(COUNT);
+
+    Array<HashValue> render_groups;
+    for (const auto *name : {"opaque", "transparent", "shadow", "ui"})
+    {
+        render_groups.push_back(ConstHashOf(name));
+    }
+    MapLookup_Test("Render group", render_groups, COUNT);
+
+    Array<HashValue> bindings;
+    for (uint32_t i = 0; i < 32; i++)
+    {
+        bindings.push_back(HashValue{i * 0x9E3779B9u});
+    }
+    MapLookup_Test("Program binding", bindings, COUNT);
+
+    Array<Pair<uint32_t, uint32_t>> subresources;
+    for (uint32_t mip = 0; mip < 12; mip++)
+    {
+        for (uint32_t layer = 0; layer < 6; layer++)
+        {
+            subresources.emplace_back(mip, layer);
+        }
+    }
+    MapLookup_Test("Subresource state", subresources, COUNT);
+
+    MapInsert_Test(COUNT);
+
+    SlotMap_Test(COUNT);
+    SlotMap_Benchmark(COUNT);
+
+    SoAArray_Test(COUNT / 10);
+    SoAArray_Benchmark(COUNT);
+
+    SmallArray_Test(COUNT);
+    SmallArray_Benchmark(COUNT);
+
+    StaticMap_Test();
+    StaticMap_Benchmark(COUNT * 10);
+
+    RingBuffer_Test(COUNT / 10);
+    RingBuffer_Benchmark(COUNT);
+
+    TEST_PASSED();
+}
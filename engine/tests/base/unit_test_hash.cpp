@@ -0,0 +1,193 @@
+#include "unit_tests_common.h"
+
+namespace
+{
+    using namespace Be;
+
+    [[nodiscard]] Array<String> MakeAssetPaths(usize_t count)
+    {
+        Array<String> paths(count);
+        for (usize_t i = 0; i < count; i++)
+        {
+            paths[i] = std::format("assets/models/sponza/textures/{}_albedo.ktx2", i);
+        }
+        return paths;
+    }
+
+    void Hash_Test()
+    {
+        // Constant and runtime evaluation agree, NamedHandle relies on it.
+        constexpr auto const_hash = ConstHashOf("diffuse_texture");
+        const String runtime_name{"diffuse_texture"};
+        TEST(const_hash == ConstHashOf(runtime_name.c_str()), "Constant and runtime hashes differ");
+
+        // Fixed size buffers hash like their strings.
+        constexpr char buffer[32] = "albedo";
+        STATIC_ASSERT(ConstHashOf(buffer, sizeof(buffer), 1) == ConstHashOf("albedo", 6, 1));
+        STATIC_ASSERT(ConstHashOf("albedo", 6, 1) != ConstHashOf("albedo", 6, 2));
+
+        // Every length path of the hash: empty, 1-3, 4-16, 17-47 and 48+ bytes.
+        Set<uint64_t> lengths;
+        const String text(128, 'x');
+        for (usize_t len = 0; len <= text.size(); len++)
+        {
+            TEST(HashOf(text.data(), len) == ConstHashOf(text.data(), len, 0), "Constant and runtime hashes differ");
+            lengths.insert(uint64_t(HashOf(text.data(), len)));
+        }
+        TEST(lengths.size() == text.size() + 1, "Length is not part of the hash");
+
+        const auto a = HashOf(1), b = HashOf(2);
+        TEST((a + b) != (b + a) && (a + b + b) != a, "Combine must depend on order and repetition");
+    }
+
+    // Share of output bits flipped by flipping a single input bit, ideally one half.
+    template <typename F>
+    [[nodiscard]] double Avalanche(usize_t size, usize_t samples, F &&hash)
+    {
+        std::mt19937_64 rng{size};
+        Array<uint8_t> data(size);
+
+        uint64_t flipped{0}, total{0};
+        for (usize_t s = 0; s < samples; s++)
+        {
+            for (auto &byte : data)
+            {
+                byte = uint8_t(rng());
+            }
+
+            const auto base = hash(data);
+            for (usize_t bit = 0; bit < size * 8; bit++)
+            {
+                data[bit / 8] ^= uint8_t(1u << (bit % 8));
+                flipped += std::popcount(base ^ hash(data));
+                total += 64;
+                data[bit / 8] ^= uint8_t(1u << (bit % 8));
+            }
+        }
+        return double(flipped) / double(total);
+    }
+
+    // Chi-square of the bucket counts over its expected value for uniform buckets,
+    // close to 1 for a good distribution.
+    [[nodiscard]] double BucketChiSquare(const Array<uint64_t> &hashes, uint32_t shift)
+    {
+        constexpr usize_t BUCKETS = 1 << 12;
+
+        Array<usize_t> counts(BUCKETS);
+        for (const auto hash : hashes)
+        {
+            counts[(hash >> shift) & (BUCKETS - 1)]++;
+        }
+
+        const auto expected = double(hashes.size()) / BUCKETS;
+        double chi{0};
+        for (const auto count : counts)
+        {
+            chi += (double(count) - expected) * (double(count) - expected) / expected;
+        }
+        return chi / (BUCKETS - 1);
+    }
+
+    void HashDistribution_Test(usize_t count)
+    {
+        const auto paths = MakeAssetPaths(count);
+
+        Array<uint64_t> hashes;
+        hashes.reserve(count);
+        for (const auto &path : paths)
+        {
+            hashes.push_back(uint64_t(HashOf(path.data(), path.size())));
+        }
+
+        Set<uint64_t> unique{hashes.begin(), hashes.end()};
+        TEST(unique.size() == count, "Hash collisions on asset paths");
+
+        for (const uint32_t shift : {0u, 26u, 52u})
+        {
+            const auto chi = BucketChiSquare(hashes, shift);
+            TEST(chi > 0.9 && chi < 1.1, "Biased buckets");
+        }
+
+        for (const usize_t size : {3, 8, 16, 40, 96})
+        {
+            const auto ratio = Avalanche(size, 64, [](const Array<uint8_t> &data)
+                                         { return uint64_t(HashOf(data.data(), data.size())); });
+            TEST(ratio > 0.49 && ratio < 0.51, "Poor avalanche");
+        }
+
+        const auto combine_ratio = Avalanche(16, 256, [](const Array<uint8_t> &data)
+                                             {
+                                                 uint64_t lhs, rhs;
+                                                 std::memcpy(&lhs, data.data(), 8);
+                                                 std::memcpy(&rhs, data.data() + 8, 8);
+                                                 return HashCombine(lhs, rhs); });
+        TEST(combine_ratio > 0.49 && combine_ratio < 0.51, "Poor combine avalanche");
+
+        LOG_INFO("Hash distribution:\tbuckets chi2 {:.3f}, avalanche {:.4f}, combine avalanche {:.4f}",
+                 BucketChiSquare(hashes, 0), Avalanche(16, 64, [](const Array<uint8_t> &data)
+                                                       { return uint64_t(HashOf(data.data(), data.size())); }),
+                 combine_ratio);
+    }
+
+    template <typename F>
+    [[nodiscard]] double HashThroughput(const Array<String> &inputs, usize_t rounds, F &&hash)
+    {
+        usize_t bytes{0};
+        uint64_t sum{0};
+        const auto begins = Clock::now();
+        for (usize_t r = 0; r < rounds; r++)
+        {
+            for (const auto &input : inputs)
+            {
+                sum += hash(input);
+                bytes += input.size();
+            }
+        }
+        const auto ends = Clock::now();
+        TEST(sum != 0, "Wrong hashes");
+
+        return double(bytes) / double((ends - begins).count()); // GB/s
+    }
+
+    void Hash_Benchmark(const char *name, const Array<String> &inputs, usize_t rounds)
+    {
+        const auto wy = HashThroughput(inputs, rounds, [](const String &s)
+                                       { return uint64_t(HashOf(s.data(), s.size())); });
+        const auto std_hash = HashThroughput(inputs, rounds, [](const String &s)
+                                             { return uint64_t(std::hash<String>{}(s)); });
+        LOG_INFO("{} hash throughput GB/s:\tHashOf {:.2f}, std::hash {:.2f}", name, wy, std_hash);
+    }
+}
+
+extern void UnitTest_Hash()
+{
+    constexpr auto COUNT = 1'000'000;
+
+    Hash_Test();
+    HashDistribution_Test(COUNT);
+
+    Array<String> names;
+    for (const auto *name : {"albedo", "normal_map", "view_projection", "instance_buffer", "u_material_params"})
+    {
+        names.emplace_back(name);
+    }
+    Hash_Benchmark("Binding name", names, COUNT);
+
+    Hash_Benchmark("Asset path", MakeAssetPaths(1000), COUNT / 1000);
+
+    // SPIR-V words: mostly small opcodes and ids.
+    Array<String> blobs(8);
+    std::mt19937 rng{7};
+    for (auto &blob : blobs)
+    {
+        Array<uint32_t> words(16 * 1024);
+        for (auto &word : words)
+        {
+            word = rng() & 0x00FF'00FF;
+        }
+        blob.assign(reinterpret_cast<const char *>(words.data()), words.size() * sizeof(uint32_t));
+    }
+    Hash_Benchmark("SPIR-V blob", blobs, 100);
+
+    TEST_PASSED();
+}
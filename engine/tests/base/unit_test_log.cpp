@@ -0,0 +1,146 @@
+#include "unit_tests_common.h"
+
+namespace
+{
+    using namespace Be;
+
+    // Collects everything the sink writes between construction and Take.
+    class LogCapture final
+    {
+    public:
+        LogCapture()
+        {
+            Logger::Flush();
+            m_prev = std::cout.rdbuf(m_stream.rdbuf());
+        }
+
+        ~LogCapture()
+        {
+            Logger::Flush();
+            std::cout.rdbuf(m_prev);
+        }
+
+        [[nodiscard]] Array<String> Take()
+        {
+            Logger::Flush();
+
+            Array<String> lines;
+            String line;
+            while (std::getline(m_stream, line))
+            {
+                lines.push_back(line);
+            }
+            m_stream.clear();
+            m_stream.str({});
+            return lines;
+        }
+
+    private:
+        std::stringstream m_stream;
+        std::streambuf *m_prev;
+    };
+
+    void Logger_Test(usize_t count)
+    {
+        LogCapture capture;
+
+        {
+            String temporary{"loader"};
+            Logger::Log(Logger::ELevel::eWarn, "{} {} {}", temporary, 42, 'c');
+            temporary.assign("changed");
+        }
+        const auto level = Logger::GetLevel();
+        Logger::SetLevel(Logger::ELevel::eWarn);
+        LOG_INFO("filtered {}", 1);
+        Logger::SetLevel(level);
+
+        const String long_text(1000, 'x');
+        LOG_INFO("{}", long_text);
+
+        // Ranges reference memory of the caller, they are formatted right away.
+        const FixedArray<int, 3> values{1, 2, 3};
+        LOG_INFO("{} {}", values.size(), values[2]);
+
+        auto lines = capture.Take();
+        TEST(lines.size() == 3, "Wrong message count");
+        TEST(lines[0] == "WARN: loader 42 c", "Strings must be copied at the call");
+        TEST(lines[1] == "INFO: " + long_text && lines[2] == "INFO: 3 3", "Wrong message");
+
+        // Every thread keeps its order, whatever is not dropped gets written.
+        constexpr usize_t THREADS = 4;
+        const auto dropped = Logger::GetDroppedCount();
+        Array<std::thread> threads;
+        for (usize_t t = 0; t < THREADS; t++)
+        {
+            threads.emplace_back([t, count]
+                                 {
+                                     for (usize_t i = 0; i < count; i++)
+                                     {
+                                         LOG_INFO("thread {} message {}", t, i);
+                                     } });
+        }
+        for (auto &thread : threads)
+        {
+            thread.join();
+        }
+
+        lines = capture.Take();
+        FixedArray<int64_t, THREADS> last;
+        last.fill(-1);
+        usize_t messages{0};
+        for (const auto &line : lines)
+        {
+            usize_t t, i;
+            if (std::sscanf(line.c_str(), "INFO: thread %zu message %zu", &t, &i) != 2)
+            {
+                continue;
+            }
+            TEST(t < THREADS && int64_t(i) > last[t], "Thread order is not kept");
+            last[t] = int64_t(i);
+            messages++;
+        }
+        TEST(messages + (Logger::GetDroppedCount() - dropped) == THREADS * count, "Messages lost without being counted");
+    }
+
+    // Time spent by the logging thread, the sink runs in the background.
+    void Logger_Benchmark(usize_t count)
+    {
+        constexpr usize_t BURST = 256;
+
+        std::ostringstream null_stream;
+        const auto sync_begins = Clock::now();
+        for (usize_t i = 0; i < count; i++)
+        {
+            null_stream << std::format("INFO: {}\n", std::format("frame {} draw {} time {:.3f}", i, i % 1000, 0.5));
+        }
+        const auto sync_ends = Clock::now();
+
+        int64_t async_time{0};
+        {
+            LogCapture capture;
+            for (usize_t i = 0; i < count; i += BURST)
+            {
+                const auto begins = Clock::now();
+                for (usize_t j = i; j < i + BURST; j++)
+                {
+                    LOG_INFO("frame {} draw {} time {:.3f}", j, j % 1000, 0.5);
+                }
+                async_time += (Clock::now() - begins).count();
+                Logger::Flush();
+            }
+            TEST(capture.Take().size() >= count - Logger::GetDroppedCount(), "Wrong message count");
+        }
+
+        LOG_INFO("Log call avg time:\tsync {}, async {}", (sync_ends - sync_begins).count() / int64_t(count), async_time / int64_t(count));
+    }
+}
+
+extern void UnitTest_Logger()
+{
+    constexpr auto COUNT = 100'000;
+
+    Logger_Test(COUNT / 10);
+    Logger_Benchmark(COUNT);
+
+    TEST_PASSED();
+}
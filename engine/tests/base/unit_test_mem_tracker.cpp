@@ -0,0 +1,69 @@
+#include "unit_tests_common.h"
+
+namespace
+{
+    using namespace Be;
+
+    void MemoryTracker_Test()
+    {
+        constexpr usize_t size = 1 << 20;
+
+        const auto before = MemoryTracker::TakeSnapshot()[EMemoryTag::eScripting];
+
+        void *ptr{nullptr};
+        {
+            MEMORY_TAG_SCOPE(EMemoryTag::eScripting);
+            ptr = ::operator new(size);
+        }
+        TEST(MemoryTracker::GetThreadTag() == EMemoryTag::eUntagged, "Tag scope is not restored");
+
+        const auto allocated = MemoryTracker::TakeSnapshot()[EMemoryTag::eScripting];
+        TEST(allocated.current_bytes == before.current_bytes + int64_t(size), "Allocation is not tracked");
+        TEST(int64_t(allocated.peak_bytes) >= allocated.current_bytes, "Peak is not tracked");
+        TEST(allocated.alloc_count == before.alloc_count + 1, "Allocation count is not tracked");
+        TEST(allocated.size_histogram.back() == before.size_histogram.back() + 1, "Histogram is not tracked");
+
+        ::operator delete(ptr);
+
+        const auto freed = MemoryTracker::TakeSnapshot()[EMemoryTag::eScripting];
+        TEST(freed.current_bytes == before.current_bytes, "Free is not tracked");
+        TEST(freed.free_count == before.free_count + 1, "Free count is not tracked");
+
+        {
+            MallocMemoryArena arena{size, EMemoryTag::eRenderer};
+            LinearAllocator allocator{arena};
+            TEST(allocator.GetTag() == EMemoryTag::eRenderer, "Allocator must inherit the arena tag");
+
+            const auto renderer = MemoryTracker::TakeSnapshot()[EMemoryTag::eRenderer];
+            TEST(renderer.current_bytes >= int64_t(size), "Arena is not tracked");
+        }
+
+        constexpr usize_t count = 1'000'000;
+        Array<void *> ptrs(count / 1000);
+        const auto begins = Clock::now();
+        for (usize_t i = 0; i < count; i += ptrs.size())
+        {
+            for (auto &p : ptrs)
+            {
+                p = ::operator new(64);
+            }
+            for (auto p : ptrs)
+            {
+                ::operator delete(p);
+            }
+        }
+        const auto ends = Clock::now();
+
+        const auto duration = ends - begins;
+
+        LOG_INFO("Tracked new/delete avg time:\t{}", duration.count() / count);
+        MemoryTracker::LogSnapshot();
+    }
+}
+
+extern void UnitTest_MemoryTracker()
+{
+    MemoryTracker_Test();
+
+    TEST_PASSED();
+}
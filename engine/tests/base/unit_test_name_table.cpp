@@ -0,0 +1,108 @@
+#include "unit_tests_common.h"
+
+namespace
+{
+    using namespace Be;
+
+    struct TestId;
+    using TestName = NamedHandle<TestId, 64, false>;
+    using TestOptimizedName = NamedHandle<TestId, 64, true>;
+
+    void NameTable_Test(usize_t count)
+    {
+        STATIC_ASSERT(sizeof(TestName) == sizeof(HashValue) && sizeof(TestOptimizedName) == sizeof(HashValue));
+
+        const TestName name{"albedo_texture"};
+        TEST(name.GetName() == "albedo_texture", "Name is not recoverable");
+
+        // Built during constant evaluation: same hash, but nothing interned.
+        constexpr TestOptimizedName const_name{"normal_texture"};
+        TEST(const_name.GetName().empty() && const_name == TestName{"normal_texture"}, "Wrong constant handle");
+        TEST(const_name.GetName() == "normal_texture", "Optimized handles must find interned names");
+
+        const TestOptimizedName optimized = name;
+        TEST(optimized.Hash() == name.Hash() && TestName{optimized}.GetName() == "albedo_texture", "Wrong conversion");
+
+        const FixedString<64> fixed{"albedo_texture"};
+        TEST(TestName{fixed} == name && TestName{StringView{"albedo_texture"}} == name, "Constructors disagree");
+
+        const auto view = NameTable::Intern(name.Hash(), "albedo_texture");
+        TEST(view.data() == name.GetName().data(), "Names must be stored once");
+
+        Array<String> names(count);
+        for (usize_t i = 0; i < count; i++)
+        {
+            names[i] = std::format("material_{}/property_{}", i / 16, i % 16);
+        }
+
+        // Threads intern the same names concurrently and must get the same stored copies.
+        constexpr usize_t THREADS = 4;
+        Array<Array<const char *>> stored(THREADS, Array<const char *>(count));
+        Array<std::thread> threads;
+        for (usize_t t = 0; t < THREADS; t++)
+        {
+            threads.emplace_back([&, t]
+                                 {
+                                     for (usize_t i = 0; i < count; i++)
+                                     {
+                                         const TestName handle{names[i]};
+                                         stored[t][i] = handle.GetName().data();
+                                     } });
+        }
+        for (auto &thread : threads)
+        {
+            thread.join();
+        }
+
+        for (usize_t i = 0; i < count; i++)
+        {
+            TEST(stored[0][i] == stored[1][i] && stored[0][i] == stored[THREADS - 1][i] && TestName{names[i]}.GetName() == names[i], "Wrong interned name");
+        }
+        TEST(NameTable::Size() >= count, "Wrong table size");
+    }
+
+    void NameTable_Benchmark(usize_t count)
+    {
+        Array<String> names(1024);
+        for (usize_t i = 0; i < names.size(); i++)
+        {
+            names[i] = std::format("render_group_{}", i);
+        }
+
+        uint64_t sum{0};
+        const auto optimized_begins = Clock::now();
+        for (usize_t i = 0; i < count; i++)
+        {
+            sum += uint64_t(TestOptimizedName{names[i % names.size()]}.Hash());
+        }
+        const auto optimized_ends = Clock::now();
+
+        const auto interned_begins = Clock::now();
+        for (usize_t i = 0; i < count; i++)
+        {
+            sum += uint64_t(TestName{names[i % names.size()]}.Hash());
+        }
+        const auto interned_ends = Clock::now();
+
+        const auto find_begins = Clock::now();
+        for (usize_t i = 0; i < count; i++)
+        {
+            sum += TestName{HashValue{sum}}.GetName().size();
+        }
+        const auto find_ends = Clock::now();
+
+        TEST(sum != 0, "Wrong sum");
+        LOG_INFO("Named handle avg time:\toptimized {}, interned {}, find {}", (optimized_ends - optimized_begins).count() / int64_t(count),
+                 (interned_ends - interned_begins).count() / int64_t(count), (find_ends - find_begins).count() / int64_t(count));
+    }
+}
+
+extern void UnitTest_NameTable()
+{
+    constexpr auto COUNT = 100'000;
+
+    NameTable_Test(COUNT);
+    NameTable_Benchmark(COUNT * 10);
+
+    TEST_PASSED();
+}
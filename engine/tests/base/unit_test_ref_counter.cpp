@@ -0,0 +1,93 @@
+#include "unit_tests_common.h"
+
+namespace
+{
+    using namespace Be;
+
+    class HeapObject final : public RefCounter
+    {
+    public:
+        uint64_t payload[8]{};
+    };
+
+    class PooledObject final : public RefCounter
+    {
+        POOLED_ALLOCATION(PooledObject);
+
+    public:
+        uint64_t payload[8]{};
+    };
+
+    class LocalPooledObject final : public LocalRefCounter
+    {
+        POOLED_ALLOCATION(LocalPooledObject);
+
+    public:
+        uint64_t payload[8]{};
+    };
+
+    template <typename T>
+    void RefCounter_Benchmark(const char *name, usize_t count)
+    {
+        Array<RefCountPtr<T>> objects(count);
+
+        const auto begins = Clock::now();
+        for (auto &obj : objects)
+        {
+            obj = MakeRefCounter<T>();
+        }
+        for (auto &obj : objects)
+        {
+            auto copy = obj;
+            copy->payload[0]++;
+        }
+        objects.clear();
+        const auto ends = Clock::now();
+
+        const auto duration = ends - begins;
+
+        LOG_INFO("{} avg time:\t{}", name, duration.count() / count);
+    }
+
+    void PooledRefCounter_Test(usize_t count)
+    {
+        auto &pool = ObjectPool<PooledObject>::Get();
+        const auto live_count = pool.GetLiveCount();
+
+        {
+            auto a = MakeRefCounter<PooledObject>();
+            auto b = MakeRefCounter<PooledObject>();
+            TEST(pool.GetLiveCount() == live_count + 2, "Objects are not allocated from the pool");
+            TEST(a.Get() != b.Get(), "Pool returned the same slot twice");
+
+            auto a_ptr = a.Get();
+            a = nullptr;
+            TEST(pool.GetLiveCount() == live_count + 1, "Object is not returned to the pool");
+
+            auto c = MakeRefCounter<PooledObject>();
+            TEST(c.Get() == a_ptr, "Freed slot must be reused first");
+        }
+        TEST(pool.GetLiveCount() == live_count, "Pool leaks objects");
+
+        {
+            auto local = MakeRefCounter<LocalPooledObject>();
+            auto copy = local;
+            TEST(copy->AddRef() == 3, "Wrong local reference count");
+            TEST(copy->Release() == 2, "Wrong local reference count");
+        }
+        TEST(ObjectPool<LocalPooledObject>::Get().GetLiveCount() == 0, "Local object is not released");
+
+        RefCounter_Benchmark<HeapObject>("Heap ref counter", count);
+        RefCounter_Benchmark<PooledObject>("Pooled ref counter", count);
+        RefCounter_Benchmark<LocalPooledObject>("Pooled local ref counter", count);
+    }
+}
+
+extern void UnitTest_RefCounter()
+{
+    constexpr auto COUNT = 100'000;
+
+    PooledRefCounter_Test(COUNT);
+
+    TEST_PASSED();
+}
@@ -0,0 +1,452 @@
+#include "frameworks/ecs/ecs.h"
+
+#include "../shared/unit_test_shared.h"
+
+using namespace Be;
+using namespace Be::Framework::Threading;
+using namespace Be::Framework::ECS;
+
+struct Position
+{
+    float x, y, z;
+};
+
+struct Velocity
+{
+    float x, y, z;
+};
+
+struct Health
+{
+    int32_t value;
+};
+
+struct Tag
+{
+};
+
+struct alignas(BE_CACHE_LINE) Large
+{
+    byte_t data[1024];
+};
+
+void UnitTest_World()
+{
+    World world;
+
+    const auto a = world.Create(Position{1.0f, 2.0f, 3.0f});
+    const auto b = world.Create(Position{4.0f, 5.0f, 6.0f}, Velocity{1.0f, 0.0f, 0.0f});
+    const auto c = world.Create();
+    TEST(world.size() == 3, "Wrong entity count");
+    TEST(world.Has<Position>(a) && !world.Has<Velocity>(a), "Wrong components of a");
+    TEST(world.Get<Velocity>(b)->x == 1.0f && world.Get<Position>(b)->z == 6.0f, "Wrong components of b");
+    TEST(world.Get<Position>(c) == nullptr, "Entity without components has a position");
+
+    // Components survive moves between archetypes.
+    world.Add(a, Velocity{7.0f, 8.0f, 9.0f});
+    world.Add<Tag>(a);
+    TEST(world.Get<Position>(a)->y == 2.0f && world.Get<Velocity>(a)->z == 9.0f && world.Has<Tag>(a), "Components lost by add");
+    world.Remove<Position>(a);
+    TEST(!world.Has<Position>(a) && world.Get<Velocity>(a)->x == 7.0f, "Components lost by remove");
+    world.Add(a, Velocity{0.0f, 0.0f, 1.0f});
+    TEST(world.Get<Velocity>(a)->z == 1.0f, "Add didn't replace the value");
+
+    // Adding back a removed component goes back to the archetype the entity came from.
+    const auto archetypes = world.GetArchetypeCount();
+    world.Add(a, Position{});
+    world.Remove<Position>(a);
+    TEST(world.GetArchetypeCount() == archetypes, "Archetype created for a known set of components");
+
+    world.Destroy(b);
+    TEST(!world.IsAlive(b) && world.Get<Position>(b) == nullptr && world.size() == 2, "Destroyed entity is alive");
+    const auto d = world.Create(Health{10});
+    TEST(d.index == b.index && d.generation != b.generation && !world.IsAlive(b), "Stale handle matches the new entity");
+    world.Destroy(b);
+    TEST(world.IsAlive(d), "Stale handle destroyed the new entity");
+
+    // Many entities in one archetype, the last row fills the removed ones.
+    constexpr uint32_t COUNT = 100'000;
+    Array<Entity> entities;
+    for (uint32_t i = 0; i < COUNT; i++)
+    {
+        entities.push_back(world.Create(Position{float(i), 0.0f, 0.0f}, Health{int32_t(i)}));
+    }
+    for (uint32_t i = 0; i < COUNT; i += 3)
+    {
+        world.Destroy(entities[i]);
+    }
+    bool same{true};
+    for (uint32_t i = 0; i < COUNT; i++)
+    {
+        if (i % 3 == 0)
+        {
+            same &= !world.IsAlive(entities[i]);
+            continue;
+        }
+        same &= world.Get<Position>(entities[i])->x == float(i) && world.Get<Health>(entities[i])->value == int32_t(i);
+    }
+    TEST(same, "Component values don't follow their entities");
+
+    usize_t visited{0}, chunks{0};
+    world.ForEachChunk<const Position, const Health>([&](usize_t count, const Entity *chunk_entities, const Position *positions, const Health *healths)
+                                                     {
+                                                         chunks++;
+                                                         for (usize_t i = 0; i < count; i++)
+                                                         {
+                                                             same &= positions[i].x == float(healths[i].value) && world.Get<Health>(chunk_entities[i]) == &healths[i];
+                                                         }
+                                                         visited += count; });
+    TEST(same && visited == COUNT - (COUNT + 2) / 3, "Wrong query result");
+
+    // Rows of an entity and its components fit into chunks of CHUNK_SIZE bytes.
+    constexpr auto row_size = sizeof(Entity) + sizeof(Position) + sizeof(Health);
+    TEST(chunks >= visited * row_size / CHUNK_SIZE, "Chunks are larger than CHUNK_SIZE");
+
+    const auto large = world.Create(Large{}, Position{1.0f, 1.0f, 1.0f});
+    TEST(reinterpret_cast<uintptr_t>(world.Get<Large>(large)) % BE_CACHE_LINE == 0, "Column is not aligned");
+
+    TEST_PASSED();
+}
+
+void UnitTest_CommandBuffer()
+{
+    World world;
+    const auto a = world.Create(Position{}, Health{5});
+    const auto b = world.Create(Position{});
+
+    CommandBuffer commands;
+    commands.Create(Position{1.0f, 2.0f, 3.0f}, Velocity{4.0f, 5.0f, 6.0f});
+    commands.Add(a, Velocity{1.0f, 1.0f, 1.0f});
+    commands.Remove<Health>(a);
+    commands.Destroy(b);
+    commands.Add(b, Health{1});
+    TEST(!commands.empty() && world.size() == 2, "Commands applied while recording");
+
+    commands.Playback(world);
+    TEST(commands.empty(), "Command buffer isn't cleared");
+    TEST(world.size() == 2 && !world.IsAlive(b), "Wrong entities after playback");
+    TEST(world.Get<Velocity>(a)->y == 1.0f && !world.Has<Health>(a), "Wrong components after playback");
+
+    usize_t created{0};
+    world.ForEach<const Position, const Velocity>([&](Entity entity, const Position &position, const Velocity &velocity)
+                                                  {
+                                                      if (entity != a)
+                                                      {
+                                                          created += position.z == 3.0f && velocity.x == 4.0f;
+                                                      } });
+    TEST(created == 1, "Created entity has wrong components");
+
+    TEST_PASSED();
+}
+
+void UnitTest_SystemScheduler()
+{
+    struct Gravity
+    {
+    };
+
+    World world;
+    SystemScheduler scheduler{world};
+
+    const auto integrate = scheduler.AddForEach<Position, const Velocity>("Integrate", [](Entity, Position &position, const Velocity &velocity)
+                                                                          {
+                                                                              position.x += velocity.x;
+                                                                              position.y += velocity.y;
+                                                                              position.z += velocity.z; });
+    const auto damage = scheduler.AddForEach<Health>("Damage", [](Entity, Health &health)
+                                                     { health.value--; });
+    const auto gravity = scheduler.Add("Gravity", SystemAccess{}.Read<Gravity>().Write<Velocity>(), [](const SystemContext &context)
+                                       { context.ForEach<Velocity>([](Entity, Velocity &velocity)
+                                                                   { velocity.y -= 1.0f; }); });
+    const auto reap = scheduler.Add("Reap", SystemAccess::Of<const Health>(), [](const SystemContext &context)
+                                    { context.ForEach<const Health>([&context](Entity entity, const Health &health)
+                                                                    {
+                                                                        if (health.value <= 0)
+                                                                        {
+                                                                            context.GetCommandBuffer().Destroy(entity);
+                                                                        } }); });
+
+    TEST(scheduler.GetStage(integrate) == 0 && scheduler.GetStage(damage) == 0, "Independent systems are not in the first stage");
+    TEST(scheduler.GetStage(gravity) == 1 && scheduler.GetStage(reap) == 1, "Conflicting systems are not ordered");
+    TEST(scheduler.GetStageCount() == 2, "Wrong stage count");
+
+    constexpr int32_t COUNT = 50'000;
+    for (int32_t i = 0; i < COUNT; i++)
+    {
+        (void)world.Create(Position{}, Velocity{1.0f, 0.0f, 0.0f}, Health{1 + i % 4});
+    }
+
+    AsyncTaskScheduler::Create();
+    AsyncTaskScheduler::Start();
+
+    for (int32_t frame = 0; frame < 2; frame++)
+    {
+        scheduler.Run();
+    }
+
+    // Two frames: the entities with one or two health points are gone, the velocity is
+    // integrated before gravity in every frame.
+    bool same{true};
+    usize_t alive{0};
+    world.ForEach<const Position, const Velocity, const Health>([&](Entity, const Position &position, const Velocity &velocity, const Health &health)
+                                                                {
+                                                                    alive++;
+                                                                    same &= position.x == 2.0f && position.y == -1.0f && velocity.y == -2.0f && health.value > 0; });
+    TEST(same && alive == COUNT / 2, "Wrong result of the systems");
+
+    AsyncTaskScheduler::Stop();
+    AsyncTaskScheduler::Destroy();
+
+    TEST_PASSED();
+}
+
+void UnitTest_SystemScheduler_Playback()
+{
+    // Two systems of one stage record entities: one from the tasks of its query, the
+    // other from its own code. The playback doesn't depend on the threads that ran them.
+    const auto run = []
+    {
+        World world;
+        for (int32_t i = 0; i < 50'000; i++)
+        {
+            (void)world.Create(Position{float(i), 0.0f, 0.0f});
+        }
+
+        SystemScheduler scheduler{world};
+        (void)scheduler.Add("Spawn", SystemAccess::Of<const Position>(), [](const SystemContext &context)
+                            { context.ForEach<const Position>([&context](Entity, const Position &position)
+                                                              { context.GetCommandBuffer().Create(Health{int32_t(position.x)}); }); });
+        (void)scheduler.Add("Mark", SystemAccess::Of<const Position>(), [](const SystemContext &context)
+                            { context.GetCommandBuffer().Create(Health{-1}); });
+        scheduler.Run();
+
+        Array<int32_t> values;
+        world.ForEach<const Health>([&values](Entity, const Health &health)
+                                    { values.push_back(health.value); });
+        return values;
+    };
+
+    const auto serial = run();
+    TEST(serial.size() == 50'001 && serial.back() == -1, "Wrong entities recorded by the systems");
+
+    AsyncTaskScheduler::Create();
+    AsyncTaskScheduler::Start();
+
+    const auto parallel = run();
+
+    AsyncTaskScheduler::Stop();
+    AsyncTaskScheduler::Destroy();
+
+    TEST(parallel == serial, "Playback order depends on the threads");
+
+    TEST_PASSED();
+}
+
+void UnitTest_SystemScheduler_MixedPlayback()
+{
+    // A system records entities from its own code before and after a query that records
+    // some too. Its own commands come first, with one chunk as well as with many, and
+    // with the task scheduler running or not.
+    const auto run = [](int32_t count)
+    {
+        World world;
+        for (int32_t i = 0; i < count; i++)
+        {
+            (void)world.Create(Position{float(i), 0.0f, 0.0f});
+        }
+
+        SystemScheduler scheduler{world};
+        (void)scheduler.Add("Mixed", SystemAccess::Of<const Position>(), [](const SystemContext &context)
+                            {
+                                context.GetCommandBuffer().Create(Health{-1});
+                                context.ForEach<const Position>([&context](Entity, const Position &position)
+                                                                { context.GetCommandBuffer().Create(Health{int32_t(position.x)}); });
+                                context.GetCommandBuffer().Create(Health{-2}); });
+        scheduler.Run();
+
+        Array<int32_t> values;
+        world.ForEach<const Health>([&values](Entity, const Health &health)
+                                    { values.push_back(health.value); });
+        return values;
+    };
+
+    const auto expected = [](int32_t count)
+    {
+        Array<int32_t> values{-1, -2};
+        for (int32_t i = 0; i < count; i++)
+        {
+            values.push_back(i);
+        }
+        return values;
+    };
+
+    constexpr int32_t SMALL = 10;
+    constexpr int32_t LARGE = 50'000;
+
+    TEST(run(SMALL) == expected(SMALL), "Wrong serial playback order of a single block");
+    TEST(run(LARGE) == expected(LARGE), "Wrong serial playback order of many blocks");
+
+    AsyncTaskScheduler::Create();
+    AsyncTaskScheduler::Start();
+
+    const auto small = run(SMALL);
+    const auto large = run(LARGE);
+
+    AsyncTaskScheduler::Stop();
+    AsyncTaskScheduler::Destroy();
+
+    TEST(small == expected(SMALL), "Wrong parallel playback order of a single block");
+    TEST(large == expected(LARGE), "Wrong parallel playback order of many blocks");
+
+    TEST_PASSED();
+}
+
+void UnitTest_TransformSystems()
+{
+    World world;
+    SystemScheduler scheduler{world};
+    TransformHierarchy hierarchy;
+    AddTransformSystems(scheduler, hierarchy);
+
+    constexpr usize_t COUNT = 10'000;
+    std::mt19937_64 rng{COUNT};
+    Array<Entity> entities;
+    for (usize_t i = 0; i < COUNT; i++)
+    {
+        const auto parent = i < 10 ? TransformHandle{} : world.Get<TransformNode>(entities[rng() % i])->handle;
+        const auto node = hierarchy.Create(parent);
+        hierarchy.SetPosition(node, Float3{float(i % 7), float(i % 5), float(i % 3)});
+        entities.push_back(world.Create(TransformNode{node}, WorldTransform{}));
+    }
+
+    for (usize_t frame = 0; frame < 3; frame++)
+    {
+        for (usize_t i = 0; i < COUNT / 10; i++)
+        {
+            hierarchy.SetPosition(world.Get<TransformNode>(entities[rng() % COUNT])->handle, Float3{float(frame), 1.0f, 2.0f});
+        }
+        scheduler.Run();
+    }
+
+    bool same{true};
+    for (const auto entity : entities)
+    {
+        same &= std::memcmp(&world.Get<WorldTransform>(entity)->matrix, &hierarchy.GetWorld(world.Get<TransformNode>(entity)->handle), sizeof(Float4x4)) == 0;
+    }
+    TEST(same, "World transforms differ from the hierarchy");
+
+    TEST_PASSED();
+}
+
+void UnitTest_LocalTransform()
+{
+    World world;
+    SystemScheduler scheduler{world};
+    TransformHierarchy hierarchy;
+    AddTransformSystems(scheduler, hierarchy);
+
+    const auto root_node = hierarchy.Create();
+    const auto child_node = hierarchy.Create(root_node);
+    const auto root = world.Create(TransformNode{root_node}, LocalTransform{}, WorldTransform{});
+    const auto child = world.Create(TransformNode{child_node}, LocalTransform{}, WorldTransform{});
+
+    world.Get<LocalTransform>(root)->position = Float3{1.0f, 2.0f, 3.0f};
+    world.Get<LocalTransform>(child)->scale = Float3{2.0f, 2.0f, 2.0f};
+    scheduler.Run();
+
+    TEST(hierarchy.GetPosition(root_node) == Float3(1.0f, 2.0f, 3.0f) && hierarchy.GetScale(child_node) == Float3(2.0f, 2.0f, 2.0f), "Local transforms not written into the hierarchy");
+    TEST(std::memcmp(&world.Get<WorldTransform>(child)->matrix, &hierarchy.GetWorld(child_node), sizeof(Float4x4)) == 0, "World transform differs from the hierarchy");
+
+    // Unchanged local transforms leave the nodes alone.
+    scheduler.Run();
+    TEST(!hierarchy.IsWorldChanged(root_node) && !hierarchy.IsWorldChanged(child_node), "Unchanged local transforms recomputed");
+
+    world.Get<LocalTransform>(root)->rotation = Quatf{Float3{0.0f, 1.0f, 0.0f}, 1.0f};
+    scheduler.Run();
+    TEST(hierarchy.IsWorldChanged(child_node), "Parent rotation not applied to the child");
+    TEST(std::memcmp(&world.Get<WorldTransform>(child)->matrix, &hierarchy.GetWorld(child_node), sizeof(Float4x4)) == 0, "World transform differs from the hierarchy");
+
+    TEST_PASSED();
+}
+
+void UnitTest_ForEach_Benchmark()
+{
+    constexpr usize_t COUNT = 1'000'000;
+    constexpr usize_t FRAMES = 10;
+
+    World world;
+    for (usize_t i = 0; i < COUNT; i++)
+    {
+        // Four archetypes with the same queried components.
+        const auto entity = world.Create(Position{float(i), 0.0f, 0.0f}, Velocity{1.0f, 2.0f, 3.0f});
+        if (i % 4 == 1)
+        {
+            world.Add<Health>(entity);
+        }
+        else if (i % 4 == 2)
+        {
+            world.Add<Tag>(entity);
+        }
+        else if (i % 4 == 3)
+        {
+            world.Add<Health>(entity);
+            world.Add<Tag>(entity);
+        }
+    }
+
+    const auto integrate = [](usize_t count, const Entity *, Position *positions, const Velocity *velocities)
+    {
+        for (usize_t i = 0; i < count; i++)
+        {
+            positions[i].x += velocities[i].x;
+            positions[i].y += velocities[i].y;
+            positions[i].z += velocities[i].z;
+        }
+    };
+
+    Clock::duration serial_time{}, parallel_time{};
+    for (usize_t frame = 0; frame < FRAMES; frame++)
+    {
+        const auto begins = Clock::now();
+        world.ForEachChunk<Position, const Velocity>(integrate);
+        serial_time += Clock::now() - begins;
+    }
+
+    AsyncTaskScheduler::Create();
+    AsyncTaskScheduler::Start();
+
+    for (usize_t frame = 0; frame < FRAMES; frame++)
+    {
+        const auto begins = Clock::now();
+        world.ForEachChunkParallel<Position, const Velocity>(ThreadUtils::MaxThreadCount(), [](usize_t task_count, const auto &func)
+                                                             { ParallelInvoke(task_count, func); },
+                                                             integrate);
+        parallel_time += Clock::now() - begins;
+    }
+
+    AsyncTaskScheduler::Stop();
+    AsyncTaskScheduler::Destroy();
+
+    bool same{true};
+    world.ForEach<const Position>([&same](Entity, const Position &position)
+                                  { same &= position.y == float(2 * 2 * FRAMES); });
+    TEST(same, "Wrong integration result");
+
+    LOG_INFO("ECS {} entities ForEachChunk avg time:\tserial {}, parallel {}", COUNT,
+             serial_time.count() / int64_t(FRAMES), parallel_time.count() / int64_t(FRAMES));
+
+    TEST_PASSED();
+}
+
+int main()
+{
+    UnitTest_World();
+    UnitTest_CommandBuffer();
+    UnitTest_SystemScheduler();
+    UnitTest_SystemScheduler_Playback();
+    UnitTest_SystemScheduler_MixedPlayback();
+    UnitTest_TransformSystems();
+    UnitTest_LocalTransform();
+    UnitTest_ForEach_Benchmark();
+    return 0;
+}
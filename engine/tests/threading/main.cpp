@@ -44,8 +44,369 @@ void UnitTest_AsyncTaskScheduler()
     TEST_PASSED();
 }
 
+void UnitTest_ThreadFrameAllocators()
+{
+    const uint32_t thread_count = std::min(4u, ThreadUtils::MaxThreadCount());
+
+    AsyncTaskScheduler::Create(AsyncTaskSchedulerDesc{
+        .thread_count = thread_count,
+        .thread_frame_memory_size = 64 << 10,
+    });
+    AsyncTaskScheduler::Start();
+
+    LOG_INFO("NUMA nodes: {}, current node: {}", Platform::GetNumaNodeCount(), Platform::GetCurrentNumaNode());
+
+    TEST(AsyncTaskScheduler::GetThreadFrameAllocator() != nullptr, "Main thread has no frame allocator");
+
+    for (uint64_t frame = 1; frame <= 4; frame++)
+    {
+        AsyncTaskScheduler::BeginFrame(frame, frame - 1);
+
+        Atomic<uint32_t> allocated{0};
+        auto parent = AsyncTaskScheduler::CreateTask();
+        for (uint32_t i = 0; i < 16; i++)
+        {
+            auto task = AsyncTaskScheduler::CreateTask([&allocated]
+                                                       {
+                                                           auto allocator = AsyncTaskScheduler::GetThreadFrameAllocator();
+                                                           if (allocator != nullptr && allocator->Alloc(1024, 16) != nullptr)
+                                                           {
+                                                               allocated++;
+                                                           } },
+                                                       parent);
+            AsyncTaskScheduler::Schedule(task);
+        }
+        AsyncTaskScheduler::Schedule(parent);
+        AsyncTaskScheduler::Wait(parent);
+
+        TEST(allocated == 16, "Task has no thread frame allocator");
+    }
+
+    AsyncTaskScheduler::Stop();
+    AsyncTaskScheduler::Destroy();
+
+    TEST_PASSED();
+}
+
+void UnitTest_RadixSortParallel()
+{
+    constexpr usize_t TASKS = 8;
+
+    AsyncTaskScheduler::Create();
+    AsyncTaskScheduler::Start();
+
+    // The task pool is a ring, slots of finished tasks are reused once it wraps.
+    Atomic<usize_t> executed{0};
+    for (uint32_t i = 0; i < 1000; i++)
+    {
+        ParallelInvoke(TASKS, [&executed](usize_t)
+                       { executed++; });
+    }
+    TEST(executed == 1000 * TASKS, "Wrong number of executed tasks");
+
+    const auto run = [](usize_t task_count, const auto &func)
+    {
+        ParallelInvoke(task_count, func);
+    };
+
+    for (const usize_t count : {10'000, 100'000, 1'000'000})
+    {
+        Array<uint64_t> keys(count);
+        std::mt19937_64 rng{count};
+        for (auto &key : keys)
+        {
+            key = rng();
+        }
+
+        Array<uint64_t> serial_keys = keys, parallel_keys = keys, temp_keys(count);
+        Array<uint32_t> serial_values(count), parallel_values(count), temp_values(count);
+        std::iota(serial_values.begin(), serial_values.end(), 0u);
+        std::iota(parallel_values.begin(), parallel_values.end(), 0u);
+
+        const auto serial_begins = Clock::now();
+        RadixSort(serial_keys, serial_values, temp_keys, temp_values);
+        const auto serial_ends = Clock::now();
+
+        const auto parallel_begins = Clock::now();
+        RadixSortParallel(parallel_keys, parallel_values, temp_keys, temp_values, TASKS, run);
+        const auto parallel_ends = Clock::now();
+
+        TEST(serial_keys == parallel_keys && serial_values == parallel_values, "Parallel sort differs from serial");
+        LOG_INFO("Radix sort {} keys avg time:\tserial {}, parallel {}", count,
+                 (serial_ends - serial_begins).count() / int64_t(count), (parallel_ends - parallel_begins).count() / int64_t(count));
+    }
+
+    AsyncTaskScheduler::Stop();
+    AsyncTaskScheduler::Destroy();
+
+    TEST_PASSED();
+}
+
+void UnitTest_FrustumCullParallel()
+{
+    constexpr usize_t TASKS = 8;
+
+    AsyncTaskScheduler::Create();
+    AsyncTaskScheduler::Start();
+
+    const auto run = [](usize_t task_count, const auto &func)
+    {
+        ParallelInvoke(task_count, func);
+    };
+
+    const auto frustum = Frustum::FromMatrix(Math::Perspective(Math::Radians(90.0), 1.0, 0.1, 100.0), false);
+
+    for (const usize_t count : {100'000, 1'000'000})
+    {
+        std::mt19937_64 rng{count};
+        std::uniform_real_distribution<double> position{-100.0, 100.0};
+
+        CullingBounds bounds;
+        for (usize_t i = 0; i < count; i++)
+        {
+            const Vector3 center{position(rng), position(rng), position(rng)};
+            PushCullingBounds(bounds, BBox{center - Vector3{1.0}, center + Vector3{1.0}});
+        }
+
+        Array<uint32_t> serial_visible(count), parallel_visible(count);
+
+        const auto serial_begins = Clock::now();
+        const auto serial_count = FrustumCull(frustum, bounds, 0, count, serial_visible.data());
+        const auto serial_ends = Clock::now();
+
+        const auto parallel_begins = Clock::now();
+        const auto parallel_count = FrustumCullParallel(frustum, bounds, parallel_visible, TASKS, run);
+        const auto parallel_ends = Clock::now();
+
+        TEST(serial_count == parallel_count && std::equal(serial_visible.begin(), serial_visible.begin() + serial_count, parallel_visible.begin()),
+             "Parallel culling differs from serial");
+        LOG_INFO("Frustum cull {} boxes avg time:\tserial {}, parallel {}", count,
+                 (serial_ends - serial_begins).count() / int64_t(count), (parallel_ends - parallel_begins).count() / int64_t(count));
+    }
+
+    AsyncTaskScheduler::Stop();
+    AsyncTaskScheduler::Destroy();
+
+    TEST_PASSED();
+}
+
+void UnitTest_BvhBuildParallel()
+{
+    constexpr usize_t TASKS = 8;
+
+    AsyncTaskScheduler::Create();
+    AsyncTaskScheduler::Start();
+
+    const auto run = [](usize_t task_count, const auto &func)
+    {
+        ParallelInvoke(task_count, func);
+    };
+
+    const auto frustum = Frustum::FromMatrix(Math::Perspective(Math::Radians(90.0), 1.0, 0.1, 100.0), false);
+
+    for (const usize_t count : {100'000, 1'000'000})
+    {
+        std::mt19937_64 rng{count};
+        std::uniform_real_distribution<double> position{-100.0, 100.0};
+
+        Array<BBox> boxes(count);
+        for (auto &box : boxes)
+        {
+            const Vector3 center{position(rng), position(rng), position(rng)};
+            box = BBox{center - Vector3{1.0}, center + Vector3{1.0}};
+        }
+
+        Bvh serial, parallel;
+
+        const auto serial_begins = Clock::now();
+        serial.Build(boxes);
+        const auto serial_ends = Clock::now();
+
+        const auto parallel_begins = Clock::now();
+        parallel.BuildParallel(boxes, TASKS, run);
+        const auto parallel_ends = Clock::now();
+
+        // Same splits, only the node order differs.
+        Array<uint32_t> serial_visible(count), parallel_visible(count);
+        const auto serial_count = serial.Cull(frustum, serial_visible.data());
+        const auto parallel_count = parallel.Cull(frustum, parallel_visible.data());
+        std::sort(serial_visible.begin(), serial_visible.begin() + serial_count);
+        std::sort(parallel_visible.begin(), parallel_visible.begin() + parallel_count);
+
+        TEST(serial.GetNodes().size() == parallel.GetNodes().size(), "Parallel build differs from serial");
+        TEST(serial_count == parallel_count && std::equal(serial_visible.begin(), serial_visible.begin() + serial_count, parallel_visible.begin()),
+             "Parallel build differs from serial");
+        LOG_INFO("BVH build {} boxes avg time:\tserial {}, parallel {}", count,
+                 (serial_ends - serial_begins).count() / int64_t(count), (parallel_ends - parallel_begins).count() / int64_t(count));
+    }
+
+    AsyncTaskScheduler::Stop();
+    AsyncTaskScheduler::Destroy();
+
+    TEST_PASSED();
+}
+
+void UnitTest_OcclusionBufferParallel()
+{
+    constexpr usize_t TASKS = 8;
+    constexpr usize_t COUNT = 1'000'000;
+
+    AsyncTaskScheduler::Create();
+    AsyncTaskScheduler::Start();
+
+    const auto run = [](usize_t task_count, const auto &func)
+    {
+        ParallelInvoke(task_count, func);
+    };
+
+    const auto view_projection = Math::Perspective(Math::Radians(90.0), 1.0, 0.1, 1000.0);
+
+    // A row of walls in front of the camera, one quad each.
+    Array<Float3> positions;
+    Array<uint32_t> indices;
+    for (int i = -8; i < 8; i++)
+    {
+        const auto first = uint32_t(positions.size());
+        const auto x = float(i * 12);
+        positions.insert(positions.end(), {{x, -10.0f, 30.0f}, {x + 10.0f, -10.0f, 30.0f}, {x + 10.0f, 20.0f, 30.0f}, {x, 20.0f, 30.0f}});
+        indices.insert(indices.end(), {first, first + 1, first + 2, first, first + 2, first + 3});
+    }
+
+    OcclusionBuffer serial{256, 128}, parallel{256, 128};
+    serial.Begin(view_projection);
+    serial.AddOccluder(positions, indices, view_projection);
+    parallel.Begin(view_projection);
+    parallel.AddOccluder(positions, indices, view_projection);
+
+    const auto serial_begins = Clock::now();
+    serial.Rasterize();
+    const auto serial_ends = Clock::now();
+
+    const auto parallel_begins = Clock::now();
+    parallel.RasterizeParallel(run);
+    const auto parallel_ends = Clock::now();
+
+    bool same{true};
+    for (uint32_t y = 0; y < serial.GetHeight(); y++)
+    {
+        for (uint32_t x = 0; x < serial.GetWidth(); x++)
+        {
+            same &= serial.GetDepth(x, y) == parallel.GetDepth(x, y);
+        }
+    }
+    TEST(same, "Parallel rasterization differs from serial");
+    LOG_INFO("Occlusion rasterize time:\tserial {}, parallel {}", (serial_ends - serial_begins).count(), (parallel_ends - parallel_begins).count());
+
+    std::mt19937_64 rng{COUNT};
+    std::uniform_real_distribution<double> position{-200.0, 200.0};
+    std::uniform_real_distribution<double> depth{50.0, 400.0};
+    Array<BBox> bounds(COUNT);
+    for (auto &box : bounds)
+    {
+        const Vector3 center{position(rng), position(rng) * 0.1, depth(rng)};
+        box = BBox{center - Vector3{1.0}, center + Vector3{1.0}};
+    }
+
+    Array<uint32_t> candidates(COUNT), serial_visible(COUNT), parallel_visible(COUNT);
+    std::iota(candidates.begin(), candidates.end(), 0u);
+
+    const auto cull_begins = Clock::now();
+    const auto serial_count = serial.Cull(bounds, candidates, serial_visible.data());
+    const auto cull_ends = Clock::now();
+
+    const auto parallel_cull_begins = Clock::now();
+    const auto parallel_count = serial.CullParallel(bounds, candidates, parallel_visible, TASKS, run);
+    const auto parallel_cull_ends = Clock::now();
+
+    TEST(serial_count == parallel_count && std::equal(serial_visible.begin(), serial_visible.begin() + serial_count, parallel_visible.begin()),
+         "Parallel occlusion culling differs from serial");
+    LOG_INFO("Occlusion cull {} boxes avg time:\tserial {}, parallel {}", COUNT,
+             (cull_ends - cull_begins).count() / int64_t(COUNT), (parallel_cull_ends - parallel_cull_begins).count() / int64_t(COUNT));
+
+    AsyncTaskScheduler::Stop();
+    AsyncTaskScheduler::Destroy();
+
+    TEST_PASSED();
+}
+
+void UnitTest_TransformHierarchyParallel()
+{
+    constexpr usize_t TASKS = 8;
+    constexpr usize_t COUNT = 1'000'000;
+    constexpr usize_t ROOTS = 1000;
+    constexpr usize_t FRAMES = 10;
+
+    AsyncTaskScheduler::Create();
+    AsyncTaskScheduler::Start();
+
+    const auto run = [](usize_t task_count, const auto &func)
+    {
+        ParallelInvoke(task_count, func);
+    };
+
+    std::mt19937_64 rng{COUNT};
+    std::uniform_real_distribution<float> position{-10.0f, 10.0f};
+
+    // Same random forest twice.
+    TransformHierarchy serial, parallel;
+    Array<TransformHandle> serial_nodes, parallel_nodes;
+    for (usize_t i = 0; i < COUNT; i++)
+    {
+        const auto parent = i < ROOTS ? UMax : uint32_t(rng() % i);
+        serial_nodes.push_back(serial.Create(parent == UMax ? TransformHandle{} : serial_nodes[parent]));
+        parallel_nodes.push_back(parallel.Create(parent == UMax ? TransformHandle{} : parallel_nodes[parent]));
+
+        const Float3 local{position(rng), position(rng), position(rng)};
+        serial.SetPosition(serial_nodes.back(), local);
+        parallel.SetPosition(parallel_nodes.back(), local);
+    }
+    serial.Update();
+    parallel.UpdateParallel(TASKS, run);
+
+    // 5% of the nodes move every frame.
+    Clock::duration serial_time{}, parallel_time{};
+    for (usize_t frame = 0; frame < FRAMES; frame++)
+    {
+        for (usize_t i = 0; i < COUNT / 20; i++)
+        {
+            const auto node = rng() % COUNT;
+            const Float3 local{position(rng), position(rng), position(rng)};
+            serial.SetPosition(serial_nodes[node], local);
+            parallel.SetPosition(parallel_nodes[node], local);
+        }
+
+        const auto serial_begins = Clock::now();
+        serial.Update();
+        serial_time += Clock::now() - serial_begins;
+
+        const auto parallel_begins = Clock::now();
+        parallel.UpdateParallel(TASKS, run);
+        parallel_time += Clock::now() - parallel_begins;
+    }
+
+    bool same{true};
+    for (usize_t i = 0; i < COUNT; i++)
+    {
+        same &= std::memcmp(&serial.GetWorld(serial_nodes[i]), &parallel.GetWorld(parallel_nodes[i]), sizeof(Float4x4)) == 0;
+    }
+    TEST(same, "Parallel transform update differs from serial");
+    LOG_INFO("Transform hierarchy {} nodes 5% dirty update time:\tserial {}, parallel {}", COUNT,
+             serial_time.count() / int64_t(FRAMES), parallel_time.count() / int64_t(FRAMES));
+
+    AsyncTaskScheduler::Stop();
+    AsyncTaskScheduler::Destroy();
+
+    TEST_PASSED();
+}
+
 int main()
 {
     UnitTest_AsyncTaskScheduler();
+    UnitTest_ThreadFrameAllocators();
+    UnitTest_RadixSortParallel();
+    UnitTest_FrustumCullParallel();
+    UnitTest_BvhBuildParallel();
+    UnitTest_OcclusionBufferParallel();
+    UnitTest_TransformHierarchyParallel();
     return 0;
 }
\ No newline at end of file
@@ -46,6 +46,7 @@ struct InputMeshData
 {
     uint32_t material_index{0};
     float scale_factor{1.0f};
+    bool opaque{true};
 
     Array<Float3> positions;
     Array<Float3> normals;
@@ -58,6 +59,9 @@ struct InputMeshData
     Array<uint32_t> meshlet_vertices;
     Array<ShaderInterop::MeshletTriangle> meshlet_triangles;
     Array<ShaderInterop::MeshletBounds> meshlet_bounds;
+
+    Array<Float3> occluder_positions;
+    Array<uint32_t> occluder_indices;
 };
 
 struct OutputModel
@@ -72,6 +76,10 @@ struct OutputModel
 };
 
 static constexpr uint64_t BUFFER_ALIGNMENT{16};
+
+// Occluders are simplified towards this many triangles, the error bound is relative to the mesh size.
+static constexpr uint32_t OCCLUDER_TARGET_TRIANGLES{256};
+static constexpr float OCCLUDER_TARGET_ERROR{0.01f};
 static const Set<String> SUPPORTED_TEXTURES = {"png", "jpg", "jpeg", "tga", "ktx", "ktx2"};
 
 // Model info
@@ -472,6 +480,7 @@ static void ProcessMeshes() noexcept
             auto &mesh_data = MESHES.emplace_back();
 
             mesh_data.material_index = GetMaterialIndex(primitive.material);
+            mesh_data.opaque = !primitive.material || primitive.material->alpha_mode == cgltf_alpha_mode_opaque;
             mesh_data.indices.resize(primitive.indices->count);
 
             for (size_t i = 0; i < primitive.indices->count; i += 3)
@@ -610,9 +619,16 @@ static usize_t GenerateMeshlets() noexcept
                 min = Math::Min(min, p);
             }
 
+            const auto bounds = meshopt_computeMeshletBounds(mesh_data.meshlet_vertices.data() + meshlet.vertex_offset,
+                                                             meshlet_triangles.data() + meshlet.triangle_offset, meshlet.triangle_count,
+                                                             (float *)mesh_data.positions.data(), mesh_data.positions.size(), sizeof(Float3));
+
             auto &out_bounds = mesh_data.meshlet_bounds[i];
             out_bounds.center = (max + min) / 2.0f;
             out_bounds.extents = (max - min) / 2.0f;
+            out_bounds.radius = Math::Length(out_bounds.extents);
+            out_bounds.cone_axis = Float3{bounds.cone_axis[0], bounds.cone_axis[1], bounds.cone_axis[2]};
+            out_bounds.cone_cutoff = bounds.cone_cutoff;
 
             // Encode triangles and get rid of 4 byte padding
             auto source_triangles = meshlet_triangles.data() + meshlet.triangle_offset;
@@ -651,6 +667,34 @@ static usize_t GenerateMeshlets() noexcept
     return buffer_size;
 }
 
+// Low poly copies of the opaque submeshes for the CPU occlusion buffer, with their own compact vertices.
+static void GenerateOccluders() noexcept
+{
+    for (auto &mesh_data : MESHES)
+    {
+        if (!mesh_data.opaque || mesh_data.indices.empty())
+        {
+            continue;
+        }
+
+        const auto target_index_count = std::min<usize_t>(mesh_data.indices.size(), OCCLUDER_TARGET_TRIANGLES * 3);
+
+        Array<uint32_t> indices(mesh_data.indices.size());
+        float result_error{0.0f};
+        indices.resize(meshopt_simplify(indices.data(), mesh_data.indices.data(), mesh_data.indices.size(), (float *)mesh_data.positions.data(),
+                                        mesh_data.positions.size(), sizeof(Float3), target_index_count, OCCLUDER_TARGET_ERROR, 0, &result_error));
+        if (indices.empty())
+        {
+            continue;
+        }
+
+        mesh_data.occluder_positions.resize(mesh_data.positions.size());
+        mesh_data.occluder_positions.resize(meshopt_optimizeVertexFetch(mesh_data.occluder_positions.data(), indices.data(), indices.size(),
+                                                                        mesh_data.positions.data(), mesh_data.positions.size(), sizeof(Float3)));
+        mesh_data.occluder_indices = std::move(indices);
+    }
+}
+
 static void GenerateOutputModel(const usize_t buffer_size) noexcept
 {
     // Write textures
@@ -812,6 +856,9 @@ static void WriteMesh() noexcept
     file.open(filename, std::ios::out | std::ios::binary);
     FileOutputStream stream{file};
 
+    // Write format header
+    stream << MESH_FILE_MAGIC << MESH_FILE_VERSION;
+
     // Write meshes count
     uint32_t size = (uint32_t)OUT_MODEL.meshes.size();
     stream << size;
@@ -835,6 +882,30 @@ static void WriteMesh() noexcept
 
     // Write geometry buffer
     stream.Write(OUT_MODEL.geometry_buffer.data(), OUT_MODEL.geometry_buffer.size());
+
+    // Write occluders
+    Array<SubMeshOccluder> occluders;
+    uint32_t vertex_count{0};
+    uint32_t index_count{0};
+    for (const auto &mesh_data : MESHES)
+    {
+        occluders.push_back({vertex_count, (uint32_t)mesh_data.occluder_positions.size(), index_count, (uint32_t)mesh_data.occluder_indices.size()});
+        vertex_count += (uint32_t)mesh_data.occluder_positions.size();
+        index_count += (uint32_t)mesh_data.occluder_indices.size();
+    }
+
+    stream << vertex_count << index_count;
+    LOG_INFO("Occluder vertices count: {}, indices count: {}", vertex_count, index_count);
+
+    stream.Write(occluders.data(), occluders.size() * sizeof(SubMeshOccluder));
+    for (const auto &mesh_data : MESHES)
+    {
+        stream.Write(mesh_data.occluder_positions.data(), mesh_data.occluder_positions.size() * sizeof(Float3));
+    }
+    for (const auto &mesh_data : MESHES)
+    {
+        stream.Write(mesh_data.occluder_indices.data(), mesh_data.occluder_indices.size() * sizeof(uint32_t));
+    }
 }
 
 static void WriteModel() noexcept
@@ -908,6 +979,7 @@ static void Convert() noexcept
     cgltf_free(GLTF);
 
     const auto buf_size = GenerateMeshlets();
+    GenerateOccluders();
     GenerateOutputModel(buf_size);
     WriteMesh();
     WriteModel();